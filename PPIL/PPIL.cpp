@@ -6,6 +6,10 @@
 #include "header/Polygone.h"
 #include "header/Group.h"
 #include "header/VisiteurSauvegardeTexte.h"
+#include "header/VisiteurSauvegardeBinaire.h"
+#include "header/ChargeurBinaire.h"
+#include "header/ChargeurTexteMmap.h"
+#include "header/ChargeursTexte.h"
 
 int main() {
     try {
@@ -50,9 +54,26 @@ int main() {
 
         
         mainGroup->accepte(&saver);
+        saver.valider();
 
         std::cout << "Successfully saved hierarchy to 'sauvegarde.txt'." << std::endl;
 
+        ChargeurTexteMmap loader(new ChargeurCercle(new ChargeurSegment(new ChargeurPolygone())));
+        for (Forme* f : loader.chargerFichier("sauvegarde.txt")) {
+            std::cout << "Reloaded from 'sauvegarde.txt': " << (std::string)*f << std::endl;
+            delete f;
+        }
+
+        VisiteurSauvegardeBinaire saverBin("sauvegarde.bin");
+        mainGroup->accepte(&saverBin);
+        saverBin.valider();
+
+        std::vector<Forme*> reloaded = ChargeurBinaire::chargerFichier("sauvegarde.bin");
+        for (Forme* f : reloaded) {
+            std::cout << "Reloaded from 'sauvegarde.bin': " << (std::string)*f << std::endl;
+            delete f;
+        }
+
         // --- 5. CLEANUP ---
         
         delete mainGroup;
@@ -0,0 +1,113 @@
+/**
+ * @file GenerateurScene.h
+ * @brief Génération procédurale et reproductible de scènes pour les mesures de performance.
+ */
+
+#ifndef GENERATEUR_SCENE_H
+#define GENERATEUR_SCENE_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+#include "../header/Cercle.h"
+#include "../header/Segement.h"
+#include "../header/Polygone.h"
+#include "../header/Group.h"
+
+ /**
+  * @brief Composition d'une scène générée.
+  * @details Les formes simples sont réparties à tour de rôle entre les groupes du dernier
+  * niveau d'un arbre de @c profondeur niveaux, chaque groupe ayant @c ramification sous-groupes.
+  */
+struct ParametresScene {
+    std::size_t nbCercles = 0;
+    std::size_t nbSegments = 0;
+    std::size_t nbPolygones = 0;
+    std::size_t sommetsParPolygone = 6; ///< Polygones réguliers un peu bruités.
+    std::size_t profondeur = 3;         ///< Niveaux de groupes sous la racine (0 : formes à la racine).
+    std::size_t ramification = 8;       ///< Sous-groupes par groupe.
+    double cote = 10000;                ///< Côté du carré dans lequel les formes sont placées.
+    std::uint64_t graine = 42;          ///< Même graine, même scène.
+
+    /** @brief Scène de @p n formes : un tiers de chaque sorte. */
+    static ParametresScene repartie(std::size_t n) {
+        ParametresScene p;
+        p.nbCercles = n - 2 * (n / 3);
+        p.nbSegments = n / 3;
+        p.nbPolygones = n / 3;
+        return p;
+    }
+
+    std::size_t nbFormes() const { return nbCercles + nbSegments + nbPolygones; }
+};
+
+ /**
+  * @class GenerateurScene
+  * @brief Construit une scène selon des ParametresScene.
+  */
+class GenerateurScene {
+private:
+    ParametresScene _p;
+    std::mt19937_64 _alea;
+    std::uniform_real_distribution<double> _position;
+    std::uniform_real_distribution<double> _taille{ 1.0, 20.0 };
+
+    const std::string& couleur() {
+        static const std::string* couleurs[] = { &Forme::BLACK, &Forme::BLUE, &Forme::RED,
+                                                 &Forme::GREEN, &Forme::YELLOW, &Forme::CYAN };
+        return *couleurs[_alea() % 6];
+    }
+
+    Vecteur2D point() { return Vecteur2D(_position(_alea), _position(_alea)); }
+
+    Forme* forme(std::size_t indice) {
+        if (indice < _p.nbCercles) return new Cercle(point(), _taille(_alea), couleur());
+        if (indice < _p.nbCercles + _p.nbSegments) {
+            const Vecteur2D a = point();
+            return new Segment(a, Vecteur2D(a.x + _taille(_alea), a.y + _taille(_alea)), couleur());
+        }
+        const Vecteur2D centre = point();
+        const double rayon = _taille(_alea);
+        const std::size_t n = _p.sommetsParPolygone < 3 ? 3 : _p.sommetsParPolygone;
+        std::vector<Vecteur2D> sommets;
+        sommets.reserve(n);
+        for (std::size_t k = 0; k < n; ++k) {
+            const double angle = 2 * 3.14159265358979323846 * static_cast<double>(k) / static_cast<double>(n);
+            const double r = rayon * (0.8 + 0.4 * (_alea() % 1000) / 1000.0);
+            sommets.emplace_back(centre.x + r * std::cos(angle), centre.y + r * std::sin(angle));
+        }
+        return new Polygone(std::move(sommets), couleur());
+    }
+
+    /** @brief Crée les sous-groupes de @p g sur @p niveaux niveaux et collecte ceux du dernier. */
+    void ramifier(Groupe* g, std::size_t niveaux, std::vector<Groupe*>& feuilles) {
+        if (niveaux == 0) {
+            feuilles.push_back(g);
+            return;
+        }
+        for (std::size_t i = 0; i < _p.ramification; ++i) {
+            Groupe* sous = new Groupe(couleur());
+            g->ajouter(sous);
+            ramifier(sous, niveaux - 1, feuilles);
+        }
+    }
+
+public:
+    explicit GenerateurScene(const ParametresScene& p)
+        : _p(p), _alea(p.graine), _position(0.0, p.cote) {}
+
+    /** @brief Nouvelle scène (propriété de l'appelant). */
+    Groupe* generer() {
+        Groupe* racine = new Groupe(Forme::BLACK);
+        std::vector<Groupe*> feuilles;
+        ramifier(racine, _p.ramification == 0 ? 0 : _p.profondeur, feuilles);
+        const std::size_t n = _p.nbFormes();
+        for (std::size_t i = 0; i < n; ++i) feuilles[i % feuilles.size()]->ajouter(forme(i));
+        return racine;
+    }
+};
+
+#endif
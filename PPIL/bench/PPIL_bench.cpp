@@ -0,0 +1,477 @@
+/**
+ * @file PPIL_bench.cpp
+ * @brief Mesures de performance sur des scènes générées, avec rapport JSON ou CSV.
+ * @details Usage : PPIL_bench [--tailles 1000,100000,1000000] [--repetitions 3]
+ * [--profondeur 3] [--ramification 8] [--sommets 6] [--graine 42]
+ * [--format json|csv] [--sortie fichier] [--trace fichier.json] [--reseau requetes]
+ *
+ * Avec --reseau, le banc mesure aussi le débit du PoolConnexions vers un serveur factice local
+ * (tests/ServeurBouchon.h) : le nombre de requêtes donné, réparti entre 1, 4 puis 16 threads
+ * producteurs, chronométré jusqu'à leur réception complète par le serveur (POSIX seulement).
+ *
+ * Chaque répétition part d'une scène neuve (même graine) : les mesures « à froid » ne
+ * profitent d'aucun cache. La génération et les destructions ne sont pas chronométrées,
+ * sauf l'opération « generation » elle-même.
+ *
+ * Compilé avec PPIL_INSTRUMENTATION, le banc écrit aussi le résumé des compteurs sur la
+ * sortie d'erreur et, avec --trace, la trace Chrome de la dernière taille mesurée.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "GenerateurScene.h"
+#include "../header/VisiteurSauvegardeTexte.h"
+#include "../header/VisiteurSauvegardeBinaire.h"
+#include "../header/ChargeurBinaire.h"
+#include "../header/FormeBatch.h"
+#include "../header/Scene.h"
+#include "../header/ChargeurTexteMmap.h"
+#include "../header/ChargeurTexteParallele.h"
+#include "../header/Instrumentation.h"
+#include "../header/SceneValeur.h"
+#include "../header/PoolConnexions.h"
+#include "../header/NoyauxPolygone.h"
+#ifndef _WIN32
+#include <thread>
+#include "../tests/ServeurBouchon.h"
+#endif
+
+namespace {
+    using Horloge = std::chrono::steady_clock;
+
+    /** @brief Pas de la sauvegarde binaire quantifiée : un centième d'unité. */
+    const double PAS_QUANTIFICATION = 0.01;
+
+    /** @brief Durées mesurées d'une opération pour une taille de scène. */
+    struct Mesure {
+        std::size_t formes;
+        std::string operation;
+        std::vector<double> ms;
+
+        double min() const { return *std::min_element(ms.begin(), ms.end()); }
+        double mediane() const {
+            std::vector<double> tries(ms);
+            std::sort(tries.begin(), tries.end());
+            const std::size_t n = tries.size();
+            return n % 2 ? tries[n / 2] : (tries[n / 2 - 1] + tries[n / 2]) / 2;
+        }
+        double moyenne() const {
+            double s = 0;
+            for (double d : ms) s += d;
+            return s / static_cast<double>(ms.size());
+        }
+    };
+
+    struct Configuration {
+        std::vector<std::size_t> tailles = { 1000, 100000, 1000000 };
+        std::size_t repetitions = 3;
+        ParametresScene modele;
+        std::string format = "json";
+        std::string sortie; ///< Vide : sortie standard.
+        std::string trace;  ///< Fichier de trace Chrome (instrumentation compilée seulement).
+        std::size_t requetesReseau = 0; ///< Requêtes envoyées par mesure de débit réseau (0 : aucune).
+    };
+
+    /** @brief Chronomètre @p f et range la durée dans la mesure @p operation. */
+    template <typename F>
+    void chronometrer(std::vector<Mesure>& mesures, std::size_t formes, const char* operation, F&& f) {
+        auto it = std::find_if(mesures.begin(), mesures.end(), [&](const Mesure& m) {
+            return m.formes == formes && m.operation == operation;
+        });
+        if (it == mesures.end()) {
+            mesures.push_back(Mesure{ formes, operation, {} });
+            it = mesures.end() - 1;
+        }
+        const auto debut = Horloge::now();
+        f();
+        it->ms.push_back(std::chrono::duration<double, std::milli>(Horloge::now() - debut).count());
+    }
+
+    /** @brief Visiteur minimal : somme des coordonnées, pour mesurer le coût du parcours seul. */
+    class VisiteurSomme : public VisiteurForme {
+    public:
+        double total = 0;
+
+        void visite(const Cercle& c) override { total += c.getCentre().x + c.getRayon(); }
+        void visite(const Segment& s) override { total += s.getP1().x + s.getP2().x; }
+        void visite(const Polygone& p) override {
+            for (const Vecteur2D& v : p.getSommets()) total += v.x;
+        }
+        void visite(const Groupe& g) override {
+            for (const Forme* f : g.getFormes()) f->accepte(this);
+        }
+    };
+
+    void collecterFormes(Forme* f, std::vector<Forme*>& formes) {
+        if (Groupe* g = dynamic_cast<Groupe*>(f)) {
+            for (Forme* enfant : g->getFormes()) collecterFormes(enfant, formes);
+        }
+        else {
+            formes.push_back(f);
+        }
+    }
+
+    void liberer(std::vector<Forme*>& formes) {
+        for (Forme* f : formes) delete f;
+        formes.clear();
+    }
+
+#if defined(__SIZEOF_FLOAT128__) && !defined(__clang__)
+    using ReelEtendu = __float128;  ///< Le produit de deux double y est exact (113 bits de mantisse).
+#else
+    using ReelEtendu = long double;
+#endif
+
+    /** @brief Formule du lacet sans recentrage ni compensation : l'algorithme des petits polygones. */
+    double aireNaive(const std::vector<Vecteur2D>& s) {
+        double aire = 0;
+        for (std::size_t i = 0; i + 1 < s.size(); ++i) aire += s[i].x * s[i + 1].y - s[i + 1].x * s[i].y;
+        aire += s.back().x * s[0].y - s[0].x * s.back().y;
+        return aire / 2;
+    }
+
+    double perimetreNaif(const std::vector<Vecteur2D>& s) {
+        double perimetre = 0;
+        for (std::size_t i = 0; i < s.size(); ++i) {
+            const Vecteur2D& b = s[i + 1 < s.size() ? i + 1 : 0];
+            perimetre += std::hypot(b.x - s[i].x, b.y - s[i].y);
+        }
+        return perimetre;
+    }
+
+    /** @brief Aire de référence : produits exacts, cumul en précision étendue. */
+    double aireReference(const std::vector<Vecteur2D>& s) {
+        ReelEtendu aire = 0;
+        for (std::size_t i = 0; i < s.size(); ++i) {
+            const Vecteur2D& b = s[i + 1 < s.size() ? i + 1 : 0];
+            aire += static_cast<ReelEtendu>(s[i].x) * b.y - static_cast<ReelEtendu>(b.x) * s[i].y;
+        }
+        return static_cast<double>(aire / 2);
+    }
+
+    double perimetreReference(const std::vector<Vecteur2D>& s) {
+        long double perimetre = 0;
+        for (std::size_t i = 0; i < s.size(); ++i) {
+            const Vecteur2D& b = s[i + 1 < s.size() ? i + 1 : 0];
+            const long double dx = static_cast<long double>(b.x) - s[i].x, dy = static_cast<long double>(b.y) - s[i].y;
+            perimetre += std::sqrt(dx * dx + dy * dy);
+        }
+        return static_cast<double>(perimetre);
+    }
+
+    /**
+     * @brief Grand polygone de @p n sommets loin de l'origine (coordonnées projetées, en mètres) :
+     * algorithme naïf contre noyaux compensés, en temps et en écart à une référence en précision étendue.
+     */
+    void mesurerGrandPolygone(const Configuration& config, std::size_t n, std::vector<Mesure>& mesures) {
+        std::mt19937_64 alea(config.modele.graine);
+        std::uniform_real_distribution<double> bruit(0.9, 1.1);
+        std::vector<Vecteur2D> sommets;
+        sommets.reserve(n);
+        for (std::size_t k = 0; k < n; ++k) {
+            const double angle = 2 * 3.14159265358979323846 * static_cast<double>(k) / static_cast<double>(n);
+            const double r = 250 * bruit(alea);
+            sommets.emplace_back(652000.125 + r * std::cos(angle), 6862000.375 + r * std::sin(angle));
+        }
+        volatile double puits = 0;
+        double naive = 0, compensee = 0, perimetre = 0, perimetreCompense = 0;
+        chronometrer(mesures, n, "polygone_aire_naive", [&] { puits = naive = aireNaive(sommets); });
+        chronometrer(mesures, n, "polygone_aire_compensee", [&] {
+            puits = compensee = NoyauxPolygone::aireSignee(sommets.data(), n);
+        });
+        chronometrer(mesures, n, "polygone_perimetre_naif", [&] { puits = perimetre = perimetreNaif(sommets); });
+        chronometrer(mesures, n, "polygone_perimetre_compense", [&] {
+            puits = perimetreCompense = NoyauxPolygone::perimetre(sommets.data(), n);
+        });
+        (void)puits;
+
+        const double aire = aireReference(sommets), longueur = perimetreReference(sommets);
+        std::cerr << n << " sommets (" << NoyauxPolygone::jeuInstructions() << ") : écart relatif de l'aire, naïve "
+                  << std::abs(naive - aire) / aire << ", compensée " << std::abs(compensee - aire) / aire
+                  << " ; du périmètre, naïf " << std::abs(perimetre - longueur) / longueur << ", compensé "
+                  << std::abs(perimetreCompense - longueur) / longueur << std::endl;
+    }
+
+    /** @brief Toutes les opérations, une fois, sur une scène neuve de @p n formes. */
+    void mesurerUneFois(const Configuration& config, std::size_t n, std::vector<Mesure>& mesures) {
+        ParametresScene p = config.modele;
+        const ParametresScene repartie = ParametresScene::repartie(n);
+        p.nbCercles = repartie.nbCercles;
+        p.nbSegments = repartie.nbSegments;
+        p.nbPolygones = repartie.nbPolygones;
+
+        const std::filesystem::path dossier = std::filesystem::temp_directory_path();
+        const std::string texte = (dossier / "PPIL_bench.txt").string();
+        const std::string binaire = (dossier / "PPIL_bench.bin").string();
+        const std::string binaireQuantifie = (dossier / "PPIL_bench_quantifie.bin").string();
+        const std::string texteValeur = (dossier / "PPIL_bench_valeur.txt").string();
+        const std::string binaireValeur = (dossier / "PPIL_bench_valeur.bin").string();
+        volatile double puits = 0; // Empêche l'élimination des calculs dont le résultat est ignoré.
+
+        Groupe* scene = nullptr;
+        chronometrer(mesures, n, "generation", [&] { scene = GenerateurScene(p).generer(); });
+        chronometrer(mesures, n, "calculerAire", [&] { puits = scene->calculerAire(); });
+        chronometrer(mesures, n, "calculerAire_memorisee", [&] { puits = scene->calculerAire(); });
+
+        std::vector<Forme*> feuilles;
+        collecterFormes(scene, feuilles);
+        chronometrer(mesures, n, "transformations_formes", [&] {
+            for (Forme* f : feuilles) {
+                f->translation(Vecteur2D(1, 2));
+                f->homothetie(Vecteur2D(0, 0), 1.001);
+                f->rotation(Vecteur2D(0, 0), 0.01);
+            }
+        });
+        chronometrer(mesures, n, "transformations_groupe", [&] {
+            scene->translation(Vecteur2D(1, 2));
+            scene->homothetie(Vecteur2D(0, 0), 1.001);
+            scene->rotation(Vecteur2D(0, 0), 0.01);
+            puits = scene->calculerBoite().xmin; // Propage les transformations différées.
+        });
+
+        // Même scène en tableaux séparés : transformations par noyaux SIMD, visite par formes temporaires.
+        VisiteurSomme somme;
+        chronometrer(mesures, n, "visite_arbre", [&] { scene->accepte(&somme); });
+        FormeBatch lot;
+        chronometrer(mesures, n, "batch_conversion", [&] { lot.ajouter(*scene); });
+        chronometrer(mesures, n, "batch_transformations", [&] {
+            lot.translation(Vecteur2D(1, 2));
+            lot.homothetie(Vecteur2D(0, 0), 1.001);
+            lot.rotation(Vecteur2D(0, 0), 0.01);
+        });
+        chronometrer(mesures, n, "batch_visite", [&] { lot.accepte(&somme); });
+        puits = somme.total;
+        lot.vider();
+
+        // Allocation seule : les mêmes cercles un par un sur le tas, puis à la suite dans une arène.
+        {
+            Groupe* tas = nullptr;
+            chronometrer(mesures, n, "allocation_tas", [&] {
+                tas = new Groupe(Forme::BLACK);
+                for (std::size_t i = 0; i < n; ++i) tas->ajouter(new Cercle(Vecteur2D(i, i), 1, Forme::BLUE));
+            });
+            chronometrer(mesures, n, "destruction_tas", [&] { delete tas; });
+            Scene arene;
+            chronometrer(mesures, n, "allocation_arene", [&] {
+                for (std::size_t i = 0; i < n; ++i) arene.ajouter<Cercle>(Vecteur2D(i, i), 1, Forme::BLUE);
+            });
+            chronometrer(mesures, n, "destruction_arene", [&] { arene.vider(); });
+        }
+
+        chronometrer(mesures, n, "operator_string", [&] { puits = static_cast<double>(static_cast<std::string>(*scene).size()); });
+
+        chronometrer(mesures, n, "sauvegarde_texte", [&] {
+            VisiteurSauvegardeTexte v(texte);
+            scene->accepte(&v);
+            v.valider();
+        });
+        chronometrer(mesures, n, "sauvegarde_binaire", [&] {
+            VisiteurSauvegardeBinaire v(binaire);
+            scene->accepte(&v);
+            v.valider();
+        });
+        chronometrer(mesures, n, "sauvegarde_binaire_quantifiee", [&] {
+            VisiteurSauvegardeBinaire v(binaireQuantifie, TamponFichier::SEUIL_DEFAUT, PAS_QUANTIFICATION);
+            scene->accepte(&v);
+            v.valider();
+        });
+        std::cerr << n << " formes : texte " << std::filesystem::file_size(texte) << " o, binaire "
+                  << std::filesystem::file_size(binaire) << " o, binaire quantifié "
+                  << std::filesystem::file_size(binaireQuantifie) << " o" << std::endl;
+
+        // Mêmes traitements sur la représentation par valeur (std::visit au lieu des appels virtuels).
+        FormeValeur valeur;
+        chronometrer(mesures, n, "valeur_conversion", [&] { valeur = SceneValeur::versValeur(*scene); });
+        delete scene;
+        chronometrer(mesures, n, "valeur_calculerAire", [&] { puits = SceneValeur::aire(valeur); });
+        chronometrer(mesures, n, "valeur_transformations", [&] {
+            Transformation2D m = Transformation2D::translation(Vecteur2D(1, 2));
+            m.puis(Transformation2D::homothetie(Vecteur2D(0, 0), 1.001));
+            m.puis(Transformation2D::rotation(Vecteur2D(0, 0), 0.01));
+            SceneValeur::transformer(valeur, m);
+            puits = SceneValeur::boite(valeur).xmin;
+        });
+        chronometrer(mesures, n, "valeur_sauvegarde_texte", [&] { SceneValeur::sauvegarderTexte(valeur, texteValeur); });
+        chronometrer(mesures, n, "valeur_sauvegarde_binaire", [&] { SceneValeur::sauvegarderBinaire(valeur, binaireValeur); });
+        Forme* reconstruite = nullptr;
+        chronometrer(mesures, n, "valeur_vers_forme", [&] { reconstruite = SceneValeur::versForme(valeur); });
+        delete reconstruite;
+        valeur = FormeValeur();
+
+        std::vector<Forme*> chargees;
+        chronometrer(mesures, n, "chargement_texte", [&] { chargees = ChargeurTexteMmap().chargerFichier(texte); });
+        liberer(chargees);
+        chronometrer(mesures, n, "chargement_texte_parallele", [&] { chargees = ChargeurTexteParallele().chargerFichier(texte); });
+        liberer(chargees);
+        chronometrer(mesures, n, "chargement_binaire", [&] { chargees = ChargeurBinaire::chargerFichier(binaire); });
+        liberer(chargees);
+        chronometrer(mesures, n, "chargement_binaire_quantifie", [&] { chargees = ChargeurBinaire::chargerFichier(binaireQuantifie); });
+        liberer(chargees);
+
+        mesurerGrandPolygone(config, n, mesures);
+
+        std::error_code ignore;
+        std::filesystem::remove(texte, ignore);
+        std::filesystem::remove(binaire, ignore);
+        std::filesystem::remove(binaireQuantifie, ignore);
+        std::filesystem::remove(texteValeur, ignore);
+        std::filesystem::remove(binaireValeur, ignore);
+    }
+
+    /**
+     * @brief Débit du pool de connexions : @p n requêtes réparties entre 1, 4 et 16 producteurs.
+     * @details Chronométré de la première requête à la réception de la dernière par le serveur.
+     */
+    void mesurerReseau(std::size_t n, std::vector<Mesure>& mesures) {
+#ifndef _WIN32
+        for (std::size_t nbProducteurs : { 1, 4, 16 }) {
+            ServeurBouchon serveur(false);
+            PoolConnexions pool("127.0.0.1", serveur.port());
+            const std::string operation = "reseau_" + std::to_string(nbProducteurs) + "_producteurs";
+            chronometrer(mesures, n, operation.c_str(), [&] {
+                std::vector<std::thread> producteurs;
+                for (std::size_t t = 0; t < nbProducteurs; ++t) {
+                    producteurs.emplace_back([&, t] {
+                        std::string requete;
+                        for (std::size_t i = t; i < n; i += nbProducteurs) {
+                            requete = "Cercle;red;" + std::to_string(i) + ",42.5;7";
+                            pool.envoyer(requete);
+                        }
+                        pool.vider();
+                    });
+                }
+                for (std::thread& p : producteurs) p.join();
+                if (!serveur.attendre(n, std::chrono::seconds(60))) throw std::runtime_error("Requêtes perdues par le pool");
+            });
+        }
+#else
+        (void)n;
+        (void)mesures;
+        std::cerr << "PPIL_bench : --reseau n'est disponible qu'avec les sockets POSIX" << std::endl;
+#endif
+    }
+
+    std::string compilateur() {
+#if defined(_MSC_VER)
+        return "MSVC " + std::to_string(_MSC_VER);
+#elif defined(__clang__)
+        return std::string("clang ") + __clang_version__;
+#elif defined(__GNUC__)
+        return std::string("gcc ") + __VERSION__;
+#else
+        return "inconnu";
+#endif
+    }
+
+    void rapportJson(std::ostream& o, const Configuration& c, const std::vector<Mesure>& mesures) {
+        char tampon[64];
+        auto reel = [&](double v) {
+            std::snprintf(tampon, sizeof(tampon), "%.6f", v);
+            return std::string(tampon);
+        };
+        o << "{\n  \"version\": 1,\n";
+        o << "  \"compilateur\": \"" << compilateur() << "\",\n";
+#ifdef NDEBUG
+        o << "  \"optimise\": true,\n";
+#else
+        o << "  \"optimise\": false,\n";
+#endif
+        o << "  \"parametres\": { \"repetitions\": " << c.repetitions << ", \"profondeur\": " << c.modele.profondeur
+          << ", \"ramification\": " << c.modele.ramification << ", \"sommets\": " << c.modele.sommetsParPolygone
+          << ", \"graine\": " << c.modele.graine << " },\n";
+        o << "  \"resultats\": [\n";
+        for (std::size_t i = 0; i < mesures.size(); ++i) {
+            const Mesure& m = mesures[i];
+            o << "    { \"formes\": " << m.formes << ", \"operation\": \"" << m.operation << "\", \"min_ms\": "
+              << reel(m.min()) << ", \"mediane_ms\": " << reel(m.mediane()) << ", \"moyenne_ms\": " << reel(m.moyenne())
+              << ", \"formes_par_s\": " << reel(m.min() > 0 ? m.formes / (m.min() / 1000) : 0) << " }"
+              << (i + 1 < mesures.size() ? ",\n" : "\n");
+        }
+        o << "  ]\n}\n";
+    }
+
+    void rapportCsv(std::ostream& o, const std::vector<Mesure>& mesures) {
+        o << "formes,operation,min_ms,mediane_ms,moyenne_ms,formes_par_s\n";
+        char ligne[256];
+        for (const Mesure& m : mesures) {
+            std::snprintf(ligne, sizeof(ligne), "%zu,%s,%.6f,%.6f,%.6f,%.1f\n", m.formes, m.operation.c_str(),
+                          m.min(), m.mediane(), m.moyenne(), m.min() > 0 ? m.formes / (m.min() / 1000) : 0);
+            o << ligne;
+        }
+    }
+
+    std::vector<std::size_t> lireTailles(const std::string& liste) {
+        std::vector<std::size_t> tailles;
+        std::stringstream flux(liste);
+        std::string element;
+        while (std::getline(flux, element, ',')) tailles.push_back(std::stoull(element));
+        return tailles;
+    }
+
+    Configuration lireArguments(int argc, char** argv) {
+        Configuration c;
+        for (int i = 1; i < argc; ++i) {
+            const std::string option = argv[i];
+            if (i + 1 >= argc) throw std::invalid_argument("Valeur manquante après " + option);
+            const std::string valeur = argv[++i];
+            if (option == "--tailles") c.tailles = lireTailles(valeur);
+            else if (option == "--repetitions") c.repetitions = std::max<std::size_t>(1, std::stoull(valeur));
+            else if (option == "--profondeur") c.modele.profondeur = std::stoull(valeur);
+            else if (option == "--ramification") c.modele.ramification = std::stoull(valeur);
+            else if (option == "--sommets") c.modele.sommetsParPolygone = std::stoull(valeur);
+            else if (option == "--graine") c.modele.graine = std::stoull(valeur);
+            else if (option == "--format") c.format = valeur;
+            else if (option == "--sortie") c.sortie = valeur;
+            else if (option == "--trace") c.trace = valeur;
+            else if (option == "--reseau") c.requetesReseau = std::stoull(valeur);
+            else throw std::invalid_argument("Option inconnue : " + option);
+        }
+        if (c.format != "json" && c.format != "csv") throw std::invalid_argument("Format inconnu : " + c.format);
+        return c;
+    }
+}
+
+int main(int argc, char** argv) {
+    try {
+        const Configuration config = lireArguments(argc, argv);
+        std::vector<Mesure> mesures;
+        for (std::size_t n : config.tailles) {
+            Instrumentation::reinitialiser();
+            for (std::size_t r = 0; r < config.repetitions; ++r) mesurerUneFois(config, n, mesures);
+            std::cerr << n << " formes : " << config.repetitions << " répétition(s) terminée(s)" << std::endl;
+        }
+        if (config.requetesReseau) {
+            for (std::size_t r = 0; r < config.repetitions; ++r) mesurerReseau(config.requetesReseau, mesures);
+        }
+
+        if (Instrumentation::ACTIVE) Instrumentation::ecrireResume(std::cerr);
+        if (!config.trace.empty() && !Instrumentation::ecrireTrace(config.trace)) {
+            std::cerr << "PPIL_bench : trace non écrite (" << config.trace << ")" << std::endl;
+        }
+
+        std::ofstream fichier;
+        if (!config.sortie.empty()) {
+            fichier.open(config.sortie);
+            if (!fichier) throw std::runtime_error("Impossible d'écrire " + config.sortie);
+        }
+        std::ostream& o = config.sortie.empty() ? std::cout : fichier;
+        if (config.format == "json") rapportJson(o, config, mesures);
+        else rapportCsv(o, mesures);
+    }
+    catch (const std::exception& e) {
+        std::cerr << "PPIL_bench : " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,118 @@
+/**
+ * @file AireUnion.h
+ * @brief Aire exacte de la réunion de formes qui se chevauchent.
+ */
+
+#ifndef AIRE_UNION_H
+#define AIRE_UNION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "vecteur2D.h"
+
+class Forme;
+class PoolThreads;
+
+/**
+ * @class AireUnion
+ * @brief Calcule l'aire couverte par un ensemble de formes, chaque point n'étant compté qu'une fois.
+ * * Le plan est découpé en bandes verticales aux abscisses des sommets, des extrémités
+ * des cercles et de toutes les intersections entre contours. Dans une bande, aucun contour
+ * n'en croise un autre : triés selon leur ordonnée au milieu de la bande, ils délimitent
+ * des intervalles couverts dont l'aire s'intègre exactement, en trapèzes pour les côtés de
+ * polygones et par la primitive de sqrt(r² - x²) pour les arcs de cercle (aucune approximation).
+ *
+ * Chaque forme suit la règle de l'enroulement non nul : un polygone croisé ou orienté dans
+ * un sens quelconque, ou une forme dupliquée, est compté correctement. Les segments n'ont
+ * pas d'aire et sont ignorés.
+ *
+ * Coût, pour n contours et k intersections : les paires candidates sont celles dont les
+ * boîtes se chevauchent (parcours des contours triés par x), les O(n + k) bornes sont
+ * triées en O((n + k) log(n + k)), puis chaque bande trie les contours qui la traversent en
+ * repartant de l'ordre de la bande précédente, presque toujours déjà bon.
+ *
+ * Avec une réserve de threads, intersections et bandes sont réparties par paquets de taille
+ * fixe, dont les sommes partielles sont cumulées dans l'ordre : le résultat est identique au
+ * bit près quel que soit le nombre de threads.
+ */
+class AireUnion {
+private:
+    /** @brief Nature d'un contour élémentaire, monotone en x. */
+    enum TypeCourbe : std::uint8_t { DROITE, ARC_BAS, ARC_HAUT };
+
+    /**
+     * @brief Contour élémentaire sur [x0, x1].
+     * @details Droite : y = a + b.(x - x0). Arc : centre (a, b), rayon c, moitié basse ou haute.
+     */
+    struct Courbe {
+        double x0, x1;
+        double a, b, c;
+        std::uint32_t forme;  ///< Numéro de la forme à laquelle appartient le contour.
+        std::int8_t sens;     ///< +1 si le contour va vers les x croissants, -1 sinon.
+        TypeCourbe type;
+    };
+
+    /** @brief Côté de polygone ou cercle entier, pour la recherche des intersections. */
+    struct Primitive {
+        double xmin, ymin, xmax, ymax;
+        Vecteur2D p, q;  ///< Extrémités d'un côté ; pour un cercle, p est le centre et q.x le rayon.
+        bool cercle;
+    };
+
+    std::vector<Courbe> _courbes;
+    std::vector<Primitive> _primitives;
+    std::uint32_t _nbFormes = 0;
+
+    /** @brief Ordonnée du contour @p k en @p x. */
+    static double ordonnee(const Courbe& k, double x);
+
+    /** @brief Intégrale de l'ordonnée du contour @p k sur [xg, xd], connaissant son ordonnée au milieu. */
+    static double integrale(const Courbe& k, double xg, double xd, double yMilieu);
+
+    /** @brief Ajoute à @p xs les abscisses des intersections entre @p i et @p j. */
+    static void intersections(const Primitive& i, const Primitive& j, std::vector<double>& xs);
+
+    /** @brief Abscisses délimitant les bandes, triées et sans doublon. */
+    std::vector<double> bornes(const std::vector<Courbe>& courbes, PoolThreads* pool) const;
+
+    /**
+     * @brief Balaye les bandes [debut, fin) et range dans @p sommes l'aire de chaque paquet.
+     * @param courbes Contours triés par x0.
+     */
+    void balayer(const std::vector<Courbe>& courbes, const std::vector<double>& xs,
+                 std::size_t debut, std::size_t fin, std::vector<double>& sommes) const;
+
+public:
+    /** @brief Nombre de bandes par paquet (unité de répartition et de sommation). */
+    static constexpr std::size_t BANDES_PAR_PAQUET = 512;
+
+    /** @brief Ensemble vide. */
+    AireUnion() = default;
+
+    /** @brief Ensemble des formes simples de @p f (tout le sous-arbre s'il s'agit d'un groupe). */
+    explicit AireUnion(const Forme& f) { ajouter(f); }
+
+    /** @brief Ajoute les formes simples de @p f. */
+    void ajouter(const Forme& f);
+
+    /** @brief Ajoute un polygone donné par ses sommets. */
+    void ajouterPolygone(const Vecteur2D* sommets, std::size_t n);
+
+    /** @brief Ajoute un disque. */
+    void ajouterCercle(const Vecteur2D& centre, double rayon);
+
+    /** @brief Nombre de formes d'aire non nulle possible. */
+    std::size_t nbFormes() const { return _nbFormes; }
+
+    /** @brief Nombre de contours élémentaires (côtés non verticaux, deux arcs par cercle). */
+    std::size_t nbCourbes() const { return _courbes.size(); }
+
+    /**
+     * @brief Aire de la réunion.
+     * @param pool Réserve de threads à utiliser (nullptr : calcul séquentiel).
+     */
+    double calculer(PoolThreads* pool = nullptr) const;
+};
+
+#endif
@@ -0,0 +1,112 @@
+/**
+ * @file AnalyseTexte.h
+ * @brief Analyse sans allocation des lignes du format de sauvegarde texte.
+ */
+
+#ifndef ANALYSE_TEXTE_H
+#define ANALYSE_TEXTE_H
+
+#include <charconv>
+#include <string_view>
+#include <vector>
+#include "vecteur2D.h"
+
+ /**
+  * @brief Primitives d'analyse du format "Type;couleur;donnees...".
+  * @details Toutes les fonctions travaillent directement sur les octets de la ligne
+  * (std::string_view) et lisent les réels avec std::from_chars : aucune chaîne
+  * intermédiaire n'est créée. Chaque fonction renvoie false si le format est invalide.
+  */
+namespace AnalyseTexte {
+
+    /** @brief Préfixes des lignes reconnues. */
+    constexpr std::string_view PREFIXE_CERCLE = "Cercle;";
+    constexpr std::string_view PREFIXE_SEGMENT = "Segment;";
+    constexpr std::string_view PREFIXE_POLYGONE = "Polygone;";
+    constexpr std::string_view PREFIXE_GROUPE = "Groupe;";
+    constexpr std::string_view MARQUEUR_DEBUT = "Debut;";
+    constexpr std::string_view MARQUEUR_FIN = "Fin";
+
+    /** @brief Retire l'éventuel '\r' final (fichiers écrits sous Windows). */
+    inline std::string_view sansRetourChariot(std::string_view ligne) {
+        if (!ligne.empty() && ligne.back() == '\r') ligne.remove_suffix(1);
+        return ligne;
+    }
+
+    /** @brief Consomme le caractère attendu. */
+    inline bool attendre(const char*& p, const char* fin, char c) {
+        if (p == fin || *p != c) return false;
+        ++p;
+        return true;
+    }
+
+    /** @brief Lit un réel avec std::from_chars. */
+    inline bool lireReel(const char*& p, const char* fin, double& valeur) {
+        // from_chars n'accepte pas le '+' explicite que strtod tolère.
+        if (p != fin && *p == '+') ++p;
+        auto res = std::from_chars(p, fin, valeur);
+        if (res.ec != std::errc()) return false;
+        p = res.ptr;
+        return true;
+    }
+
+    /** @brief Lit un point au format "(x,y)". */
+    inline bool lirePoint(const char*& p, const char* fin, Vecteur2D& point) {
+        return attendre(p, fin, '(') && lireReel(p, fin, point.x)
+            && attendre(p, fin, ',') && lireReel(p, fin, point.y)
+            && attendre(p, fin, ')');
+    }
+
+    /** @brief Lit un champ jusqu'au prochain ';' (exclu) ou jusqu'à la fin. */
+    inline std::string_view lireChamp(const char*& p, const char* fin) {
+        const char* debut = p;
+        while (p != fin && *p != ';') ++p;
+        return std::string_view(debut, static_cast<std::size_t>(p - debut));
+    }
+
+    /**
+     * @brief Analyse le corps d'une ligne Cercle (après "Cercle;").
+     * @details Format : couleur;(x,y);rayon
+     */
+    inline bool analyserCercle(std::string_view corps, std::string_view& couleur,
+                               Vecteur2D& centre, double& rayon) {
+        const char* p = corps.data();
+        const char* fin = p + corps.size();
+        couleur = lireChamp(p, fin);
+        return attendre(p, fin, ';') && lirePoint(p, fin, centre)
+            && attendre(p, fin, ';') && lireReel(p, fin, rayon) && p == fin;
+    }
+
+    /**
+     * @brief Analyse le corps d'une ligne Segment (après "Segment;").
+     * @details Format : couleur;(x1,y1);(x2,y2)
+     */
+    inline bool analyserSegment(std::string_view corps, std::string_view& couleur,
+                                Vecteur2D& p1, Vecteur2D& p2) {
+        const char* p = corps.data();
+        const char* fin = p + corps.size();
+        couleur = lireChamp(p, fin);
+        return attendre(p, fin, ';') && lirePoint(p, fin, p1)
+            && attendre(p, fin, ';') && lirePoint(p, fin, p2) && p == fin;
+    }
+
+    /**
+     * @brief Analyse le corps d'une ligne Polygone (après "Polygone;").
+     * @details Format : couleur;(x,y);(x,y);... Les sommets sont ajoutés à @p sommets,
+     * que l'appelant peut réutiliser d'une ligne à l'autre.
+     */
+    inline bool analyserPolygone(std::string_view corps, std::string_view& couleur,
+                                 std::vector<Vecteur2D>& sommets) {
+        const char* p = corps.data();
+        const char* fin = p + corps.size();
+        couleur = lireChamp(p, fin);
+        while (p != fin) {
+            Vecteur2D s;
+            if (!attendre(p, fin, ';') || !lirePoint(p, fin, s)) return false;
+            sommets.push_back(s);
+        }
+        return true;
+    }
+}
+
+#endif
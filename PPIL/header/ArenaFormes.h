@@ -0,0 +1,111 @@
+/**
+ * @file ArenaFormes.h
+ * @brief Allocateur monotone (arène) pour les formes d'une scène.
+ */
+
+#ifndef ARENA_FORMES_H
+#define ARENA_FORMES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include <vector>
+
+class Forme;
+
+ /**
+  * @class ArenaFormes
+  * @brief Réserve de mémoire par grands blocs, libérée en une seule fois.
+  * * Une allocation se réduit à l'avancement d'un pointeur dans le bloc courant ; la mémoire
+  * d'un objet n'est jamais rendue individuellement mais avec toute l'arène, à sa destruction
+  * ou par liberer(). Les objets alloués à la suite sont contigus en mémoire.
+  *
+  * Une forme construite par creer() ne doit jamais être détruite par delete : detruire()
+  * appelle son destructeur et laisse sa mémoire à l'arène. Rien n'est ajouté aux formes
+  * elles-mêmes ; c'est l'arène qui reconnaît ses adresses (contient()).
+  *
+  * Non synchronisée : une arène ne doit être utilisée que par un thread à la fois.
+  */
+class ArenaFormes {
+private:
+    std::vector<void*> _blocs;   ///< Blocs obtenus du système, libérés ensemble.
+    std::vector<std::pair<std::uintptr_t, std::uintptr_t>> _bornes; ///< [début, fin) des blocs, triés.
+    char* _courant;              ///< Prochain octet libre du bloc courant.
+    char* _finBloc;              ///< Fin du bloc courant.
+    std::size_t _tailleBloc;     ///< Taille du prochain bloc (croissance géométrique).
+    std::size_t _utilise;        ///< Octets alloués depuis la création ou le dernier liberer().
+
+    /** @brief Ouvre un nouveau bloc d'au moins @p taille octets. */
+    void nouveauBloc(std::size_t taille);
+
+public:
+    /** @brief Alignement garanti de toute allocation. */
+    static constexpr std::size_t ALIGNEMENT = alignof(std::max_align_t);
+
+    /** @brief Taille du premier bloc. */
+    static constexpr std::size_t TAILLE_BLOC_INITIALE = 64 * 1024;
+
+    /** @brief Taille maximale d'un bloc ordinaire. */
+    static constexpr std::size_t TAILLE_BLOC_MAX = 4 * 1024 * 1024;
+
+    ArenaFormes() : _courant(nullptr), _finBloc(nullptr), _tailleBloc(TAILLE_BLOC_INITIALE), _utilise(0) {}
+
+    /** @brief Rend tous les blocs au système. */
+    ~ArenaFormes() { liberer(); }
+
+    ArenaFormes(const ArenaFormes&) = delete;
+    ArenaFormes& operator=(const ArenaFormes&) = delete;
+
+    /**
+     * @brief Réserve @p taille octets alignés sur ALIGNEMENT.
+     * @throws std::bad_alloc si le système refuse un nouveau bloc.
+     */
+    void* allouer(std::size_t taille) {
+        taille = (taille + ALIGNEMENT - 1) & ~(ALIGNEMENT - 1);
+        if (static_cast<std::size_t>(_finBloc - _courant) < taille) nouveauBloc(taille);
+        void* p = _courant;
+        _courant += taille;
+        _utilise += taille;
+        return p;
+    }
+
+    /** @brief Construit un objet dans l'arène. */
+    template <class T, class... Args>
+    T* creer(Args&&... args) {
+        return ::new (allouer(sizeof(T))) T(std::forward<Args>(args)...);
+    }
+
+    /** @brief Vrai si @p p désigne de la mémoire de l'arène. */
+    bool contient(const void* p) const;
+
+    /**
+     * @brief Détruit l'arbre de formes @p f.
+     * @details Les formes de l'arène sont seulement détruites, leur mémoire restant à l'arène ;
+     * celles du tas (un groupe de l'arène peut en contenir, et inversement) sont rendues par
+     * delete. Les enfants d'un groupe sont détruits de la même façon, avant lui.
+     */
+    void detruire(Forme* f);
+
+    /**
+     * @brief Rend toute la mémoire en une fois.
+     * @warning Les objets alloués doivent avoir été détruits auparavant.
+     */
+    void liberer();
+
+    /**
+     * @brief Repart du début du dernier bloc obtenu et rend les autres au système.
+     * @details Pour une arène de travail remplie et vidée à répétition : après quelques tours,
+     * le bloc gardé suffit et plus aucune allocation système n'a lieu.
+     * @warning Les objets alloués doivent avoir été détruits auparavant.
+     */
+    void recommencer();
+
+    /** @brief Octets alloués (alignement compris). */
+    std::size_t utilise() const { return _utilise; }
+
+    /** @brief Nombre de blocs obtenus du système. */
+    std::size_t nbBlocs() const { return _blocs.size(); }
+};
+
+#endif
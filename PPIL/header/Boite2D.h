@@ -0,0 +1,141 @@
+/**
+ * @file Boite2D.h
+ * @brief Boîte englobante alignée sur les axes et cache des métriques dérivées d'une forme.
+ */
+
+#ifndef BOITE_2D_H
+#define BOITE_2D_H
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "vecteur2D.h"
+#include "Transformation2D.h"
+
+ /**
+  * @class Boite2D
+  * @brief Rectangle aligné sur les axes [xmin, xmax] x [ymin, ymax].
+  * * Une boîte construite par défaut est vide : l'étendre à un point donne la boîte réduite à ce point.
+  */
+class Boite2D {
+public:
+    double xmin, ymin, xmax, ymax;
+
+    /** @brief Construit la boîte vide. */
+    Boite2D()
+        : xmin(std::numeric_limits<double>::infinity()), ymin(std::numeric_limits<double>::infinity()),
+          xmax(-std::numeric_limits<double>::infinity()), ymax(-std::numeric_limits<double>::infinity()) {}
+
+    /** @brief Construit une boîte à partir de ses bornes. */
+    Boite2D(double xmin, double ymin, double xmax, double ymax)
+        : xmin(xmin), ymin(ymin), xmax(xmax), ymax(ymax) {}
+
+    /** @brief Boîte englobant deux points quelconques. */
+    static Boite2D entre(const Vecteur2D& p, const Vecteur2D& q) {
+        return Boite2D(std::min(p.x, q.x), std::min(p.y, q.y), std::max(p.x, q.x), std::max(p.y, q.y));
+    }
+
+    bool estVide() const { return !(xmin <= xmax && ymin <= ymax); }
+    double largeur() const { return estVide() ? 0 : xmax - xmin; }
+    double hauteur() const { return estVide() ? 0 : ymax - ymin; }
+    Vecteur2D centre() const { return Vecteur2D((xmin + xmax) / 2, (ymin + ymax) / 2); }
+
+    /** @brief Agrandit la boîte pour contenir le point. */
+    void etendre(const Vecteur2D& p) {
+        xmin = std::min(xmin, p.x);
+        ymin = std::min(ymin, p.y);
+        xmax = std::max(xmax, p.x);
+        ymax = std::max(ymax, p.y);
+    }
+
+    /** @brief Agrandit la boîte pour contenir une autre boîte. */
+    void etendre(const Boite2D& b) {
+        xmin = std::min(xmin, b.xmin);
+        ymin = std::min(ymin, b.ymin);
+        xmax = std::max(xmax, b.xmax);
+        ymax = std::max(ymax, b.ymax);
+    }
+
+    bool contient(const Vecteur2D& p) const {
+        return p.x >= xmin && p.x <= xmax && p.y >= ymin && p.y <= ymax;
+    }
+
+    bool intersecte(const Boite2D& b) const {
+        return xmin <= b.xmax && b.xmin <= xmax && ymin <= b.ymax && b.ymin <= ymax;
+    }
+
+    /** @brief Distance d'un point à la boîte (0 s'il est à l'intérieur). */
+    double distance(const Vecteur2D& p) const {
+        double dx = std::max({ xmin - p.x, 0.0, p.x - xmax });
+        double dy = std::max({ ymin - p.y, 0.0, p.y - ymax });
+        return std::sqrt(dx * dx + dy * dy);
+    }
+
+    /** @brief Demi-périmètre, critère usuel de coût des hiérarchies de boîtes. */
+    double demiPerimetre() const { return largeur() + hauteur(); }
+
+    /**
+     * @brief Boîte englobant l'image de la boîte par @p m.
+     * @details Exacte si la partie linéaire de m est diagonale (translation, homothétie),
+     * seulement englobante sinon (rotation).
+     */
+    Boite2D transformee(const Transformation2D& m) const {
+        if (estVide()) return *this;
+        Boite2D r;
+        r.etendre(m.appliquer(Vecteur2D(xmin, ymin)));
+        r.etendre(m.appliquer(Vecteur2D(xmin, ymax)));
+        r.etendre(m.appliquer(Vecteur2D(xmax, ymin)));
+        r.etendre(m.appliquer(Vecteur2D(xmax, ymax)));
+        return r;
+    }
+};
+
+/**
+ * @struct CacheMetriques
+ * @brief Valeurs dérivées mémorisées d'une forme (aire, périmètre, boîte englobante, centroïde).
+ * * Les valeurs sont suivies à travers les transformations plutôt que recalculées :
+ * une similitude de rapport k multiplie l'aire par k² et le périmètre par |k| ;
+ * la boîte reste exacte sous translation et homothétie, et est invalidée par une rotation ;
+ * le centroïde se transforme comme un point.
+ */
+struct CacheMetriques {
+    double aire = 0;
+    double perimetre = 0;
+    Boite2D boite;
+    Vecteur2D centroide;
+    bool aireValide = false;
+    bool perimetreValide = false;
+    bool boiteValide = false;
+    bool centroideValide = false;
+
+    /** @brief Oublie toutes les valeurs mémorisées. */
+    void invalider() { aireValide = perimetreValide = boiteValide = centroideValide = false; }
+
+    /** @brief Translation : aire et périmètre inchangés, boîte et centroïde déplacés. */
+    void translater(const Vecteur2D& v) {
+        boite = Boite2D(boite.xmin + v.x, boite.ymin + v.y, boite.xmax + v.x, boite.ymax + v.y);
+        centroide += v;
+    }
+
+    /** @brief Homothétie : aire multipliée par k², périmètre par |k|, boîte et centroïde mis à l'échelle. */
+    void homothetie(const Vecteur2D& centre, double rapport) {
+        aire *= rapport * rapport;
+        perimetre *= std::abs(rapport);
+        boite = boite.transformee(Transformation2D::homothetie(centre, rapport));
+        centroide = centre + (centroide - centre) * rapport;
+    }
+
+    /** @brief Rotation : aire et périmètre inchangés, boîte et centroïde à recalculer. */
+    void tourner() { boiteValide = centroideValide = false; }
+
+    /** @brief Répercute une similitude quelconque sur les valeurs mémorisées. */
+    void transformer(const Transformation2D& m) {
+        aire *= std::abs(m.determinant());
+        perimetre *= m.echelle();
+        if (m.b == 0 && m.c == 0) boite = boite.transformee(m);
+        else boiteValide = false;
+        centroide = m.appliquer(centroide);
+    }
+};
+
+#endif
@@ -12,6 +12,7 @@
 
 #include "Forme.h"
 #include "VisiteurForme.h"
+#include "Instrumentation.h"
 #include <stdexcept>
 #include <cmath>
 
@@ -26,6 +27,18 @@ private:
     Vecteur2D _centre; ///< Le point central du cercle.
     double _rayon;     ///< Le rayon du cercle (doit être > 0).
 
+    friend class JournalTransformations; ///< Restaure la géométrie d'une copie.
+
+protected:
+    /** * @brief Transformation composée.
+     * Le centre suit la transformation, le rayon est multiplié par son facteur d'échelle.
+     */
+    void transformer(const Transformation2D& m) override {
+        PPIL_COMPTER(CERCLE, TRANSFORMATION);
+        _centre = m.appliquer(_centre);
+        _rayon *= m.echelle();
+    }
+
 public:
     /**
      * @brief Constructeur de Cercle.
@@ -45,46 +58,73 @@ public:
     virtual ~Cercle() {}
 
     // Accesseurs
-    const Vecteur2D& getCentre() const { return _centre; }
-    double getRayon() const { return _rayon; }
+    const Vecteur2D& getCentre() const { synchroniser(); return _centre; }
+    double getRayon() const { synchroniser(); return _rayon; }
 
     /** * @brief Translation du cercle.
      * Seul le centre subit le déplacement.
      */
     void translation(const Vecteur2D& v) override {
+        PPIL_COMPTER(CERCLE, TRANSFORMATION);
+        synchroniser();
         _centre += v;
+        marquerModifiee();
     }
 
     /** * @brief Homothétie du cercle.
      * Modifie la position du centre et la taille du rayon (opération de zoom ).
      */
     void homothetie(const Vecteur2D& centre, double rapport) override {
+        PPIL_COMPTER(CERCLE, TRANSFORMATION);
+        synchroniser();
         _centre = centre + (_centre - centre) * rapport;
         _rayon *= std::abs(rapport);
+        marquerModifiee();
     }
 
     /** * @brief Rotation du cercle.
      * Applique une rotation au centre du cercle autour d'un point invariant.
      */
     void rotation(const Vecteur2D& centre, double angle) override {
+        PPIL_COMPTER(CERCLE, TRANSFORMATION);
+        synchroniser();
+        const double co = cos(angle), si = sin(angle);
         double dx = _centre.x - centre.x;
         double dy = _centre.y - centre.y;
-        double x = centre.x + dx * cos(angle) - dy * sin(angle);
-        double y = centre.y + dx * sin(angle) + dy * cos(angle);
+        double x = centre.x + dx * co - dy * si;
+        double y = centre.y + dx * si + dy * co;
         _centre = Vecteur2D(x, y);
+        marquerModifiee();
     }
 
     /** * @brief Calcule l'aire du cercle (π * r²).
      * @return L'aire sous forme de nombre réel.
      */
     double calculerAire() const override {
+        PPIL_COMPTER(CERCLE, AIRE);
+        synchroniser();
         return M_PI * _rayon * _rayon;
     }
 
+    /** @brief Circonférence (2π * r). */
+    double calculerPerimetre() const override {
+        synchroniser();
+        return 2 * M_PI * _rayon;
+    }
+
+    /** @brief Carré circonscrit au cercle. */
+    Boite2D calculerBoite() const override {
+        synchroniser();
+        return Boite2D(_centre.x - _rayon, _centre.y - _rayon, _centre.x + _rayon, _centre.y + _rayon);
+    }
+
     /** * @brief Pattern Visitor : Accepte un visiteur pour le dessin ou la sauvegarde.
      * @param v Le visiteur (ex: TCP/IP ou Fichier ).
      */
     void accepte(VisiteurForme* v) const override {
+        PPIL_COMPTER(CERCLE, VISITE);
+        PPIL_CHRONO("visite Cercle");
+        synchroniser();
         v->visite(*this);
     }
 
@@ -92,7 +132,8 @@ public:
      * @return Format textuel : "Cercle [C:(x,y), R:rayon], couleur".
      */
     operator std::string() const override {
-        return "Cercle [C:" + (std::string)_centre + ", R:" + std::to_string(_rayon) + "], " + _couleur;
+        synchroniser();
+        return FormatTexte::description(*this);
     }
 };
 
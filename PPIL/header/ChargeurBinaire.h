@@ -0,0 +1,53 @@
+/**
+ * @file ChargeurBinaire.h
+ * @brief Chargement des scènes enregistrées par VisiteurSauvegardeBinaire.
+ */
+
+#ifndef CHARGEUR_BINAIRE_H
+#define CHARGEUR_BINAIRE_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <memory>
+#include "Forme.h"
+
+class Groupe;
+
+ /**
+  * @class ChargeurBinaire
+  * @brief Reconstruit les formes à partir du format binaire décrit dans FormatBinaire.h.
+  * * La hiérarchie des groupes est reconstituée à partir des enregistrements imbriqués.
+  * Les formes retournées appartiennent à l'appelant (ou au Groupe auquel il les ajoute).
+  * Chaque prototype n'est construit qu'une fois et partagé par toutes ses instances.
+  */
+class ChargeurBinaire {
+public:
+    /** @brief Prototypes d'instances déjà lus, par numéro. */
+    using Prototypes = std::vector<std::shared_ptr<const Groupe>>;
+
+    /**
+     * @brief Lit les enregistrements de [donnees, donnees + taille) et les ajoute à @p groupe.
+     * @param prototypes Prototypes définis plus tôt dans le fichier ; complété par ceux rencontrés.
+     * @param pas Pas de quantification lu dans l'en-tête du fichier, ou 0 (réels en clair).
+     * @throw std::runtime_error Si le contenu est corrompu.
+     */
+    static void chargerEnfants(const char* donnees, std::size_t taille, Groupe& groupe, Prototypes& prototypes,
+                               double pas = 0);
+
+    /**
+     * @brief Charge toutes les formes de premier niveau d'un fichier binaire.
+     * @param nomFichier Chemin du fichier disque.
+     * @return Les formes lues, dans l'ordre du fichier.
+     * @throw std::runtime_error Si le fichier est illisible, d'une version inconnue ou corrompu.
+     */
+    static std::vector<Forme*> chargerFichier(const std::string& nomFichier);
+
+    /**
+     * @brief Charge les formes depuis un contenu déjà en mémoire (en-tête compris).
+     * @throw std::runtime_error Si le contenu est d'une version inconnue ou corrompu.
+     */
+    static std::vector<Forme*> chargerMemoire(const char* donnees, std::size_t taille);
+};
+
+#endif
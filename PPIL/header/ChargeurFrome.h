@@ -41,6 +41,15 @@ public:
      * @return Forme* Un pointeur vers la forme créée, ou nullptr si la fin de la chaîne est atteinte sans succès.
      */
     virtual Forme* charger(const std::string& ligne) = 0;
+
+protected:
+    /**
+     * @brief Transmet la ligne au maillon suivant.
+     * @return Forme* La forme créée plus loin dans la chaîne, ou nullptr si la chaîne est épuisée.
+     */
+    Forme* transmettre(const std::string& ligne) {
+        return _suivant ? _suivant->charger(ligne) : nullptr;
+    }
 };
 
 #endif
\ No newline at end of file
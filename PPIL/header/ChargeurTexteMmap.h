@@ -0,0 +1,58 @@
+/**
+ * @file ChargeurTexteMmap.h
+ * @brief Chargement du format texte par projection mémoire et répartition par table.
+ */
+
+#ifndef CHARGEUR_TEXTE_MMAP_H
+#define CHARGEUR_TEXTE_MMAP_H
+
+#include <string>
+#include <vector>
+#include "Forme.h"
+#include "ChargeurFrome.h"
+
+ /**
+  * @class ChargeurTexteMmap
+  * @brief Relit un fichier produit par VisiteurSauvegardeTexte sans copie intermédiaire.
+  * * Le fichier est projeté en mémoire et chaque ligne est analysée directement dans
+  * les octets projetés (std::from_chars). Le type de ligne est déterminé par une table
+  * indexée sur le premier octet, puis la hiérarchie Groupe;Debut / Groupe;Fin est
+  * reconstruite à l'aide d'une pile.
+  * Les lignes au préfixe inconnu sont confiées à une chaîne ChargeurForme de secours.
+  */
+class ChargeurTexteMmap {
+private:
+    ChargeurForme* _secours; ///< Chaîne de responsabilité pour les préfixes inconnus (possédée).
+
+public:
+    /**
+     * @brief Constructeur.
+     * @param secours Chaîne consultée pour les lignes non reconnues (peut être nullptr).
+     * Le chargeur en devient propriétaire.
+     */
+    explicit ChargeurTexteMmap(ChargeurForme* secours = nullptr) : _secours(secours) {}
+
+    /** @brief Destructeur : libère la chaîne de secours. */
+    ~ChargeurTexteMmap() { delete _secours; }
+
+    ChargeurTexteMmap(const ChargeurTexteMmap&) = delete;
+    ChargeurTexteMmap& operator=(const ChargeurTexteMmap&) = delete;
+
+    /**
+     * @brief Charge toutes les formes de premier niveau d'un fichier texte.
+     * @param nomFichier Chemin du fichier disque.
+     * @return Les formes lues, dans l'ordre du fichier (propriété de l'appelant).
+     * @throw std::runtime_error Si le fichier est illisible, mal imbriqué ou contient une ligne non reconnue.
+     */
+    std::vector<Forme*> chargerFichier(const std::string& nomFichier) const;
+
+    /**
+     * @brief Charge les formes contenues dans une zone mémoire au format texte.
+     * @param debut Premier octet de la zone.
+     * @param fin Position suivant le dernier octet.
+     * @throw std::runtime_error Si la zone est mal imbriquée ou contient une ligne non reconnue.
+     */
+    std::vector<Forme*> chargerMemoire(const char* debut, const char* fin) const;
+};
+
+#endif
@@ -0,0 +1,65 @@
+/**
+ * @file ChargeurTexteParallele.h
+ * @brief Chargement multi-thread des fichiers de sauvegarde texte volumineux.
+ */
+
+#ifndef CHARGEUR_TEXTE_PARALLELE_H
+#define CHARGEUR_TEXTE_PARALLELE_H
+
+#include <functional>
+#include <string>
+#include <vector>
+#include "Forme.h"
+#include "ChargeurFrome.h"
+#include "PoolThreads.h"
+
+ /**
+  * @class ChargeurTexteParallele
+  * @brief Découpe le fichier en sous-arbres équilibrés et les analyse sur plusieurs threads.
+  * * Un premier passage repère les limites des formes de premier niveau (les paires
+  * Groupe;Debut / Groupe;Fin étant équilibrées). Si le fichier se résume à un groupe
+  * englobant unique, le découpage se fait à l'intérieur de celui-ci. Les formes sont
+  * ensuite réparties en tranches contiguës analysées par ChargeurTexteMmap, puis
+  * recollées dans l'ordre du fichier : l'arbre obtenu est identique à celui du
+  * chargement séquentiel.
+  * Les lignes au préfixe inconnu sont confiées, comme par ChargeurTexteMmap, à une chaîne
+  * ChargeurForme de secours ; une chaîne n'étant pas prévue pour plusieurs threads, chaque
+  * tranche reçoit la sienne, construite par la fabrique donnée au constructeur.
+  */
+class ChargeurTexteParallele {
+public:
+    /** @brief Construit une chaîne de secours neuve (dont l'appelant devient propriétaire), ou nullptr. */
+    using FabriqueSecours = std::function<ChargeurForme*()>;
+
+private:
+    mutable PoolThreads _pool; ///< Threads réutilisés d'un chargement à l'autre.
+    FabriqueSecours _secours;  ///< Appelée une fois par tranche (et par chargement séquentiel).
+
+public:
+    /**
+     * @brief Constructeur.
+     * @param nbThreads Nombre de threads (0 pour le nombre de cœurs disponibles).
+     * @param secours Fabrique des chaînes de secours, appelée depuis les threads du pool
+     * (vide : aucune chaîne, toute ligne inconnue est une erreur).
+     */
+    explicit ChargeurTexteParallele(std::size_t nbThreads = 0, FabriqueSecours secours = {})
+        : _pool(nbThreads), _secours(std::move(secours)) {}
+
+    /** @brief Nombre de threads utilisés pour l'analyse. */
+    std::size_t nbThreads() const { return _pool.taille(); }
+
+    /**
+     * @brief Charge toutes les formes de premier niveau d'un fichier texte.
+     * @return Les formes lues, dans l'ordre du fichier (propriété de l'appelant).
+     * @throw std::runtime_error Si le fichier est illisible, mal imbriqué ou contient une ligne non reconnue.
+     */
+    std::vector<Forme*> chargerFichier(const std::string& nomFichier) const;
+
+    /**
+     * @brief Charge les formes contenues dans une zone mémoire au format texte.
+     * @throw std::runtime_error Si la zone est mal imbriquée ou contient une ligne non reconnue.
+     */
+    std::vector<Forme*> chargerMemoire(const char* debut, const char* fin) const;
+};
+
+#endif
@@ -0,0 +1,81 @@
+/**
+ * @file ChargeursTexte.h
+ * @brief Maillons concrets de la chaîne de responsabilité pour le format texte.
+ */
+
+#ifndef CHARGEURS_TEXTE_H
+#define CHARGEURS_TEXTE_H
+
+#include "ChargeurFrome.h"
+#include "AnalyseTexte.h"
+#include "Cercle.h"
+#include "Segement.h"
+#include "Polygone.h"
+#include "Instrumentation.h"
+#include <string>
+
+ /**
+  * @class ChargeurCercle
+  * @brief Reconnaît les lignes "Cercle;couleur;(x,y);rayon".
+  */
+class ChargeurCercle : public ChargeurForme {
+public:
+    ChargeurCercle(ChargeurForme* suivant = nullptr) : ChargeurForme(suivant) {}
+
+    Forme* charger(const std::string& ligne) override {
+        PPIL_CHRONO("ChargeurCercle::charger");
+        std::string_view l = AnalyseTexte::sansRetourChariot(ligne);
+        std::string_view couleur;
+        Vecteur2D centre;
+        double rayon;
+        if (l.starts_with(AnalyseTexte::PREFIXE_CERCLE)
+            && AnalyseTexte::analyserCercle(l.substr(AnalyseTexte::PREFIXE_CERCLE.size()), couleur, centre, rayon)) {
+            return new Cercle(centre, rayon, std::string(couleur));
+        }
+        return transmettre(ligne);
+    }
+};
+
+/**
+ * @class ChargeurSegment
+ * @brief Reconnaît les lignes "Segment;couleur;(x1,y1);(x2,y2)".
+ */
+class ChargeurSegment : public ChargeurForme {
+public:
+    ChargeurSegment(ChargeurForme* suivant = nullptr) : ChargeurForme(suivant) {}
+
+    Forme* charger(const std::string& ligne) override {
+        PPIL_CHRONO("ChargeurSegment::charger");
+        std::string_view l = AnalyseTexte::sansRetourChariot(ligne);
+        std::string_view couleur;
+        Vecteur2D p1, p2;
+        if (l.starts_with(AnalyseTexte::PREFIXE_SEGMENT)
+            && AnalyseTexte::analyserSegment(l.substr(AnalyseTexte::PREFIXE_SEGMENT.size()), couleur, p1, p2)) {
+            return new Segment(p1, p2, std::string(couleur));
+        }
+        return transmettre(ligne);
+    }
+};
+
+/**
+ * @class ChargeurPolygone
+ * @brief Reconnaît les lignes "Polygone;couleur;(x,y);(x,y);...".
+ */
+class ChargeurPolygone : public ChargeurForme {
+public:
+    ChargeurPolygone(ChargeurForme* suivant = nullptr) : ChargeurForme(suivant) {}
+
+    Forme* charger(const std::string& ligne) override {
+        PPIL_CHRONO("ChargeurPolygone::charger");
+        std::string_view l = AnalyseTexte::sansRetourChariot(ligne);
+        std::string_view couleur;
+        std::vector<Vecteur2D> sommets;
+        if (l.starts_with(AnalyseTexte::PREFIXE_POLYGONE)
+            && AnalyseTexte::analyserPolygone(l.substr(AnalyseTexte::PREFIXE_POLYGONE.size()), couleur, sommets)) {
+            return new Polygone(std::move(sommets), std::string(couleur));
+        }
+        return transmettre(ligne);
+    }
+};
+
+#endif
@@ -0,0 +1,184 @@
+/**
+ * @file ConnexionTCP.h
+ * @brief Connexion TCP asynchrone au serveur de dessin : file bornée, thread d'envoi et regroupement.
+ */
+
+#ifndef CONNEXION_TCP_H
+#define CONNEXION_TCP_H
+
+#include "Connexion_m.h"
+#include "FileBornee.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+ /**
+  * @class ConnexionTCP
+  * @brief Implémentation réseau du ConnexionManager.
+  * * envoyer() ne fait que déposer la requête dans une file bornée sans verrou ; un thread
+  * dédié la vide et regroupe les petites requêtes en gros envois (un appel système pour des
+  * centaines de formes). Chaque requête est transmise comme une ligne terminée par '\n' ;
+  * après une négociation acceptée, comme une trame binaire précédée de sa longueur (u32).
+  *
+  * - Contre-pression : si la file est pleine, envoyer() attend qu'une place se libère ;
+  *   essayerEnvoyer() échoue immédiatement à la place.
+  * - Paquets : envoyerPaquet() dépose d'un coup plusieurs requêtes déjà mises en forme par
+  *   ajouterRequete() (une seule opération sur la file pour des centaines de requêtes).
+  * - Points de vidage : vider() attend que tout ce qui a été soumis avant l'appel soit écrit.
+  * - Reconnexion : après une erreur d'envoi, le thread se reconnecte avec un délai croissant
+  *   et renvoie le lot en cours depuis le début du premier paquet incomplet, si bien
+  *   que le nouveau pair ne reçoit jamais de requête tronquée. Les octets déjà acceptés par
+  *   le noyau avant la coupure ne sont pas renvoyés : TCP ne dit pas s'ils ont été reçus.
+  *   L'offre acceptée est rejouée et la réponse du nouveau pair attendue ; s'il la refuse,
+  *   la connexion revient au texte et les requêtes soumises en trames binaires non encore
+  *   écrites sont abandonnées (comptées dans Statistiques::perdues).
+  */
+class ConnexionTCP : public ConnexionManager {
+public:
+    /** @brief Réglages de la connexion. */
+    struct Options {
+        std::size_t capaciteFile = 1 << 16;                 ///< Requêtes en attente au maximum.
+        std::size_t tailleLot = 1 << 16;                    ///< Octets regroupés avant un envoi.
+        std::chrono::milliseconds delaiReconnexionMax{ 2000 }; ///< Plafond de l'attente entre deux tentatives.
+        std::chrono::milliseconds delaiNegociation{ 1000 };    ///< Attente maximale de la réponse à une offre.
+    };
+
+    /** @brief Compteurs cumulés depuis l'ouverture. */
+    struct Statistiques {
+        std::uint64_t requetes = 0;     ///< Requêtes entièrement écrites sur le socket.
+        std::uint64_t octets = 0;       ///< Octets écrits (renvois compris).
+        std::uint64_t lots = 0;         ///< Lots transmis.
+        std::uint64_t reconnexions = 0; ///< Connexions rétablies après une erreur.
+        std::uint64_t perdues = 0;      ///< Requêtes abandonnées à la fermeture faute de serveur.
+    };
+
+private:
+    /** @brief Élément de la file : une requête seule, ou un paquet de requêtes mises en forme. */
+    struct Paquet {
+        std::string octets;
+        std::uint32_t nbRequetes = 0; ///< 0 : requête seule, mise en forme par le thread d'envoi.
+        bool trame = false;           ///< Soumis sous le protocole binaire : écarté après un retour au texte.
+    };
+
+    std::string _hote;
+    std::string _port;
+    Options _options;
+    std::intptr_t _socket;                  ///< Descripteur du socket (-1 si déconnecté).
+    FileBornee<Paquet> _file;               ///< Requêtes soumises, pas encore regroupées.
+    std::thread _thread;                    ///< Thread d'entrée-sortie.
+    std::atomic<bool> _arret;
+    std::atomic<bool> _trames;              ///< Vrai : trames préfixées par leur longueur, sinon lignes.
+    std::string _preambule;                 ///< Offre acceptée, rejouée à chaque reconnexion.
+
+    /** @name Réveils (attente sur atomiques, C++20) @{ */
+    std::atomic<bool> _consommateurEndormi;    ///< Le thread d'envoi attend une requête.
+    std::atomic<std::uint32_t> _signalRequete; ///< Incrémenté pour réveiller le thread d'envoi.
+    std::atomic<std::uint32_t> _producteursBloques; ///< Producteurs en attente d'une place.
+    std::atomic<std::uint32_t> _signalPlace;   ///< Incrémenté quand le thread d'envoi libère des places.
+    std::atomic<std::uint64_t> _retirees;      ///< Éléments sortis de la file et traités.
+    /** @} */
+
+    std::atomic<std::uint64_t> _requetes, _octets, _lots, _reconnexions, _perdues;
+
+    /** @brief Ouvre le socket ; false si le serveur est injoignable. */
+    bool connecter();
+
+    /** @brief Écrit directement sur le socket ; false en cas d'erreur. */
+    bool ecrireTout(const char* donnees, std::size_t taille);
+
+    /** @brief Lit une ligne de réponse du serveur ; false après le délai ou en cas d'erreur. */
+    bool lireLigne(std::string& ligne, std::chrono::milliseconds delai);
+
+    /** @brief Ferme le socket courant. */
+    void fermer();
+
+    /** @brief Boucle du thread d'envoi. */
+    void boucle();
+
+    /**
+     * @brief Écrit un lot entier, en se reconnectant si besoin.
+     * @param fins Position de fin de chaque élément du lot.
+     * @return Nombre d'éléments du lot abandonnés (non nul seulement à la fermeture).
+     */
+    std::size_t transmettre(const std::string& lot, const std::size_t* fins, std::size_t nbElements);
+
+    /** @brief Réveille le thread d'envoi s'il dort. */
+    void reveillerConsommateur();
+
+    /** @brief Dépose un élément ; attend une place si la file est pleine. */
+    void deposer(Paquet&& paquet);
+
+public:
+    /**
+     * @brief Se connecte au serveur de dessin et démarre le thread d'envoi.
+     * @param hote Nom ou adresse du serveur.
+     * @param port Port TCP.
+     * @throw std::runtime_error Si la première connexion échoue.
+     */
+    ConnexionTCP(const std::string& hote, std::uint16_t port, const Options& options);
+    ConnexionTCP(const std::string& hote, std::uint16_t port) : ConnexionTCP(hote, port, Options()) {}
+
+    /**
+     * @brief Transmet les requêtes restantes puis ferme la connexion.
+     * @details Si le serveur a disparu, les requêtes en attente sont abandonnées après une tentative.
+     */
+    ~ConnexionTCP() override;
+
+    /** @brief Dépose la requête ; attend une place si la file est pleine. */
+    void envoyer(const std::string& requete) override;
+
+    /**
+     * @brief Dépose la requête sans jamais attendre.
+     * @return false si la file est pleine (la requête n'est pas envoyée).
+     */
+    bool essayerEnvoyer(std::string requete);
+
+    /**
+     * @brief Ajoute @p requete à @p paquet, mise en forme en ligne, ou en trame précédée de sa
+     * longueur si @p trame.
+     * @details @p trame est lu une fois sur enTrames() au début du paquet et repris pour toutes
+     * ses requêtes, puis passé à envoyerPaquet() : le thread d'envoi peut revenir au texte à tout
+     * moment (offre refusée après une reconnexion), un paquet ne doit pas mêler les deux.
+     */
+    static void ajouterRequete(std::string& paquet, const std::string& requete, bool trame);
+
+    /**
+     * @brief Dépose un paquet de @p nbRequetes requêtes construit avec ajouterRequete().
+     * @param trame Mode dans lequel le paquet a été construit. Un paquet de trames déposé après
+     * un retour au texte est abandonné (compté dans Statistiques::perdues), jamais envoyé en texte.
+     * @details Attend une place si la file est pleine.
+     */
+    void envoyerPaquet(std::string paquet, std::size_t nbRequetes, bool trame);
+
+    /** @brief Attend que toutes les requêtes déjà soumises soient écrites sur le socket. */
+    void vider() override;
+
+    /**
+     * @brief Envoie l'offre, attend la réponse du serveur et passe en trames binaires si elle vaut "OK".
+     * @details Vide d'abord la file. À appeler hors de tout envoi concurrent ;
+     * l'offre acceptée est renvoyée après chaque reconnexion. Sans réponse dans le délai,
+     * la connexion est rouverte en texte (voir revenirAuTexte()).
+     */
+    bool negocier(const std::string& offre) override;
+
+    /**
+     * @brief Renonce au protocole négocié : vide la file, puis rouvre la connexion en texte.
+     * @details Le serveur garde le protocole accepté pour la durée du socket ; une nouvelle
+     * connexion est le seul moyen de l'en faire sortir. Mêmes conditions d'appel que negocier().
+     */
+    void revenirAuTexte();
+
+    /** @brief Vrai tant que le protocole binaire négocié est en vigueur. */
+    bool enTrames() const override { return _trames.load(std::memory_order_acquire); }
+
+    /** @brief Nombre de connexions rétablies (Statistiques::reconnexions). */
+    std::uint64_t generation() const override { return _reconnexions.load(std::memory_order_acquire); }
+
+    /** @brief Instantané des compteurs. */
+    Statistiques statistiques() const;
+};
+
+#endif
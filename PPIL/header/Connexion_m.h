@@ -6,6 +6,10 @@
 #ifndef CONNEXION_MANAGER_H
 #define CONNEXION_MANAGER_H
 
+#include "Instrumentation.h"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
 #include <string>
 #include <iostream>
 
@@ -14,29 +18,56 @@
   * @brief Gère la connexion unique au serveur Java via le pattern Singleton.
   * * L'initialisation du réseau (ex: Winsock) doit être effectuée ici pour garantir
   * qu'elle ne soit faite qu'une seule fois[cite: 54, 55].
+  * L'implémentation par défaut affiche les requêtes sur la console ; une connexion réelle
+  * (voir ConnexionTCP, PoolConnexions) hérite de cette classe et se met en place avec installer().
+  * getInstance() et installer() peuvent être appelés depuis plusieurs threads.
   */
 class ConnexionManager {
 private:
-    static ConnexionManager* _instance; ///< L'instance unique du Singleton.
+    static std::atomic<ConnexionManager*> _instance; ///< L'instance unique du Singleton.
+    static std::mutex _verrouInstance;              ///< Sérialise la création et le remplacement.
 
+protected:
     /**
-     * @brief Constructeur privé pour empêcher l'instanciation directe.
-     * C'est ici que l'Expert Réseau placera l'initialisation de Winsock ou des sockets Unix.
+     * @brief Constructeur protégé pour empêcher l'instanciation directe.
+     * Les classes dérivées placent ici l'initialisation de Winsock ou des sockets Unix.
      */
     ConnexionManager() {
         // L'initialisation de la bibliothèque réseau doit être faite ici.
     }
 
 public:
+    /** @brief Destructeur virtuel : l'instance installée peut être une classe dérivée. */
+    virtual ~ConnexionManager() {}
+
     /**
      * @brief Récupère l'instance unique du gestionnaire de connexion.
+     * @details Verrouillage à double vérification : une fois l'instance créée, l'appel se
+     * réduit à une lecture atomique.
      * @return ConnexionManager* L'unique instance du Singleton.
      */
     static ConnexionManager* getInstance() {
-        if (_instance == nullptr) {
-            _instance = new ConnexionManager();
+        ConnexionManager* instance = _instance.load(std::memory_order_acquire);
+        if (instance == nullptr) {
+            std::lock_guard<std::mutex> verrou(_verrouInstance);
+            instance = _instance.load(std::memory_order_relaxed);
+            if (instance == nullptr) {
+                instance = new ConnexionManager();
+                _instance.store(instance, std::memory_order_release);
+            }
         }
-        return _instance;
+        return instance;
+    }
+
+    /**
+     * @brief Remplace l'instance du Singleton (par exemple par une ConnexionTCP).
+     * @details L'instance précédente est détruite ; le Singleton devient propriétaire de @p connexion.
+     * Aucun autre thread ne doit encore utiliser l'ancienne instance.
+     */
+    static void installer(ConnexionManager* connexion) {
+        std::lock_guard<std::mutex> verrou(_verrouInstance);
+        ConnexionManager* ancienne = _instance.exchange(connexion, std::memory_order_acq_rel);
+        if (ancienne != connexion) delete ancienne;
     }
 
     /**
@@ -46,16 +77,48 @@ public:
      * @param requete La chaîne de caractères formatée selon le protocole choisi.
      */
     virtual void envoyer(const std::string& requete) {
+        PPIL_CHRONO("ConnexionManager::envoyer");
         // Implémentation temporaire pour le débogage.
         std::cout << "Envoi au serveur : " << requete << std::endl;
     }
 
+    /**
+     * @brief Point de vidage : attend que toutes les requêtes déjà soumises soient transmises.
+     * @details À appeler en fin d'image ; une implémentation asynchrone regroupe les envois entre deux vidages.
+     */
+    virtual void vider() {
+        std::cout.flush();
+    }
+
+    /**
+     * @brief Propose au serveur un autre protocole que le texte (voir ProtocoleDessin.h).
+     * @param offre Ligne d'offre, envoyée telle quelle.
+     * @return true si le serveur accepte : chaque requête suivante est alors une trame binaire.
+     * Par défaut l'offre est refusée et le protocole texte reste en vigueur.
+     */
+    virtual bool negocier(const std::string& offre) {
+        (void)offre;
+        return false;
+    }
+
+    /**
+     * @brief Vrai si le protocole négocié est toujours en vigueur.
+     * @details Une connexion peut revenir au texte d'elle-même, si le serveur retrouvé après
+     * une coupure refuse l'offre : l'émetteur doit alors cesser d'envoyer des trames binaires.
+     */
+    virtual bool enTrames() const { return false; }
+
+    /**
+     * @brief Numéro du pair actuel : change à chaque fois que la connexion est rétablie.
+     * @details Un serveur retrouvé après une coupure ne connaît rien de ce qui a été envoyé
+     * à son prédécesseur ; un émetteur qui n'envoie que des différences doit alors tout renvoyer.
+     * Toujours 0 pour une connexion qui ne se rétablit jamais.
+     */
+    virtual std::uint64_t generation() const { return 0; }
+
     // Empêcher la copie et l'affectation pour préserver le Singleton.
     ConnexionManager(const ConnexionManager&) = delete;
     void operator=(const ConnexionManager&) = delete;
 };
 
-// Initialisation de l'instance statique (à placer dans ConnexionManager.cpp)
-// ConnexionManager* ConnexionManager::_instance = nullptr;
-
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,110 @@
+/**
+ * @file EncodeurSauvegarde.h
+ * @brief Écriture des enregistrements des fichiers de sauvegarde, texte et binaire.
+ */
+
+#ifndef ENCODEUR_SAUVEGARDE_H
+#define ENCODEUR_SAUVEGARDE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "vecteur2D.h"
+#include "Transformation2D.h"
+#include "TamponFichier.h"
+
+/**
+ * @class EncodeurTexte
+ * @brief Écrit les lignes du format texte (relu par les chargeurs texte).
+ * * Seule définition du format : les visiteurs de sauvegarde et les sauvegardes de
+ * SceneValeur ne font que lui passer les formes. Les réels sont écrits dans leur forme la
+ * plus courte qui se relit à l'identique (FormatTexte).
+ */
+class EncodeurTexte {
+private:
+    TamponFichier& _sortie;
+
+    void ecrireReel(double valeur);
+    void ecrirePoint(const Vecteur2D& p);
+
+public:
+    explicit EncodeurTexte(TamponFichier& sortie) : _sortie(sortie) {}
+
+    /** @brief "Cercle;couleur;(cx,cy);rayon". */
+    void cercle(const std::string& couleur, const Vecteur2D& centre, double rayon);
+
+    /** @brief "Segment;couleur;(x1,y1);(x2,y2)". */
+    void segment(const std::string& couleur, const Vecteur2D& p1, const Vecteur2D& p2);
+
+    /** @brief "Polygone;couleur;(x1,y1);(x2,y2);...". */
+    void polygone(const std::string& couleur, const Vecteur2D* sommets, std::size_t nombre);
+
+    /** @brief "Groupe;Debut;couleur" : les lignes suivantes sont les formes du groupe. */
+    void debutGroupe(const std::string& couleur);
+
+    /** @brief "Groupe;Fin". */
+    void finGroupe();
+};
+
+/**
+ * @class EncodeurBinaire
+ * @brief Écrit les enregistrements du format décrit par FormatBinaire.h.
+ * * Seule définition du format, comme EncodeurTexte. Les réels sont écrits tels quels, ou
+ * arrondis au pas de quantification et codés en écarts. La longueur d'un groupe (ou d'un
+ * prototype) n'est connue qu'une fois ses enfants écrits : debutGroupe() réserve sa place,
+ * finGroupe() la complète.
+ */
+class EncodeurBinaire {
+private:
+    TamponFichier& _sortie;
+    double _inversePas; ///< 1 / pas de quantification, ou 0 : réels écrits tels quels.
+
+    /** @brief Écrit l'étiquette d'un enregistrement suivie de sa couleur. */
+    void ecrireEntete(unsigned char etiquette, const std::string& couleur);
+
+    /** @brief Écrit une suite de réels en petit-boutiste. */
+    void ecrireReels(const double* valeurs, std::size_t nombre);
+
+    /** @brief Écrit les points d'un enregistrement : réels en clair, ou écarts quantifiés depuis (0,0). */
+    void ecrirePoints(const Vecteur2D* points, std::size_t nombre);
+
+    /** @brief Écrit un varint LEB128. */
+    void ecrireVarint(std::uint64_t valeur);
+
+    /** @brief Réserve la longueur du contenu d'un enregistrement ; renvoie sa position. */
+    std::uint64_t reserverLongueur();
+
+public:
+    /**
+     * @brief Écrit l'en-tête du fichier.
+     * @param pasQuantification Pas de la grille des coordonnées ; 0 : réels exacts.
+     * @throw std::invalid_argument Si le pas est négatif ou non fini.
+     */
+    EncodeurBinaire(TamponFichier& sortie, double pasQuantification);
+
+    /** @brief Cercle : centre, puis rayon (au moins un pas s'il est quantifié). */
+    void cercle(const std::string& couleur, const Vecteur2D& centre, double rayon);
+
+    /** @brief Segment : ses deux extrémités. */
+    void segment(const std::string& couleur, const Vecteur2D& p1, const Vecteur2D& p2);
+
+    /** @brief Polygone : nombre de sommets, puis les sommets. */
+    void polygone(const std::string& couleur, const Vecteur2D* sommets, std::size_t nombre);
+
+    /**
+     * @brief Ouvre un groupe ; ses enfants sont les enregistrements écrits jusqu'à finGroupe().
+     * @return Position à passer à finGroupe().
+     */
+    std::uint64_t debutGroupe(const std::string& couleur);
+
+    /** @brief Ouvre la définition du prototype @p numero, refermée comme un groupe. */
+    std::uint64_t debutPrototype(const std::string& couleur, std::uint32_t numero);
+
+    /** @brief Referme le groupe ou le prototype ouvert à @p debut en complétant sa longueur. */
+    void finGroupe(std::uint64_t debut);
+
+    /** @brief Instance : numéro de son prototype (déjà défini), puis sa transformation. */
+    void instance(const std::string& couleur, std::uint32_t numero, const Transformation2D& m);
+};
+
+#endif
@@ -0,0 +1,51 @@
+/**
+ * @file FichierMappe.h
+ * @brief Projection en mémoire (lecture seule) d'un fichier disque.
+ */
+
+#ifndef FICHIER_MAPPE_H
+#define FICHIER_MAPPE_H
+
+#include <string>
+#include <cstddef>
+
+ /**
+  * @class FichierMappe
+  * @brief Projette un fichier en mémoire pour le lire sans copie (mmap / MapViewOfFile).
+  * * La projection est libérée à la destruction de l'objet ; les pointeurs obtenus
+  * via debut()/fin() ne doivent pas lui survivre.
+  */
+class FichierMappe {
+private:
+    const char* _donnees; ///< Début de la projection (nullptr pour un fichier vide).
+    std::size_t _taille;  ///< Taille du fichier en octets.
+#ifdef _WIN32
+    void* _fichier;       ///< Handle Windows du fichier.
+    void* _projection;    ///< Handle Windows de la projection.
+#endif
+
+public:
+    /**
+     * @brief Projette le fichier en lecture seule.
+     * @param nomFichier Chemin du fichier disque.
+     * @throw std::runtime_error Si le fichier ne peut pas être ouvert ou projeté.
+     */
+    explicit FichierMappe(const std::string& nomFichier);
+
+    /** @brief Libère la projection. */
+    ~FichierMappe();
+
+    FichierMappe(const FichierMappe&) = delete;
+    FichierMappe& operator=(const FichierMappe&) = delete;
+
+    /** @brief Premier octet du fichier. */
+    const char* debut() const { return _donnees; }
+
+    /** @brief Position suivant le dernier octet du fichier. */
+    const char* fin() const { return _donnees + _taille; }
+
+    /** @brief Taille du fichier en octets. */
+    std::size_t taille() const { return _taille; }
+};
+
+#endif
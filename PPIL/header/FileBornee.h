@@ -0,0 +1,127 @@
+/**
+ * @file FileBornee.h
+ * @brief File circulaire bornée sans verrou, à producteurs et consommateurs multiples.
+ */
+
+#ifndef FILE_BORNEE_H
+#define FILE_BORNEE_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+ /**
+  * @class FileBornee
+  * @brief File FIFO de capacité fixe, sans verrou (algorithme de D. Vyukov).
+  * * Chaque case porte un numéro de séquence qui indique si elle est libre pour le tour
+  * courant des producteurs ou pleine pour celui des consommateurs : un producteur et un
+  * consommateur ne se synchronisent que par un compare-and-swap sur leur propre indice.
+  * La capacité est arrondie à la puissance de deux supérieure.
+  *
+  * Les opérations n'attendent jamais : essayerDeposer() échoue si la file est pleine,
+  * essayerRetirer() si elle est vide. La politique d'attente revient à l'appelant.
+  */
+template <typename T>
+class FileBornee {
+private:
+    /** @brief Case de la file : valeur et numéro de séquence. */
+    struct Case {
+        std::atomic<std::size_t> sequence;
+        T valeur;
+    };
+
+    /** @brief Taille d'une ligne de cache : sépare les indices des producteurs et des consommateurs. */
+    static constexpr std::size_t LIGNE = 64;
+
+    std::unique_ptr<Case[]> _cases;
+    std::size_t _masque;
+    alignas(LIGNE) std::atomic<std::size_t> _tete{ 0 };   ///< Prochaine case à remplir.
+    alignas(LIGNE) std::atomic<std::size_t> _queue{ 0 };  ///< Prochaine case à vider.
+
+public:
+    /**
+     * @brief Crée la file.
+     * @param capacite Nombre maximal d'éléments (au moins 2, arrondi à une puissance de deux).
+     */
+    explicit FileBornee(std::size_t capacite) {
+        std::size_t n = 2;
+        while (n < capacite) n <<= 1;
+        _cases.reset(new Case[n]);
+        _masque = n - 1;
+        for (std::size_t i = 0; i < n; ++i) _cases[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    FileBornee(const FileBornee&) = delete;
+    FileBornee& operator=(const FileBornee&) = delete;
+
+    /** @brief Nombre de cases. */
+    std::size_t capacite() const { return _masque + 1; }
+
+    /**
+     * @brief Dépose un élément s'il reste une case libre.
+     * @details En cas d'échec, @p v n'est pas déplacé.
+     * @return false si la file est pleine.
+     */
+    bool essayerDeposer(T&& v) {
+        std::size_t pos = _tete.load(std::memory_order_relaxed);
+        for (;;) {
+            Case& c = _cases[pos & _masque];
+            const std::size_t seq = c.sequence.load(std::memory_order_acquire);
+            const std::ptrdiff_t ecart = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+            if (ecart == 0) {
+                if (_tete.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    c.valeur = std::move(v);
+                    c.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (ecart < 0) {
+                return false; // Case encore occupée par le tour précédent : file pleine.
+            }
+            else {
+                pos = _tete.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Retire l'élément le plus ancien s'il y en a un.
+     * @return false si la file est vide.
+     */
+    bool essayerRetirer(T& v) {
+        std::size_t pos = _queue.load(std::memory_order_relaxed);
+        for (;;) {
+            Case& c = _cases[pos & _masque];
+            const std::size_t seq = c.sequence.load(std::memory_order_acquire);
+            const std::ptrdiff_t ecart = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+            if (ecart == 0) {
+                if (_queue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    v = std::move(c.valeur);
+                    c.sequence.store(pos + _masque + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (ecart < 0) {
+                return false;
+            }
+            else {
+                pos = _queue.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Nombre de dépôts réservés depuis la création de la file.
+     * @details Les éléments sont retirés dans cet ordre : quand les consommateurs en ont retiré
+     * autant, tout ce qui avait été déposé au moment de l'appel est sorti de la file.
+     */
+    std::size_t nbReserves() const { return _tete.load(std::memory_order_acquire); }
+
+    /** @brief Vrai si la file semble vide (instantané, sans garantie en concurrence). */
+    bool estVide() const {
+        return _tete.load(std::memory_order_acquire) == _queue.load(std::memory_order_acquire);
+    }
+};
+
+#endif
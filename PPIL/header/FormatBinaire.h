@@ -0,0 +1,223 @@
+/**
+ * @file FormatBinaire.h
+ * @brief Constantes et primitives d'encodage du format de sauvegarde binaire.
+ */
+
+#ifndef FORMAT_BINAIRE_H
+#define FORMAT_BINAIRE_H
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include "Forme.h"
+
+ /**
+  * @brief Format binaire versionné des scènes.
+  * @details Structure d'un fichier :
+  * - en-tête : "PPIB", version (u16), drapeaux (u16, réservé en version 1) ; en version 2,
+  *   le drapeau QUANTIFIE est suivi du pas de quantification (f64) ;
+  * - puis une suite d'enregistrements : étiquette (u8), couleur, données.
+  *
+  * La couleur est un indice de palette (u8) ; COULEUR_LIBRE est suivi d'une longueur (u16)
+  * et des octets de la couleur. Les données sont, en petit-boutiste :
+  * - Cercle : cx, cy, r (f64) ;
+  * - Segment : x1, y1, x2, y2 (f64) ;
+  * - Polygone : nombre de sommets (u32) puis les couples x, y (f64) ;
+  * - Groupe : longueur en octets de ses enfants (u64) puis les enregistrements enfants,
+  *   ce qui permet à un lecteur de sauter un sous-arbre entier ;
+  * - Prototype : numéro (u32), puis comme un groupe. Définit le groupe partagé par des
+  *   instances, sans ajouter de forme à la scène. Les prototypes sont numérotés à partir de 0
+  *   dans l'ordre de leurs en-têtes et écrits une fois, au premier niveau, avant le premier
+  *   enregistrement de premier niveau qui contient une de leurs instances (un prototype
+  *   après ceux qu'il utilise) : sauter un groupe ne fait jamais perdre une définition ;
+  * - Instance : numéro du prototype (u32) puis la transformation a, b, c, d, tx, ty (f64).
+  *
+  * Un fichier sans instance est identique à ce qu'il était avant l'ajout de ces deux
+  * enregistrements.
+  *
+  * Par défaut (version 1), les réels sont écrits tels quels : la relecture est exacte au bit
+  * près, mais le fichier n'est que 1,1 à 2,5 fois plus petit que le texte, qui écrit lui aussi
+  * chaque réel sous sa forme la plus courte. S'approcher d'un ordre de grandeur suppose de
+  * renoncer à l'exactitude (environ 8 fois plus petit que le texte pour les scènes de
+  * PPIL_bench, pas de 0,01 sur un carré de 10 000 unités).
+  *
+  * Avec QUANTIFIE, chaque coordonnée et chaque rayon sont arrondis à un multiple du pas, et
+  * un enregistrement code ses points comme des écarts (zigzag + varint LEB128) au point
+  * précédent du même enregistrement, le premier partant de (0,0). Le rayon est un varint
+  * zigzag d'au moins 1 (un pas), le nombre de sommets d'un polygone un varint. Chaque
+  * enregistrement se décode donc seul, et un groupe peut toujours être sauté. Longueurs de
+  * groupes, numéros de prototypes et transformations des instances restent inchangés.
+  */
+namespace FormatBinaire {
+
+    const char SIGNATURE[4] = { 'P', 'P', 'I', 'B' };
+    const std::uint16_t VERSION = 1;
+    const std::size_t TAILLE_EN_TETE = 8;
+
+    /** @brief Version des fichiers dont l'en-tête porte des drapeaux. */
+    const std::uint16_t VERSION_DRAPEAUX = 2;
+
+    /** @brief Drapeaux de l'en-tête (version 2). */
+    enum Drapeau : std::uint16_t {
+        QUANTIFIE = 1 ///< Coordonnées quantifiées ; le pas (f64) suit l'en-tête.
+    };
+
+    /** @brief Taille maximale d'un varint LEB128 de 64 bits. */
+    const std::size_t TAILLE_MAX_VARINT = 10;
+
+    /** @brief Étiquettes des enregistrements. */
+    enum Etiquette : std::uint8_t {
+        CERCLE = 1,
+        SEGMENT = 2,
+        POLYGONE = 3,
+        GROUPE = 4,
+        PROTOTYPE = 5,
+        INSTANCE = 6
+    };
+
+    /** @brief Indice de palette signalant une couleur hors palette, stockée en clair. */
+    const std::uint8_t COULEUR_LIBRE = 0xFF;
+
+    /** @brief Couleurs autorisées, dans l'ordre des indices de palette. */
+    inline const std::string& couleurPalette(std::uint8_t indice) {
+        static const std::string* palette[] = {
+            &Forme::BLACK, &Forme::BLUE, &Forme::RED, &Forme::GREEN, &Forme::YELLOW, &Forme::CYAN
+        };
+        return *palette[indice];
+    }
+
+    /** @brief Nombre d'entrées de la palette. */
+    const std::uint8_t TAILLE_PALETTE = 6;
+
+    /** @brief Indice de palette d'une couleur, ou COULEUR_LIBRE si elle n'en fait pas partie. */
+    inline std::uint8_t indicePalette(const std::string& couleur) {
+        for (std::uint8_t i = 0; i < TAILLE_PALETTE; ++i) {
+            if (couleurPalette(i) == couleur) return i;
+        }
+        return COULEUR_LIBRE;
+    }
+
+    /** @brief Encode un entier non signé en petit-boutiste. */
+    template <typename T>
+    inline void encoder(char* dest, T valeur) {
+        if constexpr (std::endian::native == std::endian::little) {
+            std::memcpy(dest, &valeur, sizeof(T));
+        }
+        else {
+            for (std::size_t i = 0; i < sizeof(T); ++i) {
+                dest[i] = static_cast<char>((valeur >> (8 * i)) & 0xFF);
+            }
+        }
+    }
+
+    /** @brief Décode un entier non signé petit-boutiste. */
+    template <typename T>
+    inline T decoder(const char* src) {
+        T valeur = 0;
+        if constexpr (std::endian::native == std::endian::little) {
+            std::memcpy(&valeur, src, sizeof(T));
+        }
+        else {
+            for (std::size_t i = 0; i < sizeof(T); ++i) {
+                valeur |= static_cast<T>(static_cast<unsigned char>(src[i])) << (8 * i);
+            }
+        }
+        return valeur;
+    }
+
+    /** @brief Encode un réel (IEEE 754 binaire64) en petit-boutiste. */
+    inline void encoderReel(char* dest, double valeur) {
+        encoder<std::uint64_t>(dest, std::bit_cast<std::uint64_t>(valeur));
+    }
+
+    /** @brief Décode un réel (IEEE 754 binaire64) petit-boutiste. */
+    inline double decoderReel(const char* src) {
+        return std::bit_cast<double>(decoder<std::uint64_t>(src));
+    }
+
+    /** @brief Zigzag : les petits écarts négatifs restent de petits entiers non signés. */
+    inline std::uint64_t zigzag(std::int64_t v) {
+        return (static_cast<std::uint64_t>(v) << 1) ^ static_cast<std::uint64_t>(v >> 63);
+    }
+
+    inline std::int64_t dezigzag(std::uint64_t v) {
+        return static_cast<std::int64_t>(v >> 1) ^ -static_cast<std::int64_t>(v & 1);
+    }
+
+    /** @brief Encode un entier en varint LEB128 ; @return la fin de l'encodage. */
+    inline char* encoderVarint(char* dest, std::uint64_t v) {
+        while (v >= 0x80) {
+            *dest++ = static_cast<char>((v & 0x7F) | 0x80);
+            v >>= 7;
+        }
+        *dest++ = static_cast<char>(v);
+        return dest;
+    }
+
+    /**
+     * @brief Indice sur la grille de quantification de la valeur @p v.
+     * @throw std::range_error Si la valeur n'est pas finie ou sort de la grille.
+     */
+    inline std::int64_t quantifier(double v, double inversePas) {
+        const double q = std::nearbyint(v * inversePas);
+        if (!(std::abs(q) < 0x1p62)) throw std::range_error("Coordonnée hors de la grille de quantification");
+        return static_cast<std::int64_t>(q);
+    }
+
+    /**
+     * @brief Rayon quantifié : au moins un pas, pour qu'un petit cercle se relise encore.
+     * @details Arrondi à zéro, un rayon inférieur à pas / 2 donnerait un cercle invalide.
+     * @throw std::range_error Si le rayon n'est pas fini ou sort de la grille.
+     */
+    inline std::int64_t quantifierRayon(double rayon, double inversePas) {
+        return std::max<std::int64_t>(1, quantifier(rayon, inversePas));
+    }
+
+    /**
+     * @brief Écrit l'en-tête d'un fichier : version 1, ou version 2 avec le pas si @p pas > 0.
+     * @return Nombre d'octets écrits (au plus TAILLE_EN_TETE + 8).
+     */
+    inline std::size_t ecrireEnTete(char* dest, double pas) {
+        std::memcpy(dest, SIGNATURE, 4);
+        encoder<std::uint16_t>(dest + 4, pas > 0 ? VERSION_DRAPEAUX : VERSION);
+        encoder<std::uint16_t>(dest + 6, pas > 0 ? QUANTIFIE : 0);
+        if (!(pas > 0)) return TAILLE_EN_TETE;
+        encoderReel(dest + TAILLE_EN_TETE, pas);
+        return TAILLE_EN_TETE + 8;
+    }
+
+    /**
+     * @brief Vérifie signature et version d'un en-tête de TAILLE_EN_TETE octets.
+     * @return Ses drapeaux (toujours 0 en version 1).
+     * @throw std::runtime_error Si la signature, la version ou un drapeau est inconnu.
+     */
+    inline std::uint16_t lireEnTete(const char* entete) {
+        if (std::memcmp(entete, SIGNATURE, 4) != 0) {
+            throw std::runtime_error("Signature de fichier binaire invalide");
+        }
+        const std::uint16_t version = decoder<std::uint16_t>(entete + 4);
+        if (version == VERSION) return 0;
+        const std::uint16_t drapeaux = decoder<std::uint16_t>(entete + 6);
+        if (version != VERSION_DRAPEAUX || (drapeaux & ~QUANTIFIE)) {
+            throw std::runtime_error("Version de fichier binaire non prise en charge");
+        }
+        return drapeaux;
+    }
+
+    /**
+     * @brief Décode le pas qui suit un en-tête QUANTIFIE.
+     * @throw std::runtime_error Si le pas n'est pas un réel fini strictement positif.
+     */
+    inline double lirePas(const char* src) {
+        const double pas = decoderReel(src);
+        if (!(pas > 0) || !std::isfinite(pas)) throw std::runtime_error("Pas de quantification invalide dans le fichier binaire");
+        return pas;
+    }
+}
+
+#endif
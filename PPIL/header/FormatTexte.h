@@ -0,0 +1,88 @@
+/**
+ * @file FormatTexte.h
+ * @brief Écriture des réels, des points et des descriptions de formes, sans flux ni allocation.
+ */
+
+#ifndef FORMAT_TEXTE_H
+#define FORMAT_TEXTE_H
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <string>
+
+class Forme;
+
+ /**
+  * @brief Couche de formatage commune aux conversions en chaîne et à la sauvegarde texte.
+  * @details Les réels sont écrits avec std::to_chars dans sa forme la plus courte qui relit
+  * exactement la même valeur (std::from_chars, voir AnalyseTexte.h) : une sauvegarde texte
+  * rechargée reproduit les coordonnées au bit près. Chaque fonction existe en deux versions :
+  * dans un tampon fourni par l'appelant (renvoie la fin de l'écriture), ou vers un itérateur
+  * de sortie quelconque (std::back_inserter, ...).
+  */
+namespace FormatTexte {
+
+    /** @brief Taille suffisante pour un réel ("-2.2250738585072014e-308" : 24 caractères). */
+    const std::size_t TAILLE_MAX_REEL = 32;
+
+    /** @brief Taille suffisante pour un point "(x,y)". */
+    const std::size_t TAILLE_MAX_POINT = 2 * TAILLE_MAX_REEL + 3;
+
+    /** @brief Écrit @p valeur dans @p tampon (au moins TAILLE_MAX_REEL octets). */
+    inline char* ecrireReel(char* tampon, double valeur) {
+        return std::to_chars(tampon, tampon + TAILLE_MAX_REEL, valeur).ptr;
+    }
+
+    /** @brief Écrit le point "(x,y)" dans @p tampon (au moins TAILLE_MAX_POINT octets). */
+    inline char* ecrirePoint(char* tampon, double x, double y) {
+        *tampon++ = '(';
+        tampon = ecrireReel(tampon, x);
+        *tampon++ = ',';
+        tampon = ecrireReel(tampon, y);
+        *tampon++ = ')';
+        return tampon;
+    }
+
+    /** @brief Écrit @p valeur vers un itérateur de sortie. */
+    template <typename Sortie>
+    Sortie ecrireReel(Sortie sortie, double valeur) {
+        char tampon[TAILLE_MAX_REEL];
+        return std::copy(tampon, ecrireReel(tampon, valeur), sortie);
+    }
+
+    /** @brief Écrit le point "(x,y)" vers un itérateur de sortie. */
+    template <typename Sortie>
+    Sortie ecrirePoint(Sortie sortie, double x, double y) {
+        char tampon[TAILLE_MAX_POINT];
+        return std::copy(tampon, ecrirePoint(tampon, x, y), sortie);
+    }
+
+    /** @brief Ajoute @p valeur à la fin de @p s. */
+    inline void ajouterReel(std::string& s, double valeur) {
+        char tampon[TAILLE_MAX_REEL];
+        s.append(tampon, ecrireReel(tampon, valeur));
+    }
+
+    /** @brief Ajoute le point "(x,y)" à la fin de @p s. */
+    inline void ajouterPoint(std::string& s, double x, double y) {
+        char tampon[TAILLE_MAX_POINT];
+        s.append(tampon, ecrirePoint(tampon, x, y));
+    }
+
+    /**
+     * @brief Ajoute la description lisible de @p f (celle de son opérateur std::string) à @p s.
+     * @details Un groupe est décrit en un seul passage dans la même chaîne : le coût est
+     * linéaire en la taille de la description, quelle que soit la profondeur d'imbrication.
+     */
+    void ajouterDescription(std::string& s, const Forme& f);
+
+    /** @brief Description lisible de @p f. */
+    inline std::string description(const Forme& f) {
+        std::string s;
+        ajouterDescription(s, f);
+        return s;
+    }
+}
+
+#endif
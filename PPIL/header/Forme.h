@@ -6,15 +6,22 @@
 #ifndef FORME_H
 #define FORME_H
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <vector>
-#include "Vecteur2D.h"
+#include "vecteur2D.h"
+#include "Transformation2D.h"
+#include "Boite2D.h"
 
  /**
   * @class VisiteurForme
   * @brief Déclaration anticipée pour le Design Pattern Visitor.
   */
 class VisiteurForme;
+class Groupe;
+class PoolThreads;
 
 /**
  * @class Forme
@@ -29,6 +36,99 @@ protected:
      */
     std::string _couleur;
 
+    /** @brief Groupe contenant la forme (nullptr pour une forme racine). */
+    Forme* _parent;
+
+    /** @brief Identifiant stable, unique dans le processus (jamais réutilisé). */
+    std::uint64_t _identifiant;
+
+    /** @brief Date de la dernière modification propre (géométrie ou couleur). */
+    std::uint64_t _version;
+
+    /** @brief Date de la dernière modification dans le sous-arbre (la forme elle-même comprise). */
+    std::uint64_t _versionSousArbre;
+
+    friend class Groupe;
+
+    /**
+     * @brief Horloge des modifications, commune à toutes les formes.
+     * @details Une date plus récente que toutes les précédentes : comparer les dates suffit
+     * à savoir si une forme ou un sous-arbre a changé depuis un instant donné.
+     */
+    static std::uint64_t nouvelleVersion() {
+        return _horloge.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    /**
+     * @brief Signale une modification de la géométrie aux groupes ancêtres.
+     * @details Invalide leurs métriques mémorisées jusqu'à la racine et leur reporte
+     * la date de modification du sous-arbre.
+     */
+    void notifierParents() {
+        for (Forme* p = _parent; p; p = p->_parent) {
+            p->invaliderCache();
+            p->_versionSousArbre = _versionSousArbre;
+        }
+    }
+
+    /** @brief Date une modification propre de la forme et la signale aux groupes ancêtres. */
+    void marquerModifiee() {
+        _version = _versionSousArbre = nouvelleVersion();
+        notifierParents();
+    }
+
+    /** @brief Oublie les métriques mémorisées (formes qui en conservent). */
+    virtual void invaliderCache() {}
+
+    /** @brief Transmet aux enfants les transformations différées (groupes uniquement). */
+    virtual void appliquerEnAttente() const {}
+
+    /**
+     * @brief Vrai si une transformation différée reste à appliquer dans le sous-arbre (groupes uniquement).
+     * @details Tenu à jour par les groupes et remonté le long de _parent, comme l'invalidation des caches.
+     */
+    virtual bool enAttenteDessous() const { return false; }
+
+    /**
+     * @brief Matérialise les transformations différées des groupes ancêtres, de la racine vers la forme.
+     * @details Nécessaire avant de lire ou de modifier directement une forme contenue dans un groupe :
+     * sans cela, une transformation du groupe encore en attente serait appliquée dans le mauvais ordre.
+     * Si rien n'est en attente dans l'arbre de la forme, la racine seule est consultée : les autres
+     * arbres (autres scènes) n'y changent rien.
+     */
+    void synchroniser() const {
+        if (!_parent) return;
+        const Forme* racine = _parent;
+        while (racine->_parent) racine = racine->_parent;
+        if (racine->enAttenteDessous()) appliquerAncetres();
+    }
+
+    /** @brief Applique les transformations en attente des ancêtres, de la racine vers la forme. */
+    void appliquerAncetres() const {
+        if (!_parent) return;
+        _parent->appliquerAncetres();
+        _parent->appliquerEnAttente();
+    }
+
+    /**
+     * @brief Applique une similitude et met à jour les métriques mémorisées,
+     * sans prévenir les groupes parents.
+     * @details Utilisée par un groupe pour transmettre sa transformation en attente :
+     * ses propres métriques en tiennent déjà compte.
+     */
+    virtual void transformer(const Transformation2D& m) = 0;
+
+    /**
+     * @name Calculs répartis
+     * Appelés par un groupe qui calcule sur une réserve de threads (Groupe::calculerAire(PoolThreads*)),
+     * qui la transmet ainsi à ses enfants. Une forme qui n'a rien à répartir calcule comme d'habitude.
+     * @{
+     */
+    virtual double aireRepartie(PoolThreads*) const { return calculerAire(); }
+    virtual double perimetreReparti(PoolThreads*) const { return calculerPerimetre(); }
+    virtual Boite2D boiteRepartie(PoolThreads*) const { return calculerBoite(); }
+    /** @} */
+
 public:
     // Constantes statiques pour les couleurs autorisées 
     static const std::string BLACK;
@@ -42,7 +142,21 @@ public:
      * @brief Constructeur de Forme.
      * @param couleur La couleur initiale (par défaut "black").
      */
-    Forme(const std::string& couleur = "black") : _couleur(couleur) {}
+    Forme(const std::string& couleur = "black")
+        : _couleur(couleur), _parent(nullptr), _identifiant(nouvelIdentifiant()),
+          _version(nouvelleVersion()), _versionSousArbre(_version) {}
+
+    /** @brief Copie : la copie n'appartient à aucun groupe et reçoit son propre identifiant. */
+    Forme(const Forme& f)
+        : _couleur(f._couleur), _parent(nullptr), _identifiant(nouvelIdentifiant()),
+          _version(nouvelleVersion()), _versionSousArbre(_version) {}
+
+    /** @brief Affectation : la forme reste dans son groupe actuel et garde son identifiant. */
+    Forme& operator=(const Forme& f) {
+        _couleur = f._couleur;
+        marquerModifiee();
+        return *this;
+    }
 
     /**
      * @brief Destructeur virtuel pur.
@@ -55,7 +169,36 @@ public:
     virtual const std::string& getCouleur() const { return _couleur; }
 
     /** @brief Modifie la couleur de la forme. */
-    virtual void setCouleur(const std::string& c) { _couleur = c; }
+    virtual void setCouleur(const std::string& c) {
+        _couleur = c;
+        marquerModifiee();
+    }
+
+    /** @brief Groupe contenant la forme, ou nullptr. */
+    Forme* getParent() const { return _parent; }
+
+    /**
+     * @name Suivi des modifications
+     * Permet à un visiteur de ne retraiter que ce qui a changé depuis son dernier passage.
+     * Les transformations d'un groupe sont datées sur le groupe seul : la géométrie effective
+     * d'une forme a changé si sa date ou celle d'un de ses ancêtres est plus récente.
+     * @{
+     */
+    /** @brief Identifiant stable de la forme. */
+    std::uint64_t getIdentifiant() const { return _identifiant; }
+
+    /** @brief Date de la dernière modification propre. */
+    std::uint64_t getVersion() const { return _version; }
+
+    /** @brief Date de la dernière modification de la forme ou d'un de ses descendants. */
+    std::uint64_t getVersionSousArbre() const { return _versionSousArbre; }
+    /** @} */
+
+    /** @brief Nombre de formes simples contenues (1 pour une forme simple). */
+    virtual std::size_t nbFeuilles() const { return 1; }
+
+    /** @brief Nombre d'instances contenues, hors prototypes (1 pour une instance). */
+    virtual std::size_t nbInstances() const { return 0; }
 
     /**
      * @name Transformations Géométriques
@@ -69,6 +212,17 @@ public:
 
     /** @brief Applique une rotation par rapport à un centre et un angle en radians. */
     virtual void rotation(const Vecteur2D& centre, double angleRadians) = 0;
+
+    /**
+     * @brief Applique une transformation affine composée, en un seul passage sur la géométrie.
+     * @details La transformation doit être une similitude (composition de translations,
+     * d'homothéties et de rotations), seule famille qui conserve les cercles.
+     */
+    void appliquer(const Transformation2D& m) {
+        synchroniser();
+        transformer(m);
+        marquerModifiee();
+    }
     /** @} */
 
     /**
@@ -78,6 +232,12 @@ public:
      /** @brief Calcule l'aire de la forme. */
     virtual double calculerAire() const = 0;
 
+    /** @brief Calcule le périmètre (longueur pour un segment, somme pour un groupe). */
+    virtual double calculerPerimetre() const = 0;
+
+    /** @brief Calcule la boîte englobante alignée sur les axes. */
+    virtual Boite2D calculerBoite() const = 0;
+
     /** @brief Opérateur de conversion en string pour l'affichage ou l'export. */
     virtual operator std::string() const = 0;
     /** @} */
@@ -89,6 +249,14 @@ public:
      * @param visiteur Pointeur vers le visiteur souhaité.
      */
     virtual void accepte(VisiteurForme* visiteur) const = 0;
+
+private:
+    inline static std::atomic<std::uint64_t> _horloge{ 0 };
+    inline static std::atomic<std::uint64_t> _prochainIdentifiant{ 0 };
+
+    static std::uint64_t nouvelIdentifiant() {
+        return _prochainIdentifiant.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
 };
 
 
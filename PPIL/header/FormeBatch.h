@@ -0,0 +1,138 @@
+/**
+ * @file FormeBatch.h
+ * @brief Stockage orienté données (structure de tableaux) d'un ensemble de formes.
+ */
+
+#ifndef FORME_BATCH_H
+#define FORME_BATCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Forme.h"
+
+class VisiteurForme;
+class ArenaFormes;
+
+/**
+ * @class FormeBatch
+ * @brief Conteneur de formes en tableaux séparés, transformé par des noyaux SIMD.
+ * * Les coordonnées ne sont plus réparties dans des objets Forme alloués un par un :
+ * centres et rayons des cercles, extrémités des segments et sommets des polygones sont
+ * rangés dans des tableaux contigus de x et de y. Une translation, une homothétie ou une
+ * rotation devient une seule transformation affine appliquée à ces tableaux (AVX2 ou SSE2
+ * selon le processeur, version scalaire sinon), sans aucun appel virtuel.
+ *
+ * La structure (ordre des formes, groupes et couleurs) est conservée, ce qui permet de
+ * reconstruire un arbre de Forme identique et de présenter le lot aux visiteurs existants.
+ */
+class FormeBatch {
+public:
+    /** @brief Nature d'un élément de la structure. */
+    enum TypeNoeud : std::uint8_t {
+        CERCLE,
+        SEGMENT,
+        POLYGONE,
+        DEBUT_GROUPE,
+        FIN_GROUPE
+    };
+
+    /** @brief Élément de la structure : type, indice dans les tableaux du type, indice de couleur. */
+    struct Noeud {
+        TypeNoeud type;
+        std::uint32_t indice;  ///< Indice de la forme dans les tableaux de son type (inutilisé pour les groupes).
+        std::uint32_t couleur; ///< Indice dans la table des couleurs (inutilisé pour FIN_GROUPE).
+    };
+
+private:
+    // Cercles.
+    std::vector<double> _cx, _cy, _rayon;
+    // Segments.
+    std::vector<double> _x1, _y1, _x2, _y2;
+    // Polygones : sommets de tous les polygones à la suite, délimités par _debutSommets.
+    std::vector<double> _px, _py;
+    std::vector<std::uint32_t> _debutSommets;
+
+    std::vector<Noeud> _structure;           ///< Ordre et imbrication des formes.
+    std::vector<std::string> _couleurs;      ///< Couleurs distinctes rencontrées.
+    std::unordered_map<std::string, std::uint32_t> _indicesCouleurs;
+
+    friend class RemplisseurBatch;
+
+    /** @brief Indice de la couleur dans la table (ajoutée si nécessaire). */
+    std::uint32_t indiceCouleur(const std::string& couleur);
+
+    /**
+     * @brief Reconstruit les formes de _structure[debut, fin) (fin exclue).
+     * @param arene Arène où placer les formes (nullptr : tas).
+     * @param sommets Tampon de travail pour les sommets des polygones.
+     */
+    std::vector<Forme*> construire(std::size_t debut, std::size_t fin, ArenaFormes* arene,
+                                   std::vector<Vecteur2D>& sommets) const;
+
+    /** @brief Copie dans @p sommets les sommets du polygone d'indice @p indice. */
+    void sommetsPolygone(std::uint32_t indice, std::vector<Vecteur2D>& sommets) const;
+
+    /**
+     * @brief Applique à tous les points la transformation affine relative au point (ox, oy) :
+     * x' = ox + a.(x - ox) + b.(y - oy) + tx ; y' = oy + c.(x - ox) + d.(y - oy) + ty.
+     */
+    void transformer(double ox, double oy, double a, double b, double c, double d, double tx, double ty);
+
+public:
+    /** @brief Crée un lot vide. */
+    FormeBatch() : _debutSommets(1, 0) {}
+
+    /** @brief Crée un lot à partir d'une forme (récursivement s'il s'agit d'un groupe). */
+    explicit FormeBatch(const Forme& forme) : FormeBatch() { ajouter(forme); }
+
+    /** @brief Ajoute une copie de la forme (et de tout son contenu s'il s'agit d'un groupe). */
+    void ajouter(const Forme& forme);
+
+    /** @brief Vide le lot. */
+    void vider();
+
+    /** @name Tailles @{ */
+    std::size_t nbCercles() const { return _rayon.size(); }
+    std::size_t nbSegments() const { return _x1.size(); }
+    std::size_t nbPolygones() const { return _debutSommets.size() - 1; }
+    std::size_t nbSommets() const { return _px.size(); }
+    /** @} */
+
+    /** @brief Structure du lot (ordre des formes et bornes des groupes). */
+    const std::vector<Noeud>& getStructure() const { return _structure; }
+
+    /** @name Transformations (mêmes conventions que Forme) @{ */
+    void translation(const Vecteur2D& v);
+    void homothetie(const Vecteur2D& centre, double rapport);
+    void rotation(const Vecteur2D& centre, double angle);
+
+    /** @brief Applique une similitude composée en un seul passage. */
+    void appliquer(const Transformation2D& m);
+    /** @} */
+
+    /** @brief Somme des aires des formes du lot (même convention que Groupe::calculerAire). */
+    double calculerAire() const;
+
+    /**
+     * @brief Reconstruit les formes de premier niveau sous forme d'objets Forme.
+     * @return Les formes créées, propriété de l'appelant.
+     */
+    std::vector<Forme*> versFormes() const;
+
+    /**
+     * @brief Présente le lot à un visiteur existant, comme si les formes étaient des objets Forme.
+     * @details Les formes simples de premier niveau sont des temporaires sur la pile. Un
+     * visiteur de groupe parcourant getFormes(), un groupe est reconstruit le temps de sa
+     * visite, dans une arène de travail reprise d'un groupe à l'autre (aucune allocation par
+     * forme, hormis les sommets débordant du stockage interne d'un polygone).
+     */
+    void accepte(VisiteurForme* v) const;
+
+    /** @brief Nom du jeu d'instructions utilisé par les noyaux de transformation ("avx2", "sse2" ou "scalaire"). */
+    static const char* jeuInstructions();
+};
+
+#endif
@@ -0,0 +1,122 @@
+/**
+ * @file Geometrie.h
+ * @brief Prédicats géométriques élémentaires (distances, appartenance, intersection avec une boîte)
+ * et simplification de contours.
+ */
+
+#ifndef GEOMETRIE_H
+#define GEOMETRIE_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include "vecteur2D.h"
+#include "Boite2D.h"
+
+namespace Geometrie {
+
+    /** @brief Distance du point @p p au segment [a, b]. */
+    inline double distanceSegment(const Vecteur2D& p, const Vecteur2D& a, const Vecteur2D& b) {
+        const double dx = b.x - a.x, dy = b.y - a.y;
+        const double l2 = dx * dx + dy * dy;
+        double t = l2 > 0 ? ((p.x - a.x) * dx + (p.y - a.y) * dy) / l2 : 0;
+        t = std::clamp(t, 0.0, 1.0);
+        return std::hypot(p.x - (a.x + t * dx), p.y - (a.y + t * dy));
+    }
+
+    /**
+     * @brief Nombre d'enroulement du contour fermé sommets[0..n) autour de @p p.
+     * @details Non nul si et seulement si le point est à l'intérieur (règle non nulle),
+     * y compris pour un polygone croisé ou parcouru dans le sens horaire.
+     */
+    inline int nombreEnroulement(const Vecteur2D& p, const Vecteur2D* sommets, std::size_t n) {
+        int enroulement = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            const Vecteur2D& a = sommets[i];
+            const Vecteur2D& b = sommets[(i + 1) % n];
+            const double cote = (b.x - a.x) * (p.y - a.y) - (p.x - a.x) * (b.y - a.y);
+            if (a.y <= p.y) {
+                if (b.y > p.y && cote > 0) ++enroulement; // Arête montante, point à gauche.
+            }
+            else if (b.y <= p.y && cote < 0) {
+                --enroulement;                            // Arête descendante, point à droite.
+            }
+        }
+        return enroulement;
+    }
+
+    /** @brief Vrai si le segment [a, b] a au moins un point dans la boîte (découpage de Liang-Barsky). */
+    inline bool segmentIntersecteBoite(const Vecteur2D& a, const Vecteur2D& b, const Boite2D& boite) {
+        double t0 = 0, t1 = 1;
+        const double d[2] = { b.x - a.x, b.y - a.y };
+        const double bas[2] = { boite.xmin - a.x, boite.ymin - a.y };
+        const double haut[2] = { boite.xmax - a.x, boite.ymax - a.y };
+        for (int axe = 0; axe < 2; ++axe) {
+            if (d[axe] == 0) {
+                if (bas[axe] > 0 || haut[axe] < 0) return false;
+                continue;
+            }
+            double entree = bas[axe] / d[axe], sortie = haut[axe] / d[axe];
+            if (entree > sortie) std::swap(entree, sortie);
+            t0 = std::max(t0, entree);
+            t1 = std::min(t1, sortie);
+            if (t0 > t1) return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Simplifie le contour fermé sommets[0..n) par l'algorithme de Douglas-Peucker.
+     * @details Tout sommet retiré est à moins de @p tolerance du contour simplifié. Le contour est
+     * coupé en deux chaînes, du premier sommet au sommet le plus éloigné de lui et retour, puis
+     * chaque chaîne est subdivisée tant qu'un sommet s'écarte de plus de la tolérance de sa corde.
+     * Pile explicite : aucune récursion, même sur des millions de sommets.
+     * @param sortie Sommets conservés, dans l'ordre d'origine (peut en compter moins de 3).
+     */
+    inline void simplifier(const Vecteur2D* sommets, std::size_t n, double tolerance, std::vector<Vecteur2D>& sortie) {
+        sortie.clear();
+        if (n <= 3) {
+            sortie.assign(sommets, sommets + n);
+            return;
+        }
+        std::size_t oppose = 0;
+        double distanceMax = -1;
+        for (std::size_t i = 1; i < n; ++i) {
+            const double d = std::hypot(sommets[i].x - sommets[0].x, sommets[i].y - sommets[0].y);
+            if (d > distanceMax) {
+                distanceMax = d;
+                oppose = i;
+            }
+        }
+        std::vector<char> garde(n, 0);
+        garde[0] = garde[oppose] = 1;
+        // Chaînes [debut, fin], l'indice n désignant le sommet 0 en fin de contour.
+        std::vector<std::pair<std::size_t, std::size_t>> pile = { { 0, oppose }, { oppose, n } };
+        while (!pile.empty()) {
+            const auto [debut, fin] = pile.back();
+            pile.pop_back();
+            const Vecteur2D& a = sommets[debut];
+            const Vecteur2D& b = sommets[fin % n];
+            std::size_t choisi = 0;
+            double ecart = tolerance;
+            for (std::size_t i = debut + 1; i < fin; ++i) {
+                const double d = distanceSegment(sommets[i], a, b);
+                if (d > ecart) {
+                    ecart = d;
+                    choisi = i;
+                }
+            }
+            if (!choisi) continue;
+            garde[choisi] = 1;
+            pile.emplace_back(debut, choisi);
+            pile.emplace_back(choisi, fin);
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            if (garde[i]) sortie.push_back(sommets[i]);
+        }
+    }
+}
+
+#endif
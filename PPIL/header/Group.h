@@ -8,15 +8,31 @@
 
 #include "Forme.h"
 #include "VisiteurForme.h"
+#include "Instrumentation.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
 #include <vector>
 #include <string>
 
+class PoolThreads;
+
 using namespace std;
 
 /**
  * @class Groupe
  * @brief Représente une forme géométrique composée d'une ou plusieurs formes.
  * * Cette classe permet de manipuler un ensemble de formes comme une entité unique.
+ * Les transformations du groupe ne sont pas propagées immédiatement : elles sont composées
+ * dans une matrice en attente (coût constant par modification), appliquée aux enfants en un
+ * seul passage lorsque la géométrie est lue, visitée ou sauvegardée.
+ *
+ * Les calculs acceptent une réserve de threads à vol de tâches (calculerAire(PoolThreads*), etc.),
+ * le temps d'un appel : les sous-arbres d'au moins SEUIL_PARALLELE formes simples y sont répartis
+ * (application des transformations en attente, aire, périmètre et boîte), ainsi que les paquets
+ * des très grands polygones. Les résultats sont identiques au calcul séquentiel, les
+ * contributions des enfants étant toujours cumulées dans l'ordre des enfants.
  */
 class Groupe : public Forme {
 private:
@@ -26,7 +42,172 @@ private:
      */
     vector<Forme*> _formes;
 
+    friend class ArenaFormes; ///< Détruit les enfants d'un groupe sans passer par delete.
+
+    /**
+     * @brief Transformation composée, pas encore appliquée aux enfants.
+     * * Mutable : la matérialiser ne change pas la géométrie observable du groupe.
+     */
+    mutable Transformation2D _enAttente;
+
+    /** @brief Vrai si _enAttente n'est pas encore appliquée aux enfants. */
+    mutable bool _enAttentePropre = false;
+
+    /**
+     * @brief Nombre d'enfants dont le sous-arbre a une transformation en attente.
+     * * Atomique : en mode parallèle, des enfants appliquent la leur en même temps.
+     */
+    mutable std::atomic<size_t> _enfantsEnAttente{ 0 };
+
+    /** @brief Signale aux ancêtres, à partir de @p parent, qu'un enfant vient d'avoir une transformation en attente. */
+    static void signalerEnAttente(Forme* parent) {
+        for (Forme* p = parent; p; p = p->_parent) {
+            Groupe* g = static_cast<Groupe*>(p);
+            // Le groupe était déjà signalé à son parent : inutile de remonter plus haut.
+            if (g->_enfantsEnAttente.fetch_add(1, std::memory_order_relaxed) != 0 || g->_enAttentePropre) break;
+        }
+    }
+
+    /** @brief Signale aux ancêtres, à partir de @p parent, qu'un enfant n'a plus rien en attente. */
+    static void signalerAJour(Forme* parent) {
+        for (Forme* p = parent; p; p = p->_parent) {
+            Groupe* g = static_cast<Groupe*>(p);
+            if (g->_enfantsEnAttente.fetch_sub(1, std::memory_order_relaxed) != 1 || g->_enAttentePropre) break;
+        }
+    }
+
+    /** @brief Compose @p m dans la transformation en attente et le signale aux ancêtres si besoin. */
+    void composerEnAttente(const Transformation2D& m) {
+        _enAttente.puis(m);
+        if (!_enAttentePropre) {
+            const bool dejaSignale = enAttenteDessous();
+            _enAttentePropre = true;
+            if (!dejaSignale) signalerEnAttente(_parent);
+        }
+    }
+
+    /** @brief Constate que la transformation en attente a été appliquée aux enfants. */
+    void decompterEnAttente() const {
+        if (!_enAttentePropre) return;
+        _enAttentePropre = false;
+        if (!enAttenteDessous()) signalerAJour(_parent);
+    }
+
+    /**
+     * @brief Aire, périmètre et boîte mémorisés du sous-arbre.
+     * * Suivis à travers les transformations du groupe, invalidés par toute modification d'un descendant.
+     */
+    mutable CacheMetriques _cache;
+
+    /** @brief Nombre de formes simples du sous-arbre, tenu à jour par ajouter(). */
+    size_t _nbFeuilles = 0;
+
+    /** @brief Nombre d'instances du sous-arbre, tenu à jour comme _nbFeuilles. */
+    size_t _nbInstances = 0;
+
+    /** @brief Vrai si le sous-arbre est assez grand pour être réparti sur @p pool. */
+    bool enParallele(PoolThreads* pool) const { return pool && _nbFeuilles >= SEUIL_PARALLELE; }
+
+    /** @brief Exécute tache(i) pour chaque enfant i, réparti sur @p pool. */
+    void pourChaqueEnfant(PoolThreads* pool, const function<void(size_t)>& tache) const;
+
+    void appliquerEnAttente() const override { appliquerEnAttente(nullptr); }
+
+    /**
+     * @brief Applique la transformation en attente aux enfants directs, répartis sur @p pool s'il y a lieu.
+     * @details Les enfants qui sont eux-mêmes des groupes ne font que la composer
+     * dans leur propre matrice en attente.
+     */
+    void appliquerEnAttente(PoolThreads* pool) const {
+        if (!_enAttente.estIdentite()) {
+            if (enParallele(pool)) pourChaqueEnfant(pool, [this](size_t i) { _formes[i]->transformer(_enAttente); });
+            else for (Forme* f : _formes) f->transformer(_enAttente);
+            _enAttente = Transformation2D();
+        }
+        // Après les enfants : ceux qui sont des groupes se sont déjà signalés à leur tour.
+        decompterEnAttente();
+    }
+
+    bool enAttenteDessous() const override {
+        return _enAttentePropre || _enfantsEnAttente.load(std::memory_order_relaxed) != 0;
+    }
+
+protected:
+    /** @brief Compose la transformation d'un groupe parent avec celles déjà en attente. */
+    void transformer(const Transformation2D& m) override {
+        PPIL_COMPTER(GROUPE, TRANSFORMATION);
+        composerEnAttente(m);
+        _cache.transformer(m);
+    }
+
+    /** @brief Un descendant a changé : les métriques du sous-arbre sont à recalculer. */
+    void invaliderCache() override { _cache.invalider(); }
+
+    double aireRepartie(PoolThreads* pool) const override {
+        PPIL_COMPTER(GROUPE, AIRE);
+        synchroniser();
+        if (_cache.aireValide) return _cache.aire;
+        appliquerEnAttente(pool);
+        double total = 0;
+        if (enParallele(pool)) {
+            vector<double> aires(_formes.size());
+            pourChaqueEnfant(pool, [&](size_t i) { aires[i] = _formes[i]->aireRepartie(pool); });
+            for (double a : aires) total += a; // Même ordre de sommation qu'en séquentiel.
+        }
+        else {
+            for (const Forme* f : _formes) total += f->aireRepartie(pool);
+        }
+        _cache.aire = total;
+        _cache.aireValide = true;
+        return total;
+    }
+
+    double perimetreReparti(PoolThreads* pool) const override {
+        synchroniser();
+        if (_cache.perimetreValide) return _cache.perimetre;
+        appliquerEnAttente(pool);
+        double total = 0;
+        if (enParallele(pool)) {
+            vector<double> perimetres(_formes.size());
+            pourChaqueEnfant(pool, [&](size_t i) { perimetres[i] = _formes[i]->perimetreReparti(pool); });
+            for (double p : perimetres) total += p;
+        }
+        else {
+            for (const Forme* f : _formes) total += f->perimetreReparti(pool);
+        }
+        _cache.perimetre = total;
+        _cache.perimetreValide = true;
+        return total;
+    }
+
+    Boite2D boiteRepartie(PoolThreads* pool) const override {
+        synchroniser();
+        if (_cache.boiteValide) return _cache.boite;
+        appliquerEnAttente(pool);
+        Boite2D b;
+        if (enParallele(pool)) {
+            vector<Boite2D> boites(_formes.size());
+            pourChaqueEnfant(pool, [&](size_t i) { boites[i] = _formes[i]->boiteRepartie(pool); });
+            for (const Boite2D& boite : boites) b.etendre(boite);
+        }
+        else {
+            for (const Forme* f : _formes) b.etendre(f->boiteRepartie(pool));
+        }
+        _cache.boite = b;
+        _cache.boiteValide = true;
+        return b;
+    }
+
 public:
+    /** @brief Taille de sous-arbre, en formes simples, à partir de laquelle un calcul est réparti. */
+    static constexpr size_t SEUIL_PARALLELE = 16384;
+
+    /** @brief Nombre de formes simples du sous-arbre. */
+    size_t nbFeuilles() const override { return _nbFeuilles; }
+
+    /** @brief Nombre d'instances du sous-arbre. */
+    size_t nbInstances() const override { return _nbInstances; }
+
     /**
      * @brief Constructeur de Groupe.
      * @param couleur La couleur appliquée aux pièces constituant le groupe lors du dessin.
@@ -49,7 +230,45 @@ public:
      * @param f Pointeur vers la forme à ajouter.
      */
     void ajouter(Forme* f) {
-        if (f) _formes.push_back(f);
+        synchroniser();
+        if (!f) return;
+        appliquerEnAttente(); // Les transformations passées ne concernent pas la nouvelle forme.
+        _formes.push_back(f);
+        f->_parent = this;
+        if (f->enAttenteDessous()) signalerEnAttente(this);
+        const size_t feuilles = f->nbFeuilles(), instances = f->nbInstances();
+        for (Forme* g = this; g; g = g->_parent) {
+            static_cast<Groupe*>(g)->_nbFeuilles += feuilles;
+            static_cast<Groupe*>(g)->_nbInstances += instances;
+        }
+        _cache.invalider();
+        f->marquerModifiee(); // Nouveau contexte (couleur, ancêtres) : la forme compte comme modifiée.
+    }
+
+    /**
+     * @brief Retire une forme du groupe sans la détruire.
+     * @param f Forme directement contenue dans le groupe.
+     * @return @p f, désormais sans parent et à la charge de l'appelant, ou nullptr si elle
+     * n'appartient pas au groupe.
+     */
+    Forme* retirer(Forme* f) {
+        synchroniser();
+        auto it = std::find(_formes.begin(), _formes.end(), f);
+        if (it == _formes.end()) return nullptr;
+        appliquerEnAttente(); // La forme emporte les transformations déjà subies par le groupe.
+        _formes.erase(it);
+        f->_parent = nullptr;
+        if (f->enAttenteDessous()) signalerAJour(this);
+        const size_t feuilles = f->nbFeuilles(), instances = f->nbInstances();
+        for (Forme* g = this; g; g = g->_parent) {
+            static_cast<Groupe*>(g)->_nbFeuilles -= feuilles;
+            static_cast<Groupe*>(g)->_nbInstances -= instances;
+        }
+        _cache.invalider();
+        _versionSousArbre = nouvelleVersion();
+        notifierParents();
+        f->marquerModifiee();
+        return f;
     }
 
     /**
@@ -57,7 +276,11 @@ public:
      * @param v Vecteur de translation.
      */
     void translation(const Vecteur2D& v) override {
-        for (Forme* f : _formes) f->translation(v);
+        PPIL_COMPTER(GROUPE, TRANSFORMATION);
+        synchroniser();
+        composerEnAttente(Transformation2D::translation(v));
+        _cache.translater(v);
+        marquerModifiee();
     }
 
     /**
@@ -66,7 +289,11 @@ public:
      * @param rapport Facteur de zoom.
      */
     void homothetie(const Vecteur2D& centre, double rapport) override {
-        for (Forme* f : _formes) f->homothetie(centre, rapport);
+        PPIL_COMPTER(GROUPE, TRANSFORMATION);
+        synchroniser();
+        composerEnAttente(Transformation2D::homothetie(centre, rapport));
+        _cache.homothetie(centre, rapport);
+        marquerModifiee();
     }
 
     /**
@@ -75,42 +302,76 @@ public:
      * @param angle Angle signé en radians.
      */
     void rotation(const Vecteur2D& centre, double angle) override {
-        for (Forme* f : _formes) f->rotation(centre, angle);
+        PPIL_COMPTER(GROUPE, TRANSFORMATION);
+        synchroniser();
+        composerEnAttente(Transformation2D::rotation(centre, angle));
+        _cache.tourner();
+        marquerModifiee();
     }
 
     /**
      * @brief Calcule l'aire totale du groupe.
      * * L'aire d'un groupe est la somme des aires des formes qui le composent.
+     * Le résultat est mémorisé : une nouvelle requête sur une scène inchangée coûte O(1).
      * @return L'aire cumulée des formes disjointes.
      */
-    double calculerAire() const override {
-        double total = 0;
-        for (const Forme* f : _formes) total += f->calculerAire();
-        return total;
-    }
+    double calculerAire() const override { return aireRepartie(nullptr); }
+
+    /**
+     * @brief Aire totale, calculée sur la réserve de threads @p pool (nullptr : séquentiel).
+     * @details Même résultat et même mémorisation que calculerAire() ; la réserve ne sert que
+     * le temps de l'appel.
+     * @warning La scène ne doit pas être modifiée pendant le calcul.
+     */
+    double calculerAire(PoolThreads* pool) const { return aireRepartie(pool); }
+
+    /**
+     * @brief Aire réellement couverte par les formes du groupe, zones de chevauchement comptées une fois.
+     * @details Calcul exact (voir AireUnion), cercles compris. Réparti sur @p pool s'il est fourni,
+     * quelle que soit la taille du groupe : le calcul est bien plus coûteux que calculerAire,
+     * même pour quelques milliers de formes. Non mémorisé.
+     */
+    double calculerAireUnion(PoolThreads* pool = nullptr) const;
+
+    /** @brief Somme des périmètres des formes du groupe (mémorisée). */
+    double calculerPerimetre() const override { return perimetreReparti(nullptr); }
+
+    /** @brief Somme des périmètres, calculée sur @p pool (voir calculerAire(PoolThreads*)). */
+    double calculerPerimetre(PoolThreads* pool) const { return perimetreReparti(pool); }
+
+    /** @brief Union des boîtes des formes du groupe (mémorisée). */
+    Boite2D calculerBoite() const override { return boiteRepartie(nullptr); }
+
+    /** @brief Union des boîtes, calculée sur @p pool (voir calculerAire(PoolThreads*)). */
+    Boite2D calculerBoite(PoolThreads* pool) const { return boiteRepartie(pool); }
 
     /**
      * @brief Mise en œuvre du Design Pattern Visitor pour le dessin ou la sauvegarde.
      * @param v Pointeur vers le visiteur (ex: TCP/IP ou Fichier).
      */
     void accepte(VisiteurForme* v) const override {
+        PPIL_COMPTER(GROUPE, VISITE);
+        PPIL_CHRONO("visite Groupe");
+        synchroniser();
         v->visite(*this);
     }
 
     /**
      * @brief Accesseur pour la liste des formes (utile pour l'exportation via Visiteur).
+     * @details Applique d'abord les transformations en attente aux enfants directs.
      */
-    const vector<Forme*>& getFormes() const { return _formes; }
+    const vector<Forme*>& getFormes() const {
+        synchroniser();
+        appliquerEnAttente();
+        return _formes;
+    }
 
     /**
      * @brief Opérateur de conversion en string pour l'affichage console.
      * @return Une chaîne représentant la structure du groupe.
      */
     operator string() const override {
-        string s = "Groupe " + _couleur + " { ";
-        for (const auto& f : _formes) s += (string)(*f) + " ; ";
-        s += "}";
-        return s;
+        return FormatTexte::description(*this);
     }
 };
 
@@ -0,0 +1,90 @@
+/**
+ * @file HierarchieBoites.h
+ * @brief Hiérarchie de boîtes englobantes (BVH) pour les requêtes spatiales sur une scène.
+ */
+
+#ifndef HIERARCHIE_BOITES_H
+#define HIERARCHIE_BOITES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Forme.h"
+#include "Boite2D.h"
+
+ /**
+  * @class HierarchieBoites
+  * @brief Arbre binaire de boîtes alignées sur les axes, construit sur les formes simples d'une scène.
+  * * Les groupes sont aplatis : seules les formes simples (Cercle, Segment, Polygone) sont indexées,
+  * ainsi que les instances, chacune d'un bloc (une requête qui la touche renvoie l'instance).
+  * L'arbre est stocké dans un tableau (un parent précède toujours ses enfants), construit par
+  * coupure médiane selon l'axe le plus long. Les requêtes ne descendent que dans les nœuds dont
+  * la boîte est concernée, soit un coût logarithmique pour une scène bien répartie.
+  *
+  * Les formes ne sont pas copiées : la hiérarchie référence celles de la scène, qui doit donc
+  * lui survivre. Après des transformations, reajuster() recalcule les boîtes sans reconstruire
+  * l'arbre ; après un ajout ou une suppression de forme, il faut appeler construire().
+  */
+class HierarchieBoites {
+private:
+    /**
+     * @brief Nœud de l'arbre.
+     * * Feuille (nb > 0) : formes _ordre[premier, premier + nb).
+     * Nœud interne (nb == 0) : enfants premier et premier + 1.
+     */
+    struct Noeud {
+        Boite2D boite;
+        std::uint32_t premier;
+        std::uint32_t nb;
+    };
+
+    std::vector<const Forme*> _formes;  ///< Formes simples indexées.
+    std::vector<Boite2D> _boites;       ///< Boîte de chaque forme (même indice que _formes).
+    std::vector<std::uint32_t> _ordre;  ///< Indices des formes, regroupés par feuille.
+    std::vector<Noeud> _noeuds;         ///< Nœuds de l'arbre, racine en tête.
+
+    /** @brief Nombre maximal de formes par feuille. */
+    static constexpr std::uint32_t FORMES_PAR_FEUILLE = 4;
+
+public:
+    /** @brief Crée une hiérarchie vide. */
+    HierarchieBoites() = default;
+
+    /** @brief Crée la hiérarchie des formes simples contenues dans @p racine. */
+    explicit HierarchieBoites(const Forme& racine) { construire(racine); }
+
+    /** @brief (Re)construit l'arbre à partir de la scène @p racine. */
+    void construire(const Forme& racine);
+
+    /**
+     * @brief Met à jour les boîtes après des transformations, sans modifier la structure.
+     * @details Coût linéaire ; l'arbre reste valide mais peut devenir moins efficace si les
+     * formes se sont beaucoup déplacées les unes par rapport aux autres.
+     */
+    void reajuster();
+
+    /** @brief Nombre de formes simples indexées. */
+    std::size_t taille() const { return _formes.size(); }
+
+    /** @brief Boîte englobant toute la scène (vide si la scène l'est). */
+    Boite2D boite() const { return _noeuds.empty() ? Boite2D() : _noeuds.front().boite; }
+
+    /**
+     * @brief Formes touchées par un clic en @p p.
+     * @param tolerance Distance maximale acceptée ; indispensable pour toucher un segment.
+     * @details Un cercle ou un polygone est plein : un point intérieur le touche
+     * (nombre d'enroulement non nul pour un polygone).
+     */
+    std::vector<const Forme*> formesAuPoint(const Vecteur2D& p, double tolerance = 0) const;
+
+    /** @brief Formes ayant au moins un point dans le rectangle @p zone. */
+    std::vector<const Forme*> formesDansRectangle(const Boite2D& zone) const;
+
+    /**
+     * @brief Forme la plus proche de @p p (nullptr si la hiérarchie est vide).
+     * @param distance Si non nul, reçoit la distance à cette forme (0 si p est à l'intérieur).
+     */
+    const Forme* plusProche(const Vecteur2D& p, double* distance = nullptr) const;
+};
+
+#endif
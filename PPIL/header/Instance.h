@@ -0,0 +1,133 @@
+/**
+ * @file Instance.h
+ * @brief Occurrence d'un groupe partagé (symbole répété), copié seulement à la modification.
+ */
+
+#ifndef INSTANCE_H
+#define INSTANCE_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "Forme.h"
+
+class Groupe;
+
+/**
+ * @class Instance
+ * @brief Groupe prototype partagé, vu à travers une similitude propre à l'instance.
+ * * Une scène qui répète le même symbole (arbre, bâtiment...) des milliers de fois ne garde
+ * qu'un exemplaire de sa géométrie : chaque instance ne contient qu'un pointeur partagé vers
+ * le prototype, sa transformation et sa couleur. La mémoire ne croît plus qu'avec la
+ * géométrie distincte.
+ *
+ * Le prototype est immuable tant qu'il est partagé. Les transformations de l'instance ne
+ * touchent que sa matrice ; modifier() donne accès au contenu, après en avoir fait une copie
+ * propre à l'instance si d'autres le partagent (copie sur écriture).
+ *
+ * Aire et périmètre se déduisent de ceux du prototype (mémorisés par lui) et du facteur
+ * d'échelle. Les visiteurs reçoivent l'instance par VisiteurForme::visite(const Instance&) :
+ * par défaut, ils parcourent le prototype partagé lui-même, sans le copier, et placent ses
+ * formes par la transformation de l'instance (VisiteurForme::placer) ; la sauvegarde binaire,
+ * elle, n'écrit chaque prototype qu'une fois.
+ *
+ * Plusieurs instances peuvent être lues en parallèle (Groupe::calculerAire(PoolThreads*)) : les
+ * métriques du prototype sont calculées dès qu'il est partagé, si bien qu'il n'est plus
+ * ensuite que lu.
+ */
+class Instance : public Forme {
+private:
+    std::shared_ptr<const Groupe> _prototype;  ///< Groupe partagé, sans parent.
+    Transformation2D _transformation;          ///< Similitude appliquée au prototype.
+    mutable Boite2D _boite;                    ///< Boîte exacte mémorisée (transformation avec rotation).
+    mutable bool _boiteValide = false;
+    mutable std::uint64_t _versionPrototype = 0; ///< Date du prototype lors du calcul de _boite.
+
+    friend class JournalTransformations; ///< Restaure la géométrie d'une copie.
+
+    /** @brief Calcule et mémorise les métriques du prototype, qui ne sera plus ensuite que lu. */
+    void preparer() const;
+
+protected:
+    /** @brief Compose la transformation d'un groupe parent avec celle de l'instance. */
+    void transformer(const Transformation2D& m) override;
+
+public:
+    /**
+     * @brief Nouvelle instance de @p prototype.
+     * @param prototype Groupe partagé ; il ne doit appartenir à aucun groupe.
+     * @param transformation Similitude (composition de translations, d'homothéties et de rotations).
+     * @param couleur Couleur de l'instance, appliquée à ses formes comme celle d'un groupe.
+     * @throw std::invalid_argument Si le prototype est nul ou appartient à un groupe.
+     */
+    Instance(std::shared_ptr<const Groupe> prototype,
+             const Transformation2D& transformation = Transformation2D(),
+             const std::string& couleur = Forme::BLACK);
+
+    /**
+     * @brief Fait de @p g un prototype partageable.
+     * @details Raccourci pour std::shared_ptr<const Groupe>(g) : le prototype devient la
+     * propriété des instances, détruit avec la dernière d'entre elles.
+     */
+    static std::shared_ptr<const Groupe> partager(Groupe* g);
+
+    /** @brief Prototype, en lecture seule. */
+    const Groupe& getPrototype() const { return *_prototype; }
+
+    /** @brief Pointeur partagé vers le prototype, pour créer d'autres instances. */
+    const std::shared_ptr<const Groupe>& getPartage() const { return _prototype; }
+
+    /** @brief Transformation de l'instance. */
+    const Transformation2D& getTransformation() const { synchroniser(); return _transformation; }
+
+    /** @brief Vrai si d'autres instances (ou l'appelant) partagent le prototype. */
+    bool estPartagee() const { return _prototype.use_count() > 1; }
+
+    /**
+     * @brief Contenu modifiable de l'instance, dans le repère du prototype.
+     * @details Si le prototype est partagé, il est d'abord copié (les instances imbriquées
+     * restent partagées) et l'instance prend la copie : les autres instances ne voient pas
+     * la modification. La référence n'est valable que jusqu'à la prochaine lecture ou copie.
+     */
+    Groupe& modifier();
+
+    /**
+     * @brief Groupe indépendant équivalent : copie du prototype, couleur et transformation de l'instance.
+     * @details Copie complète, pour qui veut détacher l'instance de son prototype ; l'appelant
+     * en est propriétaire. Les visiteurs n'en ont pas besoin (VisiteurForme::visiterPrototype).
+     */
+    std::unique_ptr<Groupe> developper() const;
+
+    /** @brief Nombre de formes simples du prototype. */
+    std::size_t nbFeuilles() const override;
+
+    /** @brief Une instance (celles de son prototype ne comptent pas). */
+    std::size_t nbInstances() const override { return 1; }
+
+    /** @name Transformations (composées dans la matrice de l'instance, sans copie) @{ */
+    void translation(const Vecteur2D& v) override;
+    void homothetie(const Vecteur2D& centre, double rapport) override;
+    void rotation(const Vecteur2D& centre, double angle) override;
+    /** @} */
+
+    /** @brief Aire du prototype multipliée par le carré du facteur d'échelle. */
+    double calculerAire() const override;
+
+    /** @brief Périmètre du prototype multiplié par le facteur d'échelle. */
+    double calculerPerimetre() const override;
+
+    /**
+     * @brief Boîte englobante exacte.
+     * @details Déduite de celle du prototype sans rotation ; sinon calculée en plaçant une à une
+     * les formes du prototype, et mémorisée jusqu'à la prochaine transformation ou modification.
+     */
+    Boite2D calculerBoite() const override;
+
+    /** @brief Pattern Visitor : VisiteurForme::visite(const Instance&). */
+    void accepte(VisiteurForme* v) const override;
+
+    /** @brief Description du groupe équivalent (prototype placé, couleur de l'instance). */
+    operator std::string() const override;
+};
+
+#endif
@@ -0,0 +1,123 @@
+/**
+ * @file Instrumentation.h
+ * @brief Compteurs et chronomètres des chemins critiques, supprimés à la compilation par défaut.
+ */
+
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+ /**
+  * @brief Instrumentation des visites, transformations, calculs d'aire, chargements et envois.
+  * @details Compilée seulement avec la définition PPIL_INSTRUMENTATION (option CMake du même
+  * nom) ; sinon les macros PPIL_COMPTER et PPIL_CHRONO ne produisent aucun code.
+  *
+  * Chaque thread écrit dans son propre registre (compteurs et durées cumulées par site,
+  * événements de trace), sans verrou sur le chemin critique : la trace est une suite de
+  * morceaux fixes dont le nombre d'événements publiés est atomique. Les registres de tous
+  * les threads, terminés compris, sont fusionnés à l'écriture du résumé ou de la trace, ce
+  * qui peut se faire pendant que les threads mesurent.
+  */
+namespace Instrumentation {
+
+    /** @brief Vrai si l'instrumentation est compilée. */
+#ifdef PPIL_INSTRUMENTATION
+    constexpr bool ACTIVE = true;
+#else
+    constexpr bool ACTIVE = false;
+#endif
+
+    enum TypeForme : std::uint8_t { CERCLE, SEGMENT, POLYGONE, GROUPE, NB_TYPES };
+    enum Evenement : std::uint8_t { VISITE, TRANSFORMATION, AIRE, NB_EVENEMENTS };
+
+    /** @brief Sites de chronométrage distincts au maximum. */
+    const std::size_t MAX_SITES = 256;
+
+    /**
+     * @brief Événements de trace conservés par thread sur toute sa vie ; les suivants ne sont que comptés.
+     * @details reinitialiser() ne rend pas leur place : elle ne pourrait pas être réécrite sans verrou
+     * pendant qu'une trace est lue.
+     */
+    const std::size_t MAX_EVENEMENTS_TRACE = 1 << 20;
+
+    /** @brief Total d'un compteur, tous threads confondus. */
+    std::uint64_t compteur(TypeForme type, Evenement evenement);
+
+    /** @brief Écrit le tableau des compteurs et des chronomètres. */
+    void ecrireResume(std::ostream& sortie);
+
+    /**
+     * @brief Écrit les événements chronométrés au format Chrome trace-event (JSON).
+     * @return false si le fichier ne peut pas être écrit (ou si l'instrumentation n'est pas compilée).
+     */
+    bool ecrireTrace(const std::string& nomFichier);
+
+    /**
+     * @brief Remet compteurs, durées et traces à zéro pour les lectures suivantes.
+     * @details Utilisable pendant que d'autres threads mesurent : rien n'est effacé, l'état de
+     * chaque registre est noté et soustrait ensuite ; aucun incrément n'est perdu.
+     */
+    void reinitialiser();
+
+#ifdef PPIL_INSTRUMENTATION
+    /** @brief Compteurs d'un thread : seul ce thread écrit, les autres ne font que lire. */
+    struct Compteurs {
+        std::atomic<std::uint64_t> valeurs[NB_TYPES][NB_EVENEMENTS] = {};
+    };
+
+    /** @brief Compteurs du thread appelant (nullptr avant son premier événement). */
+    inline thread_local Compteurs* compteursCourants = nullptr;
+
+    /** @brief Inscrit le registre du thread appelant et renvoie ses compteurs. */
+    Compteurs& creerCompteurs();
+
+    /** @brief Incrément sans opération atomique lecture-écriture : le thread est le seul écrivain. */
+    inline void compter(TypeForme type, Evenement evenement) {
+        Compteurs* c = compteursCourants;
+        if (!c) c = &creerCompteurs();
+        std::atomic<std::uint64_t>& v = c->valeurs[type][evenement];
+        v.store(v.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    /** @brief Site de chronométrage, enregistré une fois (variable statique de la macro). */
+    struct Site {
+        const char* nom;
+        std::uint32_t indice;
+        explicit Site(const char* nom);
+    };
+
+    /** @brief Chronomètre la portée qui le contient. */
+    class Chrono {
+    private:
+        const Site& _site;
+        std::int64_t _debut;
+
+    public:
+        explicit Chrono(const Site& site);
+        ~Chrono();
+        Chrono(const Chrono&) = delete;
+        Chrono& operator=(const Chrono&) = delete;
+    };
+#endif
+}
+
+#ifdef PPIL_INSTRUMENTATION
+#define PPIL_CONCATENER_(a, b) a##b
+#define PPIL_CONCATENER(a, b) PPIL_CONCATENER_(a, b)
+/** @brief Compte un événement pour un type de forme : PPIL_COMPTER(CERCLE, VISITE). */
+#define PPIL_COMPTER(type, evenement) ::Instrumentation::compter(::Instrumentation::type, ::Instrumentation::evenement)
+/** @brief Chronomètre la fin de la portée courante sous le nom @p nom (littéral). */
+#define PPIL_CHRONO(nom)                                                                        \
+    static const ::Instrumentation::Site PPIL_CONCATENER(ppilSite, __LINE__)(nom);              \
+    const ::Instrumentation::Chrono PPIL_CONCATENER(ppilChrono, __LINE__)(PPIL_CONCATENER(ppilSite, __LINE__))
+#else
+#define PPIL_COMPTER(type, evenement) ((void)0)
+#define PPIL_CHRONO(nom) ((void)0)
+#endif
+
+#endif
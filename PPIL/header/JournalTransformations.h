@@ -0,0 +1,184 @@
+/**
+ * @file JournalTransformations.h
+ * @brief Journal des transformations d'une scène, annulables et rétablissables.
+ */
+
+#ifndef JOURNAL_TRANSFORMATIONS_H
+#define JOURNAL_TRANSFORMATIONS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+#include "vecteur2D.h"
+#include "SceneValeur.h"
+
+class Forme;
+class Groupe;
+
+/**
+ * @class JournalTransformations
+ * @brief Annuler / rétablir les translations, homothéties et rotations sans copier la scène.
+ * * Chaque modification est passée au journal, qui l'applique et la note : nature, paramètres
+ * et chemin de la forme visée depuis la racine (indices successifs dans les groupes). Une entrée
+ * occupe quelques dizaines d'octets, quelle que soit la taille de la forme visée.
+ *
+ * Annuler applique la transformation inverse (translation opposée, rapport inverse, angle
+ * opposé) ; rétablir rejoue la transformation. Les transformations sans inverse — rapport
+ * nul ou dont l'inverse n'est pas un double normal, paramètres non finis — gardent en plus
+ * une copie par valeur (SceneValeur) de la forme visée avant modification, restaurée à
+ * l'annulation.
+ *
+ * Une transformation inverse n'est exacte qu'aux arrondis près. Le journal prend donc des
+ * points de reprise : une copie par valeur de toute la scène, après au moins
+ * @p intervalleCheckpoint modifications touchant en tout au moins autant de formes simples
+ * que la scène en contient (la copie ne coûte ainsi pas plus que les modifications qui la
+ * précèdent). Une annulation ou un rétablissement qui aboutit à une position de reprise
+ * restaure cette copie au bit près, ce qui borne la dérive ; revenirA() part du point de
+ * reprise le plus proche lorsqu'il y a moins d'entrées à rejouer. Seuls les
+ * @p nbCheckpointsMax derniers points de reprise sont gardés : la mémoire est O(nombre de
+ * modifications) plus une taille de scène par point de reprise, au lieu d'une copie de la
+ * scène par modification.
+ *
+ * Une instance est une feuille pour le journal. Restaurer une copie la laisse intacte si son
+ * développement n'a pas changé ; sinon l'instance reçoit un prototype à elle, construit
+ * d'après la copie.
+ *
+ * Les chemins supposent une structure fixe : après un ajout ou un retrait de forme sous la
+ * racine, il faut vider() le journal. Un chemin devenu invalide lève std::out_of_range, une
+ * structure qui ne correspond plus à une copie restaurée lève std::logic_error.
+ */
+class JournalTransformations {
+public:
+    /** @brief Nature d'une modification. */
+    enum TypeTransformation : std::uint8_t { TRANSLATION, HOMOTHETIE, ROTATION };
+
+    /** @brief Indices successifs, depuis la racine, menant à une forme (vide : la racine). */
+    using Chemin = std::vector<std::uint32_t>;
+
+    /** @brief Intervalle par défaut entre deux points de reprise, en modifications. */
+    static constexpr std::size_t INTERVALLE_CHECKPOINT = 1024;
+
+    /** @brief Nombre par défaut de points de reprise conservés. */
+    static constexpr std::size_t NB_CHECKPOINTS_MAX = 2;
+
+private:
+    /** @brief Modification notée. */
+    struct Entree {
+        double x, y;                 ///< Vecteur de translation, ou centre.
+        double parametre;            ///< Rapport ou angle (inutilisé pour une translation).
+        std::uint32_t debutChemin;   ///< Position du chemin dans _chemins.
+        std::uint32_t longueurChemin;
+        std::int32_t instantane;     ///< Indice de la copie de la forme avant modification, ou -1.
+        TypeTransformation type;
+    };
+
+    /** @brief Copie de toute la scène à une position du journal. */
+    struct Checkpoint {
+        std::size_t position;
+        FormeValeur scene;
+    };
+
+    Groupe& _racine;
+    std::vector<Entree> _entrees;
+    std::vector<std::uint32_t> _chemins;      ///< Chemins de toutes les entrées, à la suite.
+    std::vector<FormeValeur> _instantanes;    ///< Copies des formes visées par les transformations non inversibles.
+    std::deque<Checkpoint> _checkpoints;      ///< Par position croissante.
+    std::size_t _position = 0;                ///< Nombre de modifications appliquées.
+    std::size_t _travail = 0;                 ///< Formes simples touchées depuis le dernier point de reprise.
+    std::size_t _intervalleCheckpoint;
+    std::size_t _nbCheckpointsMax;
+
+    /** @brief Forme désignée par un chemin. @throw std::out_of_range Si le chemin ne mène à rien. */
+    Forme& resoudre(const std::uint32_t* chemin, std::size_t longueur) const;
+
+    /** @brief Applique l'entrée (sens direct) ou son inverse à la forme @p f. */
+    static void appliquer(Forme& f, const Entree& e, bool inverse);
+
+    /** @brief Vrai si l'inverse de l'entrée restitue la forme visée aux arrondis près. */
+    static bool estInversible(const Entree& e);
+
+    /**
+     * @brief Réécrit la géométrie de @p f (et de ses descendants) d'après la copie @p v.
+     * @throw std::logic_error Si la structure ne correspond pas.
+     */
+    static void restaurer(Forme& f, const FormeValeur& v);
+
+    /** @brief Point de reprise exactement à @p position, ou nullptr. */
+    const Checkpoint* checkpointA(std::size_t position) const;
+
+    /** @brief Oublie les entrées, copies et points de reprise situés après la position courante. */
+    void tronquer();
+
+    /** @brief Note et applique une modification. */
+    void noter(Forme& cible, const Chemin& chemin, TypeTransformation type, const Vecteur2D& p, double parametre);
+
+public:
+    /**
+     * @param racine Groupe racine de la scène suivie (Scene::racine(), par exemple) ; il doit
+     * survivre au journal.
+     * @param intervalleCheckpoint Modifications au moins entre deux points de reprise (0 : aucun).
+     * @param nbCheckpointsMax Points de reprise conservés au plus.
+     */
+    explicit JournalTransformations(Groupe& racine,
+                                    std::size_t intervalleCheckpoint = INTERVALLE_CHECKPOINT,
+                                    std::size_t nbCheckpointsMax = NB_CHECKPOINTS_MAX);
+
+    JournalTransformations(const JournalTransformations&) = delete;
+    JournalTransformations& operator=(const JournalTransformations&) = delete;
+
+    /**
+     * @brief Chemin de @p f depuis la racine.
+     * @throw std::invalid_argument Si @p f n'appartient pas à la scène.
+     */
+    Chemin chemin(const Forme& f) const;
+
+    /** @brief Forme désignée par @p chemin. @throw std::out_of_range Si le chemin ne mène à rien. */
+    Forme& resoudre(const Chemin& chemin) const { return resoudre(chemin.data(), chemin.size()); }
+
+    /**
+     * @name Modifications notées
+     * Mêmes conventions que Forme ; les modifications annulées et pas rétablies sont oubliées.
+     * @{
+     */
+    void translation(Forme& cible, const Vecteur2D& v);
+    void homothetie(Forme& cible, const Vecteur2D& centre, double rapport);
+    void rotation(Forme& cible, const Vecteur2D& centre, double angle);
+
+    void translation(const Chemin& cible, const Vecteur2D& v);
+    void homothetie(const Chemin& cible, const Vecteur2D& centre, double rapport);
+    void rotation(const Chemin& cible, const Vecteur2D& centre, double angle);
+    /** @} */
+
+    /** @brief Annule la dernière modification appliquée. @return false s'il n'y en a pas. */
+    bool annuler();
+
+    /** @brief Rétablit la dernière modification annulée. @return false s'il n'y en a pas. */
+    bool retablir();
+
+    /**
+     * @brief Ramène la scène à l'état après les @p position premières modifications.
+     * @throw std::out_of_range Si @p position dépasse taille().
+     */
+    void revenirA(std::size_t position);
+
+    bool peutAnnuler() const { return _position > 0; }
+    bool peutRetablir() const { return _position < _entrees.size(); }
+
+    /** @brief Nombre de modifications appliquées (position dans le journal). */
+    std::size_t position() const { return _position; }
+
+    /** @brief Nombre de modifications notées, rétablissables comprises. */
+    std::size_t taille() const { return _entrees.size(); }
+
+    /** @brief Nombre de points de reprise conservés. */
+    std::size_t nbCheckpoints() const { return _checkpoints.size(); }
+
+    /** @brief Nombre de copies de formes gardées pour des transformations non inversibles. */
+    std::size_t nbInstantanes() const { return _instantanes.size(); }
+
+    /** @brief Oublie tout l'historique ; la scène reste dans son état courant. */
+    void vider();
+};
+
+#endif
@@ -0,0 +1,73 @@
+/**
+ * @file LecteurFluxScene.h
+ * @brief Lecture en flux (façon SAX) des fichiers de sauvegarde, sans construire l'arbre.
+ */
+
+#ifndef LECTEUR_FLUX_SCENE_H
+#define LECTEUR_FLUX_SCENE_H
+
+#include <string>
+#include <cstddef>
+
+class Cercle;
+class Segment;
+class Polygone;
+
+/**
+ * @class VisiteurFlux
+ * @brief Interface de rappel du LecteurFluxScene, calquée sur VisiteurForme.
+ * * Les formes passées aux méthodes visite() sont temporaires : elles sont détruites
+ * dès le retour du rappel et ne doivent pas être conservées par adresse.
+ * Les groupes ne sont pas construits ; seules leurs bornes sont signalées.
+ */
+class VisiteurFlux {
+public:
+    virtual ~VisiteurFlux() {}
+    virtual void visite(const Cercle& cercle) = 0;
+    virtual void visite(const Segment& segment) = 0;
+    virtual void visite(const Polygone& polygone) = 0;
+
+    /** @brief Entrée dans un groupe (les formes suivantes lui appartiennent). */
+    virtual void debutGroupe([[maybe_unused]] const std::string& couleur) {}
+
+    /** @brief Sortie du groupe ouvert le plus récemment. */
+    virtual void finGroupe() {}
+};
+
+/**
+ * @class LecteurFluxScene
+ * @brief Parcourt un fichier de sauvegarde (texte ou binaire) en mémoire constante.
+ * * Le fichier est lu par blocs de taille fixe ; chaque forme n'existe que le temps
+ * de son rappel. La mémoire utilisée est bornée par la taille du bloc et par la plus
+ * grande forme du fichier, quelle que soit la taille de celui-ci, plus les prototypes
+ * des instances d'un fichier binaire : chaque instance est signalée comme un groupe dont
+ * les formes, lues dans son prototype gardé en mémoire, sont placées une à une.
+ */
+class LecteurFluxScene {
+public:
+    /** @brief Taille par défaut du bloc de lecture (1 Mio). */
+    static const std::size_t TAILLE_BLOC_DEFAUT = std::size_t(1) << 20;
+
+    /**
+     * @brief Parcourt un fichier au format texte (VisiteurSauvegardeTexte).
+     * @throw std::runtime_error Si le fichier est illisible, mal imbriqué ou contient une ligne non reconnue.
+     */
+    static void lireTexte(const std::string& nomFichier, VisiteurFlux& visiteur,
+                          std::size_t tailleBloc = TAILLE_BLOC_DEFAUT);
+
+    /**
+     * @brief Parcourt un fichier au format binaire (VisiteurSauvegardeBinaire).
+     * @throw std::runtime_error Si le fichier est illisible, d'une version inconnue ou corrompu.
+     */
+    static void lireBinaire(const std::string& nomFichier, VisiteurFlux& visiteur,
+                            std::size_t tailleBloc = TAILLE_BLOC_DEFAUT);
+
+    /**
+     * @brief Parcourt un fichier en détectant son format d'après sa signature.
+     * @throw std::runtime_error Si le fichier est illisible ou invalide.
+     */
+    static void lire(const std::string& nomFichier, VisiteurFlux& visiteur,
+                     std::size_t tailleBloc = TAILLE_BLOC_DEFAUT);
+};
+
+#endif
@@ -0,0 +1,58 @@
+/**
+ * @file NoyauxPolygone.h
+ * @brief Aire, périmètre et centroïde des grands polygones : noyaux SIMD, sommation compensée, paquets parallèles.
+ */
+
+#ifndef NOYAUX_POLYGONE_H
+#define NOYAUX_POLYGONE_H
+
+#include <cstddef>
+#include "vecteur2D.h"
+
+class PoolThreads;
+
+ /**
+  * @brief Calculs sur une suite de sommets formant un contour fermé.
+  * @details En dessous de SEUIL_NOYAU sommets, une simple boucle (sans modulo, même ordre de
+  * sommation qu'auparavant). Au-delà :
+  * - les coordonnées sont recentrées sur le premier sommet, ce qui évite de soustraire des
+  *   produits énormes et presque égaux (coordonnées géographiques projetées, par exemple) ;
+  * - les termes sont cumulés sur quatre voies, chacune en sommation de Kahan ;
+  * - les sommets sont découpés en paquets de SOMMETS_PAR_PAQUET, cumulés dans l'ordre, et
+  *   répartis sur la réserve de threads passée en argument à partir de SEUIL_PARALLELE sommets.
+  *
+  * Le noyau AVX2 (choisi à l'exécution, comme pour FormeBatch) et le noyau scalaire répartissent
+  * les termes sur les mêmes voies, sans FMA : le résultat est identique au bit près quels que
+  * soient le jeu d'instructions et le nombre de threads.
+  */
+namespace NoyauxPolygone {
+
+    /** @brief Nombre de sommets à partir duquel les noyaux compensés sont utilisés. */
+    const std::size_t SEUIL_NOYAU = 32;
+
+    /** @brief Sommets par paquet (unité de répartition et de sommation). */
+    const std::size_t SOMMETS_PAR_PAQUET = std::size_t(1) << 16;
+
+    /** @brief Nombre de sommets à partir duquel les paquets sont répartis sur la réserve de threads. */
+    const std::size_t SEUIL_PARALLELE = std::size_t(1) << 18;
+
+    /**
+     * @brief Aire signée (positive si les sommets tournent dans le sens trigonométrique), 0 sous 3 sommets.
+     * @param pool Réserve sur laquelle répartir les paquets (nullptr : séquentiel).
+     */
+    double aireSignee(const Vecteur2D* sommets, std::size_t n, PoolThreads* pool = nullptr);
+
+    /** @brief Longueur du contour fermé. */
+    double perimetre(const Vecteur2D* sommets, std::size_t n, PoolThreads* pool = nullptr);
+
+    /**
+     * @brief Centre de gravité de la surface.
+     * @details Pour une aire nulle (polygone dégénéré), centre de la boîte englobante.
+     */
+    Vecteur2D centroide(const Vecteur2D* sommets, std::size_t n, PoolThreads* pool = nullptr);
+
+    /** @brief Jeu d'instructions des noyaux ("avx2" ou "scalaire"). */
+    const char* jeuInstructions();
+}
+
+#endif
@@ -0,0 +1,191 @@
+/**
+ * @file PetitVecteur.h
+ * @brief Tableau dynamique dont les N premiers éléments sont stockés dans l'objet lui-même.
+ */
+
+#ifndef PETIT_VECTEUR_H
+#define PETIT_VECTEUR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+ /**
+  * @class PetitVecteur
+  * @brief Séquence contiguë avec stockage interne de N éléments, débordant dans un std::vector.
+  * * Tant que la taille ne dépasse pas N, les éléments sont rangés dans l'objet : ni allocation,
+  * ni indirection. Au-delà, ils sont déplacés dans un std::vector, qui partage la place du
+  * stockage interne et peut aussi être repris tel quel (sans copie) depuis un std::vector.
+  * Réservé aux types trivialement copiables (copies par memcpy).
+  */
+template <class T, std::size_t N>
+class PetitVecteur {
+    static_assert(std::is_trivially_copyable_v<T>, "PetitVecteur : type trivialement copiable attendu");
+    static_assert(N > 0, "PetitVecteur : au moins un élément interne");
+
+private:
+    union {
+        alignas(T) unsigned char _interne[N * sizeof(T)]; ///< Stockage interne, non initialisé.
+        std::vector<T> _externe;                          ///< Stockage après débordement (actif si _deborde).
+    };
+    std::uint32_t _taille;     ///< Nombre d'éléments internes (mode interne seulement).
+    bool _deborde;             ///< Vrai si les éléments sont dans _externe.
+
+    T* interne() { return std::launder(reinterpret_cast<T*>(_interne)); }
+    const T* interne() const { return std::launder(reinterpret_cast<const T*>(_interne)); }
+
+    /** @brief Active _externe (mode interne supposé) en y reprenant @p v. */
+    void adopter(std::vector<T>&& v) {
+        new (&_externe) std::vector<T>(std::move(v));
+        _deborde = true;
+        _taille = 0;
+    }
+
+    /** @brief Passe en mode externe en prévoyant au moins @p capacite éléments. */
+    void deborder(std::size_t capacite) {
+        std::vector<T> externe;
+        externe.reserve(std::max(capacite, 2 * N));
+        externe.insert(externe.end(), interne(), interne() + _taille);
+        adopter(std::move(externe));
+    }
+
+    /** @brief Prend le contenu de @p o, qui reste vide. */
+    void voler(PetitVecteur& o) noexcept {
+        if (o._deborde) {
+            new (&_externe) std::vector<T>(std::move(o._externe));
+            o._externe.~vector();
+            _deborde = true;
+            _taille = 0;
+        }
+        else {
+            std::memcpy(_interne, o._interne, o._taille * sizeof(T));
+            _deborde = false;
+            _taille = o._taille;
+        }
+        o._deborde = false;
+        o._taille = 0;
+    }
+
+    /** @brief Libère le stockage externe éventuel et revient au mode interne vide. */
+    void reinitialiser() {
+        if (_deborde) _externe.~vector();
+        _deborde = false;
+        _taille = 0;
+    }
+
+public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+    using size_type = std::size_t;
+
+    /** @brief Nombre d'éléments stockés sans allocation. */
+    static constexpr std::size_t CAPACITE_INTERNE = N;
+
+    PetitVecteur() : _taille(0), _deborde(false) {}
+
+    PetitVecteur(const T* debut, const T* fin) : PetitVecteur() { assigner(debut, fin); }
+    PetitVecteur(std::initializer_list<T> l) : PetitVecteur(l.begin(), l.end()) {}
+    PetitVecteur(const std::vector<T>& v) : PetitVecteur(v.data(), v.data() + v.size()) {}
+
+    /** @brief Reprend le tampon de @p v s'il dépasse N éléments, le copie en interne sinon. */
+    PetitVecteur(std::vector<T>&& v) : PetitVecteur() {
+        if (v.size() > N) adopter(std::move(v));
+        else assigner(v.data(), v.data() + v.size());
+    }
+
+    PetitVecteur(const PetitVecteur& o) : PetitVecteur(o.begin(), o.end()) {}
+    PetitVecteur(PetitVecteur&& o) noexcept : PetitVecteur() { voler(o); }
+
+    ~PetitVecteur() { reinitialiser(); }
+
+    PetitVecteur& operator=(const PetitVecteur& o) {
+        if (this != &o) assigner(o.begin(), o.end());
+        return *this;
+    }
+
+    PetitVecteur& operator=(PetitVecteur&& o) noexcept {
+        if (this != &o) {
+            reinitialiser();
+            voler(o);
+        }
+        return *this;
+    }
+
+    /** @brief Remplace le contenu par la plage [debut, fin). */
+    void assigner(const T* debut, const T* fin) {
+        const std::size_t n = static_cast<std::size_t>(fin - debut);
+        if (_deborde) {
+            _externe.assign(debut, fin);
+        }
+        else if (n <= N) {
+            if (n) std::memcpy(_interne, debut, n * sizeof(T));
+            _taille = static_cast<std::uint32_t>(n);
+        }
+        else {
+            adopter(std::vector<T>(debut, fin));
+        }
+    }
+
+    std::size_t size() const { return _deborde ? _externe.size() : _taille; }
+    bool empty() const { return size() == 0; }
+
+    /** @brief Vrai tant que les éléments tiennent dans l'objet. */
+    bool estInterne() const { return !_deborde; }
+
+    T* data() { return _deborde ? _externe.data() : interne(); }
+    const T* data() const { return _deborde ? _externe.data() : interne(); }
+
+    iterator begin() { return data(); }
+    iterator end() { return data() + size(); }
+    const_iterator begin() const { return data(); }
+    const_iterator end() const { return data() + size(); }
+
+    T& operator[](std::size_t i) { return data()[i]; }
+    const T& operator[](std::size_t i) const { return data()[i]; }
+    T& front() { return data()[0]; }
+    const T& front() const { return data()[0]; }
+    T& back() { return data()[size() - 1]; }
+    const T& back() const { return data()[size() - 1]; }
+
+    void reserve(std::size_t capacite) {
+        if (_deborde) _externe.reserve(capacite);
+        else if (capacite > N) deborder(capacite);
+    }
+
+    void push_back(const T& valeur) {
+        if (_deborde) {
+            _externe.push_back(valeur);
+            return;
+        }
+        if (_taille == N) {
+            const T copie = valeur; // valeur peut désigner un élément interne.
+            deborder(N + 1);
+            _externe.push_back(copie);
+            return;
+        }
+        std::memcpy(_interne + _taille * sizeof(T), &valeur, sizeof(T));
+        ++_taille;
+    }
+
+    /** @brief Vide la séquence (la capacité externe éventuelle est conservée). */
+    void clear() {
+        if (_deborde) _externe.clear();
+        _taille = 0;
+    }
+
+    /** @brief Copie du contenu dans un std::vector. */
+    std::vector<T> versVecteur() const { return std::vector<T>(begin(), end()); }
+
+    friend bool operator==(const PetitVecteur& a, const PetitVecteur& b) {
+        return std::equal(a.begin(), a.end(), b.begin(), b.end());
+    }
+};
+
+#endif
@@ -8,17 +8,63 @@
 
 #include "Forme.h"
 #include "VisiteurForme.h"
+#include "Instrumentation.h"
+#include "PetitVecteur.h"
+#include "NoyauxPolygone.h"
 #include <vector>
 #include <cmath>
 
+/**
+ * @def POLYGONE_SOMMETS_INTERNES
+ * @brief Nombre de sommets stockés dans l'objet Polygone lui-même, sans allocation.
+ * @details Au-delà, les sommets sont placés sur le tas. Réglable à la compilation
+ * (option CMake du même nom).
+ */
+#ifndef POLYGONE_SOMMETS_INTERNES
+#define POLYGONE_SOMMETS_INTERNES 4
+#endif
+
  /**
   * @class Polygone
   * @brief Représente un polygone quelconque fermé.
   *  Gère une liste de sommets et implémente les algorithmes géométriques vectoriels.
   */
 class Polygone : public Forme {
+public:
+    /** @brief Stockage des sommets : triangles et quadrilatères ne coûtent aucune allocation. */
+    using Sommets = PetitVecteur<Vecteur2D, POLYGONE_SOMMETS_INTERNES>;
+
 protected:
-    std::vector<Vecteur2D> _sommets; ///< Liste dynamique des sommets du polygone.
+    Sommets _sommets;                ///< Sommets du polygone.
+    mutable CacheMetriques _cache;   ///< Aire, périmètre et boîte mémorisés.
+
+    friend class JournalTransformations; ///< Restaure la géométrie d'une copie.
+
+    /** * @brief Transformation composée appliquée à chaque sommet en un seul passage. */
+    void transformer(const Transformation2D& m) override {
+        PPIL_COMPTER(POLYGONE, TRANSFORMATION);
+        for (auto& s : _sommets) s = m.appliquer(s);
+        _cache.transformer(m);
+    }
+
+    /** @brief Aire mémorisée ; les paquets des très grands polygones sont répartis sur @p pool. */
+    double aireRepartie(PoolThreads* pool) const override {
+        PPIL_COMPTER(POLYGONE, AIRE);
+        synchroniser();
+        if (_cache.aireValide) return _cache.aire;
+        _cache.aire = std::abs(NoyauxPolygone::aireSignee(_sommets.data(), _sommets.size(), pool));
+        _cache.aireValide = true;
+        return _cache.aire;
+    }
+
+    /** @brief Périmètre mémorisé ; les paquets des très grands polygones sont répartis sur @p pool. */
+    double perimetreReparti(PoolThreads* pool) const override {
+        synchroniser();
+        if (_cache.perimetreValide) return _cache.perimetre;
+        _cache.perimetre = NoyauxPolygone::perimetre(_sommets.data(), _sommets.size(), pool);
+        _cache.perimetreValide = true;
+        return _cache.perimetre;
+    }
 
 public:
     /**
@@ -30,66 +76,125 @@ public:
         : Forme(couleur), _sommets(sommets) {
     }
 
+    /**
+     * @brief Constructeur reprenant le tampon de sommets de l'appelant.
+     * @details Un grand polygone récupère le tableau sans le copier ;
+     * un petit est recopié dans le stockage interne.
+     */
+    Polygone(std::vector<Vecteur2D>&& sommets, const std::string& couleur)
+        : Forme(couleur), _sommets(std::move(sommets)) {
+    }
+
+    /** @brief Constructeur à partir d'une plage de sommets contigus. */
+    Polygone(const Vecteur2D* debut, const Vecteur2D* fin, const std::string& couleur)
+        : Forme(couleur), _sommets(debut, fin) {
+    }
+
+    /** @brief Copie : sommets et métriques mémorisées ; la copie n'appartient à aucun groupe. */
+    Polygone(const Polygone&) = default;
+
+    /** @brief Déplacement : les sommets débordés changent de propriétaire sans copie. */
+    Polygone(Polygone&& p) noexcept
+        : Forme(p), _sommets(std::move(p._sommets)), _cache(p._cache) {
+        p._cache.invalider();
+    }
+
     /** @brief Destructeur virtuel. */
     virtual ~Polygone() {}
 
     /** @brief Accesseur pour la liste des sommets. */
-    const std::vector<Vecteur2D>& getSommets() const { return _sommets; }
+    const Sommets& getSommets() const { synchroniser(); return _sommets; }
 
     /** * @brief Translation du polygone.
      *  Applique le vecteur de translation à chaque sommet.
      */
     void translation(const Vecteur2D& v) override {
+        PPIL_COMPTER(POLYGONE, TRANSFORMATION);
+        synchroniser();
         for (auto& s : _sommets) s += v;
+        _cache.translater(v);
+        marquerModifiee();
     }
 
     /** * @brief Homothétie du polygone.
      * Modifie la position de chaque sommet par rapport au point invariant.
      */
     void homothetie(const Vecteur2D& centre, double rapport) override {
+        PPIL_COMPTER(POLYGONE, TRANSFORMATION);
+        synchroniser();
         for (auto& s : _sommets) s = centre + (s - centre) * rapport;
+        _cache.homothetie(centre, rapport);
+        marquerModifiee();
     }
 
     /** * @brief Rotation du polygone.
      *  Applique la rotation trigonométrique à chaque sommet.
      */
     void rotation(const Vecteur2D& centre, double angle) override {
+        PPIL_COMPTER(POLYGONE, TRANSFORMATION);
+        synchroniser();
+        const double co = cos(angle), si = sin(angle); // Calculés une seule fois pour tous les sommets.
         for (auto& s : _sommets) {
             double dx = s.x - centre.x;
             double dy = s.y - centre.y;
-            double x = centre.x + dx * cos(angle) - dy * sin(angle);
-            double y = centre.y + dx * sin(angle) + dy * cos(angle);
+            double x = centre.x + dx * co - dy * si;
+            double y = centre.y + dx * si + dy * co;
             s = Vecteur2D(x, y);
         }
+        _cache.tourner();
+        marquerModifiee();
     }
 
     /** * @brief Calcule l'aire du polygone.
-     *  Utilise la somme des déterminants des sommets consécutifs (formule du lacet).
+     *  Utilise la somme des déterminants des sommets consécutifs (formule du lacet) ;
+     *  les grands polygones passent par les noyaux compensés de NoyauxPolygone.
+     * Le résultat est mémorisé et suivi à travers les transformations.
      * @return L'aire réelle positive du polygone.
      */
-    double calculerAire() const override {
-        double aire = 0;
-        size_t n = _sommets.size();
-        if (n < 3) return 0; // Un polygone doit avoir au moins 3 sommets
+    double calculerAire() const override { return aireRepartie(nullptr); }
 
-        for (size_t i = 0; i < n; ++i) {
-            aire += _sommets[i].determinant(_sommets[(i + 1) % n]);
-        }
-        return std::abs(aire) / 2.0;
+    /** @brief Longueur du contour fermé (mémorisée). */
+    double calculerPerimetre() const override { return perimetreReparti(nullptr); }
+
+    /**
+     * @brief Centre de gravité de la surface (mémorisé et suivi à travers les transformations).
+     * @details Centre de la boîte englobante si l'aire est nulle.
+     */
+    Vecteur2D calculerCentroide() const {
+        synchroniser();
+        if (_cache.centroideValide) return _cache.centroide;
+        _cache.centroide = NoyauxPolygone::centroide(_sommets.data(), _sommets.size());
+        _cache.centroideValide = true;
+        return _cache.centroide;
+    }
+
+    /** @brief Boîte englobant les sommets (mémorisée). */
+    Boite2D calculerBoite() const override {
+        synchroniser();
+        if (_cache.boiteValide) return _cache.boite;
+        Boite2D b;
+        for (const auto& s : _sommets) b.etendre(s);
+        _cache.boite = b;
+        _cache.boiteValide = true;
+        return b;
     }
 
     /** * @brief Pattern Visitor pour le dessin ou la sauvegarde.
      * 
      */
-    void accepte(VisiteurForme* v) const override { v->visite(*this); }
+    void accepte(VisiteurForme* v) const override {
+        PPIL_COMPTER(POLYGONE, VISITE);
+        PPIL_CHRONO("visite Polygone");
+        synchroniser();
+        v->visite(*this);
+    }
 
     /** * @brief Conversion en chaîne de caractères.
      *  Affiche la liste des sommets et la couleur.
      */
     operator std::string() const override {
-        std::string s = "Polygone [";
-        for (const auto& v : _sommets) s += (std::string)v + " ";
-        return s + "], " + _couleur;
+        synchroniser();
+        return FormatTexte::description(*this);
     }
 };
 
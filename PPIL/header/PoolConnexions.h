@@ -0,0 +1,116 @@
+/**
+ * @file PoolConnexions.h
+ * @brief Pool de connexions TCP au serveur de dessin, partagé par plusieurs threads producteurs.
+ */
+
+#ifndef POOL_CONNEXIONS_H
+#define POOL_CONNEXIONS_H
+
+#include "ConnexionTCP.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+ /**
+  * @class PoolConnexions
+  * @brief ConnexionManager à N connexions TCP, pour plusieurs threads qui dessinent en même temps.
+  * * Chaque thread producteur reçoit, à son premier envoi, son propre tampon de préparation :
+  * un paquet en cours par connexion, qu'il est seul à remplir (aucun verrou ni opération
+  * atomique par requête). Un paquet plein (taillePaquet octets) est déposé d'un seul coup dans
+  * la file sans verrou de sa connexion.
+  *
+  * Répartition :
+  * - envoyer(requete) : connexion attitrée du thread, attribuée à tour de rôle au premier envoi ;
+  * - envoyer(flux, requete) : connexion du flux (flux modulo N), quel que soit le thread.
+  *
+  * L'ordre est garanti par flux : les requêtes d'un thread (ou d'un flux) passent toutes par la
+  * même connexion, dans l'ordre où il les a soumises. Si un flux change de thread producteur,
+  * l'ancien producteur doit appeler vider() avant que le nouveau ne commence.
+  *
+  * vider() dépose les paquets en cours du thread appelant et attend qu'ils soient écrits.
+  * Les paquets restés en préparation sont déposés à la destruction du pool, qui ne doit plus
+  * avoir de producteur actif.
+  */
+class PoolConnexions : public ConnexionManager {
+public:
+    /** @brief Réglages du pool. */
+    struct Options {
+        std::size_t nbConnexions = 4;         ///< Connexions ouvertes vers le serveur.
+        std::size_t taillePaquet = 16 * 1024; ///< Octets préparés par un thread avant un dépôt.
+        ConnexionTCP::Options connexion;      ///< Réglages de chaque connexion.
+    };
+
+private:
+    /** @brief Tampon de préparation d'un thread producteur. */
+    struct Producteur {
+        std::size_t attitree;                 ///< Connexion de envoyer(requete).
+        std::vector<std::string> paquets;     ///< Paquet en cours, par connexion.
+        std::vector<std::size_t> nbRequetes;  ///< Requêtes du paquet en cours, par connexion.
+        std::vector<char> trames;             ///< Mode du paquet en cours, lu à sa première requête.
+        std::vector<char> utilisees;          ///< Connexions alimentées depuis le dernier vidage.
+    };
+
+    Options _options;
+    std::vector<std::unique_ptr<ConnexionTCP>> _connexions;
+    std::uint64_t _numero;                    ///< Distingue ce pool dans les caches des threads.
+
+    std::mutex _verrouProducteurs;            ///< Pris une seule fois par thread, à son inscription.
+    std::vector<std::unique_ptr<Producteur>> _producteurs;
+    std::size_t _prochaineAttitree = 0;
+
+    /** @brief Tampon du thread appelant, créé à son premier envoi. */
+    Producteur& producteur();
+
+    /** @brief Ajoute une requête au paquet de la connexion @p indice. */
+    void preparer(Producteur& p, std::size_t indice, const std::string& requete);
+
+    /** @brief Dépose le paquet en cours de la connexion @p indice. */
+    void deposer(Producteur& p, std::size_t indice);
+
+public:
+    /**
+     * @brief Ouvre les connexions.
+     * @throw std::runtime_error Si l'une d'elles échoue.
+     */
+    PoolConnexions(const std::string& hote, std::uint16_t port, const Options& options);
+    PoolConnexions(const std::string& hote, std::uint16_t port) : PoolConnexions(hote, port, Options()) {}
+
+    /** @brief Dépose les paquets en préparation puis ferme les connexions. */
+    ~PoolConnexions() override;
+
+    /** @brief Envoie sur la connexion attitrée du thread appelant. */
+    void envoyer(const std::string& requete) override;
+
+    /** @brief Envoie sur la connexion du flux @p flux (scène, calque...). */
+    void envoyer(std::uint64_t flux, const std::string& requete);
+
+    /** @brief Dépose les paquets du thread appelant et attend qu'ils soient écrits. */
+    void vider() override;
+
+    /**
+     * @brief Propose l'offre sur chaque connexion, tout ou rien.
+     * @details Les connexions sont interrogées l'une après l'autre ; au premier refus, celles
+     * qui avaient accepté reviennent au texte (ConnexionTCP::revenirAuTexte()), si bien que
+     * toutes parlent le même protocole.
+     * @return true si toutes l'acceptent. À appeler avant tout envoi, hors de tout envoi concurrent.
+     */
+    bool negocier(const std::string& offre) override;
+
+    /** @brief Vrai si toutes les connexions sont restées au protocole négocié. */
+    bool enTrames() const override;
+
+    /** @brief Somme des générations des connexions : change dès que l'une d'elles est rétablie. */
+    std::uint64_t generation() const override;
+
+    /** @brief Nombre de connexions du pool. */
+    std::size_t nbConnexions() const { return _connexions.size(); }
+
+    /** @brief Compteurs cumulés de toutes les connexions. */
+    ConnexionTCP::Statistiques statistiques() const;
+};
+
+#endif
@@ -0,0 +1,104 @@
+/**
+ * @file PoolThreads.h
+ * @brief Réserve de threads réutilisable, à vol de tâches, pour l'exécution de tâches indépendantes.
+ */
+
+#ifndef POOL_THREADS_H
+#define POOL_THREADS_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+ /**
+  * @class PoolThreads
+  * @brief Ensemble fixe de threads exécutant des lots de tâches numérotées, par vol de travail.
+  * * Les threads sont créés une seule fois puis réutilisés d'un lot à l'autre.
+  * Le thread appelant participe lui aussi à l'exécution du lot.
+  *
+  * Chaque thread possède sa file de plages d'indices. Il découpe la plage qu'il traite en
+  * deux, garde la première moitié et dépose la seconde dans sa file, jusqu'à atteindre la
+  * granularité demandée ; un thread inoccupé vole la plus ancienne plage (donc la plus
+  * grande) dans la file d'un autre. Un lot peut être lancé depuis une tâche d'un autre lot
+  * (parallélisme imbriqué, par exemple récursif sur un arbre) : le thread qui attend la fin
+  * d'un lot exécute d'autres tâches en attendant, sans jamais bloquer un thread de la réserve.
+  */
+class PoolThreads {
+private:
+    /** @brief État partagé d'un lot : indices restants et première erreur. */
+    struct Lot {
+        const std::function<void(std::size_t)>* tache;
+        std::size_t granularite;
+        std::atomic<std::size_t> restants;
+        std::mutex mutexErreur;
+        std::exception_ptr erreur;
+    };
+
+    /** @brief Plage d'indices [debut, fin) d'un lot. */
+    struct Plage {
+        Lot* lot;
+        std::size_t debut, fin;
+    };
+
+    /** @brief File de plages d'un thread (l'emplacement 0 sert aux threads extérieurs à la réserve). */
+    struct File {
+        std::mutex mutex;
+        std::deque<Plage> plages;
+    };
+
+    std::vector<std::thread> _threads;          ///< Threads de travail (hors thread appelant).
+    std::vector<std::unique_ptr<File>> _files;  ///< Une file par thread de travail, plus une pour les appelants.
+    std::atomic<std::size_t> _enAttente;        ///< Nombre de plages déposées dans les files.
+    std::mutex _mutexSommeil;                   ///< Protège l'endormissement des threads inoccupés.
+    std::condition_variable _travailDisponible; ///< Réveille un thread lorsqu'une plage est déposée.
+    bool _arret;                                ///< Demande d'arrêt des threads.
+
+    /** @brief Boucle principale du thread de travail @p indice (1 à taille() - 1). */
+    void boucle(std::size_t indice);
+
+    /** @brief Dépose une plage dans la file @p indice. */
+    void deposer(std::size_t indice, const Plage& p);
+
+    /** @brief Retire une plage : la plus récente de sa propre file, sinon la plus ancienne d'une autre. */
+    bool prendre(std::size_t indice, Plage& p);
+
+    /** @brief Exécute une plage en déposant ses moitiés supérieures pour les autres threads. */
+    void traiter(std::size_t indice, Plage p);
+
+    /** @brief Indice de file du thread courant (0 hors de la réserve). */
+    std::size_t indiceCourant() const;
+
+public:
+    /**
+     * @brief Crée la réserve.
+     * @param nbThreads Nombre total de threads (appelant compris) ; 0 pour le nombre de cœurs.
+     */
+    explicit PoolThreads(std::size_t nbThreads = 0);
+
+    /** @brief Arrête et joint les threads. */
+    ~PoolThreads();
+
+    PoolThreads(const PoolThreads&) = delete;
+    PoolThreads& operator=(const PoolThreads&) = delete;
+
+    /** @brief Nombre total de threads participant à un lot (appelant compris). */
+    std::size_t taille() const { return _threads.size() + 1; }
+
+    /**
+     * @brief Exécute tache(0) ... tache(nbTaches - 1) en parallèle et attend leur fin.
+     * @param granularite Nombre d'indices en dessous duquel une plage n'est plus découpée.
+     * @details Si des tâches lèvent une exception, la première est relancée dans l'appelant
+     * une fois toutes les tâches du lot terminées. Peut être appelée depuis une tâche.
+     */
+    void executer(std::size_t nbTaches, const std::function<void(std::size_t)>& tache,
+                  std::size_t granularite = 1);
+};
+
+#endif
@@ -0,0 +1,111 @@
+/**
+ * @file ProtocoleDessin.h
+ * @brief Protocole binaire compact d'envoi des commandes de dessin (coordonnées quantifiées).
+ */
+
+#ifndef PROTOCOLE_DESSIN_H
+#define PROTOCOLE_DESSIN_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "vecteur2D.h"
+
+ /**
+  * @brief Protocole binaire de dessin, optionnel : le protocole texte reste la valeur par défaut.
+  * @details Négociation : le client envoie la ligne "Protocole;binaire;<version>;<pas>" ; si le
+  * serveur répond "OK", les échanges suivants sont des trames binaires précédées de leur
+  * longueur (u32 petit-boutiste), sinon le client continue en texte.
+  *
+  * Une trame est une suite de commandes : code (u8), indice de palette (u8, comme dans
+  * FormatBinaire ; COULEUR_LIBRE est suivi de la longueur en varint et des octets), données.
+  * Chaque coordonnée est arrondie à un multiple du pas négocié, puis codée comme l'écart
+  * (zigzag + varint LEB128) avec le sommet précédent de la même trame : des sommets voisins
+  * tiennent en un ou deux octets. Le premier sommet d'une trame part de (0,0), si bien que
+  * chaque trame se décode indépendamment des autres.
+  * - Cercle : centre, rayon (varint non signé, en pas) ;
+  * - Segment : deux extrémités ;
+  * - Polygone : nombre de sommets (varint) puis les sommets ;
+  * - Point : un sommet (forme trop petite pour être dessinée à l'échelle de la vue).
+  *
+  * Envoi différentiel : Ajout et MiseAJour portent l'identifiant stable de la forme (varint)
+  * et sont suivis de la commande de la forme ; Suppression ne porte que l'identifiant.
+  */
+namespace ProtocoleDessin {
+
+    const std::uint16_t VERSION = 1;
+
+    /** @brief Réponse du serveur qui accepte l'offre. */
+    const std::string ACCEPTATION = "OK";
+
+    /** @brief Pas de quantification par défaut (un centième d'unité). */
+    const double PAS_DEFAUT = 0.01;
+
+    /** @brief Codes des commandes. */
+    enum Code : std::uint8_t {
+        CERCLE = 1,
+        SEGMENT = 2,
+        POLYGONE = 3,
+        AJOUT = 4,
+        MISE_A_JOUR = 5,
+        SUPPRESSION = 6,
+        POINT = 7
+    };
+
+    /** @brief Ligne d'offre envoyée lors de la négociation. */
+    std::string offre(double pas);
+
+    /**
+     * @class Encodeur
+     * @brief Construit une trame de commandes binaires.
+     */
+    class Encodeur {
+    private:
+        double _inversePas;          ///< 1 / pas : la quantification est une multiplication.
+        std::int64_t _x = 0, _y = 0; ///< Dernier sommet écrit, en pas.
+        std::string _trame;
+
+        void ecrireEntete(Code code, const std::string& couleur);
+        void ecrirePoint(const Vecteur2D& p);
+
+    public:
+        /** @param pas Pas de la grille de quantification (strictement positif). */
+        explicit Encodeur(double pas = PAS_DEFAUT);
+
+        void cercle(const Vecteur2D& centre, double rayon, const std::string& couleur);
+        void segment(const Vecteur2D& p1, const Vecteur2D& p2, const std::string& couleur);
+        void polygone(const Vecteur2D* sommets, std::size_t nbSommets, const std::string& couleur);
+        void point(const Vecteur2D& p, const std::string& couleur);
+
+        /** @brief Préfixe AJOUT ou MISE_A_JOUR de la commande suivante, ou SUPPRESSION seule. */
+        void operation(Code code, std::uint64_t identifiant);
+
+        /** @brief Contenu de la trame en cours. */
+        const std::string& trame() const { return _trame; }
+
+        /** @brief Commence une nouvelle trame (les écarts repartent de l'origine). */
+        void nouvelleTrame() {
+            _trame.clear();
+            _x = _y = 0;
+        }
+    };
+
+    /** @brief Commande décodée. */
+    struct Commande {
+        Code code;                     ///< Forme dessinée, ou SUPPRESSION.
+        Code operation = Code(0);      ///< AJOUT, MISE_A_JOUR ou SUPPRESSION (0 : dessin simple).
+        std::uint64_t identifiant = 0; ///< Identifiant de la forme (envoi différentiel).
+        std::string couleur;
+        std::vector<Vecteur2D> points; ///< Centre, extrémités, sommets ou point.
+        double rayon = 0;              ///< Cercle uniquement.
+    };
+
+    /**
+     * @brief Décode une trame (sans son préfixe de longueur).
+     * @throw std::runtime_error Si la trame est tronquée ou contient un code inconnu.
+     */
+    std::vector<Commande> decoder(const char* donnees, std::size_t taille, double pas = PAS_DEFAUT);
+}
+
+#endif
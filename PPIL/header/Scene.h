@@ -0,0 +1,77 @@
+/**
+ * @file Scene.h
+ * @brief Scène dont toutes les formes sont allouées dans une arène commune.
+ */
+
+#ifndef SCENE_H
+#define SCENE_H
+
+#include <string>
+#include <utility>
+#include "ArenaFormes.h"
+#include "Group.h"
+
+ /**
+  * @class Scene
+  * @brief Groupe racine et arène qui héberge toutes ses formes.
+  * * Les formes créées par creer() sont placées à la suite dans l'arène de la scène au lieu
+  * d'être allouées une à une sur le tas. La racine possède ses enfants comme dans le pattern
+  * Composite, mais c'est la scène qui détruit l'arbre (ArenaFormes::detruire) : la mémoire
+  * n'est rendue qu'en une fois, avec l'arène.
+  *
+  * Une forme créée par la scène ne doit jamais être détruite par delete, ni ajoutée à un
+  * groupe qui survivrait à la scène ; une forme retirée de la scène (ou un prototype
+  * d'Instance créé par creer()) se détruit par detruire(). À l'inverse, on peut ajouter
+  * à la scène une forme allouée par un simple new.
+  */
+class Scene {
+private:
+    ArenaFormes _arene;  ///< Déclarée avant la racine : détruite après elle.
+    Groupe* _racine;     ///< Groupe racine, lui-même alloué dans l'arène.
+    std::string _couleur;
+
+public:
+    /** @param couleur Couleur du groupe racine. */
+    explicit Scene(const std::string& couleur = Forme::BLACK);
+
+    /** @brief Détruit les formes puis rend toute la mémoire de l'arène en une fois. */
+    ~Scene();
+
+    Scene(const Scene&) = delete;
+    Scene& operator=(const Scene&) = delete;
+
+    /**
+     * @brief Construit une forme dans l'arène de la scène.
+     * @return La forme créée ; elle appartient à la scène dès qu'elle est ajoutée à un de ses groupes.
+     */
+    template <class T, class... Args>
+    T* creer(Args&&... args) {
+        return _arene.creer<T>(std::forward<Args>(args)...);
+    }
+
+    /** @brief Construit une forme dans l'arène et l'ajoute à la racine. */
+    template <class T, class... Args>
+    T* ajouter(Args&&... args) {
+        T* f = creer<T>(std::forward<Args>(args)...);
+        _racine->ajouter(f);
+        return f;
+    }
+
+    /**
+     * @brief Détruit une forme qui n'est plus dans la scène (et ses descendants).
+     * @details Sa mémoire reste à l'arène jusqu'à vider() ou la destruction de la scène.
+     */
+    void detruire(Forme* f) { _arene.detruire(f); }
+
+    /** @brief Groupe racine. */
+    Groupe& racine() { return *_racine; }
+    const Groupe& racine() const { return *_racine; }
+
+    /** @brief Détruit toutes les formes, rend la mémoire et repart d'une racine vide. */
+    void vider();
+
+    /** @brief Arène de la scène (statistiques d'occupation). */
+    const ArenaFormes& arene() const { return _arene; }
+};
+
+#endif
@@ -0,0 +1,215 @@
+/**
+ * @file SceneValeur.h
+ * @brief Représentation par valeur des formes (std::variant) et visiteurs résolus à la compilation.
+ */
+
+#ifndef SCENE_VALEUR_H
+#define SCENE_VALEUR_H
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#include <cmath>
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+#include "vecteur2D.h"
+#include "Boite2D.h"
+#include "Transformation2D.h"
+#include "NoyauxPolygone.h"
+
+class Forme;
+
+/** @brief Cercle par valeur. */
+struct CercleValeur {
+    Vecteur2D centre;
+    double rayon = 0;
+    std::string couleur;
+
+    bool operator==(const CercleValeur&) const = default;
+};
+
+/** @brief Segment par valeur. */
+struct SegmentValeur {
+    Vecteur2D p1, p2;
+    std::string couleur;
+
+    bool operator==(const SegmentValeur&) const = default;
+};
+
+/** @brief Polygone par valeur. */
+struct PolygoneValeur {
+    std::vector<Vecteur2D> sommets;
+    std::string couleur;
+
+    bool operator==(const PolygoneValeur&) const = default;
+};
+
+struct FormeValeur;
+
+/** @brief Groupe par valeur : les enfants sont rangés à la suite dans un seul tableau. */
+struct GroupeValeur {
+    std::string couleur;
+    std::vector<FormeValeur> formes;
+
+    bool operator==(const GroupeValeur&) const = default;
+};
+
+/** @brief Les quatre natures de forme ; l'ensemble est fermé. */
+using VarianteForme = std::variant<CercleValeur, SegmentValeur, PolygoneValeur, GroupeValeur>;
+
+/**
+ * @struct FormeValeur
+ * @brief Forme quelconque, copiable et déplaçable, sans allocation individuelle ni appel virtuel.
+ * * Pendant par valeur de la hiérarchie Forme : une scène est un arbre de FormeValeur dont
+ * chaque groupe possède ses enfants dans un std::vector contigu. Les traitements sont des
+ * visiteurs ordinaires (un operator() par nature de forme) appliqués par visiter(), c'est-à-dire
+ * std::visit : la répartition se fait par l'indice du variant et le compilateur peut intégrer
+ * le corps du visiteur, là où Forme::accepte coûte deux appels virtuels par forme.
+ *
+ * versValeur() et versForme() convertissent dans les deux sens ; les sauvegardes produisent
+ * exactement les mêmes fichiers que VisiteurSauvegardeTexte et VisiteurSauvegardeBinaire,
+ * dont elles partagent les encodeurs (EncodeurSauvegarde.h).
+ */
+struct FormeValeur : VarianteForme {
+    using VarianteForme::VarianteForme;
+
+    /** @brief Le variant lui-même, pour std::visit et std::get. */
+    const VarianteForme& variante() const { return *this; }
+    VarianteForme& variante() { return *this; }
+};
+
+/** @brief Réunit plusieurs lambdas en un seul visiteur : visiter(Surcharges{ [](const CercleValeur&) {...}, ... }, f). */
+template <typename... F>
+struct Surcharges : F... {
+    using F::operator()...;
+};
+
+template <typename... F>
+Surcharges(F...) -> Surcharges<F...>;
+
+/** @brief Applique @p visiteur à la forme concrète contenue dans @p f. */
+template <typename V>
+decltype(auto) visiter(V&& visiteur, const FormeValeur& f) {
+    return std::visit(std::forward<V>(visiteur), f.variante());
+}
+
+/** @brief Applique @p visiteur à la forme concrète contenue dans @p f, modifiable. */
+template <typename V>
+decltype(auto) visiter(V&& visiteur, FormeValeur& f) {
+    return std::visit(std::forward<V>(visiteur), f.variante());
+}
+
+namespace SceneValeur {
+
+    /** @brief Aire, calculée comme par Forme::calculerAire (mêmes formules, même ordre de sommation). */
+    struct VisiteurAire {
+        double operator()(const CercleValeur& c) const { return M_PI * c.rayon * c.rayon; }
+        double operator()(const SegmentValeur&) const { return 0.0; }
+        double operator()(const PolygoneValeur& p) const {
+            return std::abs(NoyauxPolygone::aireSignee(p.sommets.data(), p.sommets.size()));
+        }
+        double operator()(const GroupeValeur& g) const {
+            double aire = 0;
+            for (const FormeValeur& f : g.formes) aire += visiter(*this, f);
+            return aire;
+        }
+    };
+
+    /** @brief Périmètre (somme des périmètres pour un groupe). */
+    struct VisiteurPerimetre {
+        double operator()(const CercleValeur& c) const { return 2 * M_PI * c.rayon; }
+        double operator()(const SegmentValeur& s) const { return std::hypot(s.p2.x - s.p1.x, s.p2.y - s.p1.y); }
+        double operator()(const PolygoneValeur& p) const {
+            return NoyauxPolygone::perimetre(p.sommets.data(), p.sommets.size());
+        }
+        double operator()(const GroupeValeur& g) const {
+            double perimetre = 0;
+            for (const FormeValeur& f : g.formes) perimetre += visiter(*this, f);
+            return perimetre;
+        }
+    };
+
+    /** @brief Boîte englobante. */
+    struct VisiteurBoite {
+        Boite2D operator()(const CercleValeur& c) const {
+            return Boite2D(c.centre.x - c.rayon, c.centre.y - c.rayon, c.centre.x + c.rayon, c.centre.y + c.rayon);
+        }
+        Boite2D operator()(const SegmentValeur& s) const { return Boite2D::entre(s.p1, s.p2); }
+        Boite2D operator()(const PolygoneValeur& p) const {
+            Boite2D b;
+            for (const Vecteur2D& s : p.sommets) b.etendre(s);
+            return b;
+        }
+        Boite2D operator()(const GroupeValeur& g) const {
+            Boite2D b;
+            for (const FormeValeur& f : g.formes) b.etendre(visiter(*this, f));
+            return b;
+        }
+    };
+
+    /** @brief Applique une similitude à tous les points (appliquée immédiatement, sans mise en attente). */
+    struct VisiteurTransformation {
+        const Transformation2D& m;
+        double echelle;
+
+        explicit VisiteurTransformation(const Transformation2D& t) : m(t), echelle(t.echelle()) {}
+
+        void operator()(CercleValeur& c) const {
+            c.centre = m.appliquer(c.centre);
+            c.rayon *= echelle;
+        }
+        void operator()(SegmentValeur& s) const {
+            s.p1 = m.appliquer(s.p1);
+            s.p2 = m.appliquer(s.p2);
+        }
+        void operator()(PolygoneValeur& p) const {
+            for (Vecteur2D& s : p.sommets) s = m.appliquer(s);
+        }
+        void operator()(GroupeValeur& g) const {
+            for (FormeValeur& f : g.formes) visiter(*this, f);
+        }
+    };
+
+    /** @brief Nombre de formes simples. */
+    struct VisiteurFeuilles {
+        std::size_t operator()(const GroupeValeur& g) const {
+            std::size_t n = 0;
+            for (const FormeValeur& f : g.formes) n += visiter(*this, f);
+            return n;
+        }
+        template <typename T>
+        std::size_t operator()(const T&) const { return 1; }
+    };
+
+    inline double aire(const FormeValeur& f) { return visiter(VisiteurAire{}, f); }
+    inline double perimetre(const FormeValeur& f) { return visiter(VisiteurPerimetre{}, f); }
+    inline Boite2D boite(const FormeValeur& f) { return visiter(VisiteurBoite{}, f); }
+    inline std::size_t nbFeuilles(const FormeValeur& f) { return visiter(VisiteurFeuilles{}, f); }
+    inline void transformer(FormeValeur& f, const Transformation2D& m) { visiter(VisiteurTransformation(m), f); }
+
+    /** @brief Copie par valeur d'une forme de la hiérarchie (transformations en attente comprises). */
+    FormeValeur versValeur(const Forme& f);
+
+    /** @brief Construit l'arbre de Forme équivalent ; l'appelant en devient propriétaire. */
+    Forme* versForme(const FormeValeur& f);
+
+    /**
+     * @brief Sauvegarde au format texte de VisiteurSauvegardeTexte (relu par les chargeurs texte).
+     * @throw std::runtime_error En cas d'échec d'écriture ou de renommage.
+     */
+    void sauvegarderTexte(const FormeValeur& f, const std::string& nomFichier);
+
+    /**
+     * @brief Sauvegarde au format binaire de VisiteurSauvegardeBinaire (relu par ChargeurBinaire).
+     * @param pasQuantification Pas de la grille des coordonnées ; 0 (défaut) : réels exacts.
+     * @throw std::runtime_error En cas d'échec d'écriture ou de renommage.
+     * @throw std::range_error Si une coordonnée sort de la grille de quantification.
+     */
+    void sauvegarderBinaire(const FormeValeur& f, const std::string& nomFichier, double pasQuantification = 0);
+}
+
+#endif
@@ -8,6 +8,7 @@
 
 #include "Forme.h"
 #include "VisiteurForme.h"
+#include "Instrumentation.h"
 
  /**
   * @class Segment
@@ -19,6 +20,16 @@ private:
     Vecteur2D _p1; ///< Premier point du segment.
     Vecteur2D _p2; ///< Deuxième point du segment.
 
+    friend class JournalTransformations; ///< Restaure la géométrie d'une copie.
+
+protected:
+    /** * @brief Transformation composée appliquée aux deux extrémités. */
+    void transformer(const Transformation2D& m) override {
+        PPIL_COMPTER(SEGMENT, TRANSFORMATION);
+        _p1 = m.appliquer(_p1);
+        _p2 = m.appliquer(_p2);
+    }
+
 public:
     /**
      * @brief Constructeur de Segment.
@@ -37,56 +48,87 @@ public:
      * Utiles pour le Visiteur (dessin/sauvegarde).
      * @{
      */
-    const Vecteur2D& getP1() const { return _p1; }
-    const Vecteur2D& getP2() const { return _p2; }
+    const Vecteur2D& getP1() const { synchroniser(); return _p1; }
+    const Vecteur2D& getP2() const { synchroniser(); return _p2; }
     /** @} */
 
     /** * @brief Translation du segment.
      * Déplace les deux points p1 et p2 par le vecteur v. 
      */
     void translation(const Vecteur2D& v) override {
+        PPIL_COMPTER(SEGMENT, TRANSFORMATION);
+        synchroniser();
         _p1 += v;
         _p2 += v;
+        marquerModifiee();
     }
 
     /** * @brief Homothétie du segment.
      * Redimensionne le segment par rapport à un centre invariant. 
      */
     void homothetie(const Vecteur2D& centre, double rapport) override {
+        PPIL_COMPTER(SEGMENT, TRANSFORMATION);
+        synchroniser();
         _p1 = centre + (_p1 - centre) * rapport;
         _p2 = centre + (_p2 - centre) * rapport;
+        marquerModifiee();
     }
 
     /** * @brief Rotation du segment.
      * Fait pivoter les deux extrémités autour d'un centre donné. 
      */
     void rotation(const Vecteur2D& centre, double angle) override {
+        PPIL_COMPTER(SEGMENT, TRANSFORMATION);
+        synchroniser();
+        const double co = cos(angle), si = sin(angle);
         auto rot = [&](const Vecteur2D& p) {
             double dx = p.x - centre.x;
             double dy = p.y - centre.y;
-            double x = centre.x + dx * cos(angle) - dy * sin(angle);
-            double y = centre.y + dx * sin(angle) + dy * cos(angle);
+            double x = centre.x + dx * co - dy * si;
+            double y = centre.y + dx * si + dy * co;
             return Vecteur2D(x, y);
             };
         _p1 = rot(_p1);
         _p2 = rot(_p2);
+        marquerModifiee();
     }
 
     /** * @brief Calcul de l'aire du segment.
      * @return Toujours 0.0 car un segment n'a pas de surface.
      */
-    double calculerAire() const override { return 0.0; }
+    double calculerAire() const override {
+        PPIL_COMPTER(SEGMENT, AIRE);
+        return 0.0;
+    }
+
+    /** @brief Longueur du segment. */
+    double calculerPerimetre() const override {
+        synchroniser();
+        return std::hypot(_p2.x - _p1.x, _p2.y - _p1.y);
+    }
+
+    /** @brief Boîte englobant les deux extrémités. */
+    Boite2D calculerBoite() const override {
+        synchroniser();
+        return Boite2D::entre(_p1, _p2);
+    }
 
     /** * @brief Pattern Visitor.
      * @param v Pointeur vers le visiteur (Dessin ou Sauvegarde). 
      */
-    void accepte(VisiteurForme* v) const override { v->visite(*this); }
+    void accepte(VisiteurForme* v) const override {
+        PPIL_COMPTER(SEGMENT, VISITE);
+        PPIL_CHRONO("visite Segment");
+        synchroniser();
+        v->visite(*this);
+    }
 
     /** * @brief Conversion en chaîne de caractères.
      * @return Format : "Segment [(x1,y1), (x2,y2)], couleur". 
      */
     operator std::string() const override {
-        return "Segment [" + (std::string)_p1 + ", " + (std::string)_p2 + "], " + _couleur;
+        synchroniser();
+        return FormatTexte::description(*this);
     }
 };
 
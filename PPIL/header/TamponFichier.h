@@ -0,0 +1,91 @@
+/**
+ * @file TamponFichier.h
+ * @brief Flux de sortie tamponné avec validation atomique (fichier temporaire puis renommage).
+ */
+
+#ifndef TAMPON_FICHIER_H
+#define TAMPON_FICHIER_H
+
+#include <string>
+#include <fstream>
+#include <cstddef>
+#include <cstdint>
+
+ /**
+  * @class TamponFichier
+  * @brief Écrit dans un fichier via un unique tampon mémoire, ouvert une seule fois par session.
+  * * Les données sont accumulées en espace utilisateur puis écrites par blocs dès que le seuil
+  * de vidage est atteint. Tout est écrit dans "<nomFichier>.tmp" ; valider() renomme ce fichier
+  * temporaire vers la destination finale, qui n'est donc jamais observée à moitié écrite.
+  */
+class TamponFichier {
+private:
+    std::string _nomFichier;     ///< Destination finale.
+    std::string _nomTemporaire;  ///< Fichier de travail, renommé lors de la validation.
+    std::ofstream _flux;         ///< Flux ouvert une seule fois pour toute la session.
+    std::string _tampon;         ///< Tampon d'écriture en espace utilisateur.
+    std::size_t _seuilVidage;    ///< Taille à partir de laquelle le tampon est écrit sur disque.
+    std::uint64_t _octetsVides;  ///< Nombre d'octets déjà transmis au flux.
+    bool _valide;                ///< Vrai une fois le fichier renommé vers sa destination.
+
+    /** @brief Transmet le contenu du tampon au flux. */
+    void vider();
+
+public:
+    /** @brief Seuil de vidage par défaut (1 Mio). */
+    static const std::size_t SEUIL_DEFAUT = std::size_t(1) << 20;
+
+    /**
+     * @brief Ouvre le fichier temporaire de la session.
+     * @param nomFichier Chemin du fichier de destination.
+     * @param seuilVidage Taille du tampon en octets avant écriture effective.
+     * @param binaire Ouvre le fichier en mode binaire (aucune conversion de fin de ligne).
+     * @throw std::runtime_error Si le fichier temporaire ne peut pas être créé.
+     */
+    TamponFichier(const std::string& nomFichier, std::size_t seuilVidage = SEUIL_DEFAUT, bool binaire = false);
+
+    /**
+     * @brief Destructeur.
+     * @details Si la session n'a pas été validée, le fichier temporaire est supprimé
+     * et la destination reste inchangée.
+     */
+    ~TamponFichier();
+
+    TamponFichier(const TamponFichier&) = delete;
+    TamponFichier& operator=(const TamponFichier&) = delete;
+
+    /** @brief Ajoute une suite d'octets au tampon. */
+    void ecrire(const char* donnees, std::size_t taille) {
+        _tampon.append(donnees, taille);
+        if (_tampon.size() >= _seuilVidage) vider();
+    }
+
+    /** @brief Ajoute une chaîne au tampon. */
+    void ecrire(const std::string& s) { ecrire(s.data(), s.size()); }
+
+    /** @brief Ajoute un caractère au tampon. */
+    void ecrire(char c) {
+        _tampon.push_back(c);
+        if (_tampon.size() >= _seuilVidage) vider();
+    }
+
+    /** @brief Position courante (nombre total d'octets écrits depuis l'ouverture). */
+    std::uint64_t position() const { return _octetsVides + _tampon.size(); }
+
+    /**
+     * @brief Réécrit des octets déjà produits (ex : longueur d'un enregistrement connue après coup).
+     * @details La zone peut se trouver encore dans le tampon ou déjà sur disque.
+     */
+    void reecrire(std::uint64_t position, const char* donnees, std::size_t taille);
+
+    /**
+     * @brief Termine la session : vide le tampon, ferme le fichier et le renomme vers sa destination.
+     * @throw std::runtime_error En cas d'échec d'écriture ou de renommage.
+     */
+    void valider();
+
+    /** @brief Indique si la session a déjà été validée. */
+    bool estValide() const { return _valide; }
+};
+
+#endif
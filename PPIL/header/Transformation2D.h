@@ -0,0 +1,83 @@
+/**
+ * @file Transformation2D.h
+ * @brief Transformation affine du plan, composable (translation, homothétie, rotation).
+ */
+
+#ifndef TRANSFORMATION_2D_H
+#define TRANSFORMATION_2D_H
+
+#include <cmath>
+#include "vecteur2D.h"
+
+ /**
+  * @class Transformation2D
+  * @brief Matrice affine 2x3 : p' = (a.x + b.y + tx, c.x + d.y + ty).
+  * * Une suite de transformations se compose en une seule matrice, appliquée ensuite
+  * à chaque point en un seul passage (les cosinus et sinus ne sont calculés qu'une fois).
+  * Les compositions de translations, d'homothéties et de rotations restent des similitudes,
+  * ce qui permet de transformer un cercle en cercle.
+  */
+class Transformation2D {
+public:
+    double a, b, c, d;  ///< Partie linéaire.
+    double tx, ty;      ///< Partie translation.
+
+    /** @brief Construit l'identité. */
+    Transformation2D() : a(1), b(0), c(0), d(1), tx(0), ty(0) {}
+
+    /** @brief Construit une matrice à partir de ses coefficients. */
+    Transformation2D(double a, double b, double c, double d, double tx, double ty)
+        : a(a), b(b), c(c), d(d), tx(tx), ty(ty) {}
+
+    /** @name Fabriques (mêmes conventions que Forme) @{ */
+    static Transformation2D translation(const Vecteur2D& v) {
+        return Transformation2D(1, 0, 0, 1, v.x, v.y);
+    }
+
+    static Transformation2D homothetie(const Vecteur2D& centre, double rapport) {
+        return Transformation2D(rapport, 0, 0, rapport,
+                                centre.x - rapport * centre.x, centre.y - rapport * centre.y);
+    }
+
+    /** @param angle Angle signé en radians. */
+    static Transformation2D rotation(const Vecteur2D& centre, double angle) {
+        const double co = std::cos(angle), si = std::sin(angle);
+        return Transformation2D(co, -si, si, co,
+                                centre.x - co * centre.x + si * centre.y,
+                                centre.y - si * centre.x - co * centre.y);
+    }
+    /** @} */
+
+    /**
+     * @brief Composition : (*this) * m applique d'abord m, puis *this.
+     */
+    Transformation2D operator*(const Transformation2D& m) const {
+        return Transformation2D(a * m.a + b * m.c, a * m.b + b * m.d,
+                                c * m.a + d * m.c, c * m.b + d * m.d,
+                                a * m.tx + b * m.ty + tx, c * m.tx + d * m.ty + ty);
+    }
+
+    /** @brief Enchaîne @p m après la transformation courante. */
+    Transformation2D& puis(const Transformation2D& m) {
+        *this = m * *this;
+        return *this;
+    }
+
+    /** @brief Image d'un point. */
+    Vecteur2D appliquer(const Vecteur2D& p) const {
+        return Vecteur2D(a * p.x + b * p.y + tx, c * p.x + d * p.y + ty);
+    }
+
+    /** @brief Déterminant de la partie linéaire (facteur d'échelle des aires, signé). */
+    double determinant() const { return a * d - b * c; }
+
+    /** @brief Facteur d'échelle des longueurs (exact pour une similitude). */
+    double echelle() const { return std::sqrt(std::abs(determinant())); }
+
+    /** @brief Vrai pour l'identité exacte. */
+    bool estIdentite() const {
+        return a == 1 && b == 0 && c == 0 && d == 1 && tx == 0 && ty == 0;
+    }
+};
+
+#endif
@@ -0,0 +1,194 @@
+/**
+ * @file VisiteurDessin.h
+ * @brief Visiteur concret qui envoie les formes au serveur de dessin.
+ */
+
+#ifndef VISITEUR_DESSIN_H
+#define VISITEUR_DESSIN_H
+
+#include "VisiteurForme.h"
+#include "ProtocoleDessin.h"
+#include "Boite2D.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class ConnexionManager;
+class Forme;
+class Vecteur2D;
+
+ /**
+  * @class VisiteurDessin
+  * @brief Traduit chaque forme en commande de dessin et la transmet via le ConnexionManager.
+  * * Protocole texte par défaut, une requête par forme : "Cercle;red;10,10;5",
+  * "Segment;red;x1,y1;x2,y2", "Polygone;red;x1,y1;x2,y2;...".
+  * Après activerBinaire(), les commandes sont regroupées en trames binaires compactes
+  * (voir ProtocoleDessin.h).
+  *
+  * Les pièces d'un groupe sont dessinées avec la couleur du groupe (celle du groupe le plus
+  * extérieur pour des groupes imbriqués).
+  *
+  * En mode différentiel (activerDifferentiel), le même visiteur sert d'une image à l'autre et
+  * n'envoie que les changements, repérés par l'identifiant stable des formes :
+  * "Ajout;<id>;<forme>", "MiseAJour;<id>;<forme>" et "Suppression;<id>". Il mémorise la date
+  * de ce qu'il a envoyé ; un sous-arbre dont ni les formes ni les ancêtres n'ont changé depuis
+  * est sauté sans être parcouru, si bien que le coût d'une image suit le nombre de changements.
+  *
+  * Avec une vue (definirVue), seules les formes dont la boîte touche la vue sont envoyées (un
+  * groupe hors de la vue n'est pas parcouru) ; une forme ou un groupe plus petit que la tolérance
+  * est réduit à un point ("Point;couleur;x,y"), et les sommets des polygones sont simplifiés
+  * (Douglas-Peucker) à la tolérance. Les simplifications sont mémorisées par polygone et par
+  * niveau de zoom (puissance de deux de la tolérance). En mode différentiel, un déplacement de
+  * la vue ajoute les formes qui y entrent et supprime celles qui en sortent ; seul un changement
+  * de niveau de zoom renvoie les formes restées visibles.
+  */
+class VisiteurDessin : public VisiteurForme {
+private:
+    ConnexionManager* _connexion;                        ///< Destination des commandes.
+    std::unique_ptr<ProtocoleDessin::Encodeur> _binaire; ///< nullptr : protocole texte.
+    const std::string* _couleurGroupe = nullptr;         ///< Couleur imposée par le groupe en cours.
+    std::string _requete;                                ///< Tampon réutilisé des requêtes texte.
+
+    /** @brief Ce qui a été envoyé pour une forme lors des images précédentes. */
+    struct Envoi {
+        std::uint64_t version;               ///< Date effective (forme et ancêtres) au moment de l'envoi.
+        unsigned vue;                        ///< Groupes : numéro de la vue ; formes : numéro de l'échelle.
+        bool groupe;                         ///< Groupe détaillé (seules ses pièces sont dessinées).
+        std::vector<std::uint64_t> enfants;  ///< Groupes : identifiants des enfants envoyés.
+    };
+
+    bool _differentiel = false;                       ///< Vrai : n'envoyer que les changements.
+    std::unordered_map<std::uint64_t, Envoi> _envois; ///< État connu du serveur, par identifiant.
+    std::uint64_t _versionAncetres = 0;               ///< Date la plus récente parmi les groupes ancêtres.
+    std::size_t _profondeur = 0;                      ///< Profondeur de la forme visitée (0 : racine).
+    std::vector<std::uint64_t> _racines;              ///< Racines dessinées à l'image précédente.
+    std::vector<std::uint64_t> _racinesImage;         ///< Racines visitées pendant l'image en cours.
+    std::uint64_t _generation = 0;                    ///< ConnexionManager::generation() du pair connu.
+
+    /** @brief Bit réservé aux identifiants des pièces d'instances (jamais atteint par Forme). */
+    static const std::uint64_t PIECE_INSTANCE = std::uint64_t(1) << 63;
+    std::uint64_t _prochainePiece = 0;                    ///< Numéro de la prochaine pièce d'instance.
+    std::vector<std::uint64_t>* _piecesInstance = nullptr; ///< Pièces envoyées pour l'instance en cours.
+
+    /** @brief Polygone simplifié pour un niveau de zoom. */
+    struct Simplification {
+        std::uint64_t version;           ///< Date effective du polygone simplifié.
+        std::vector<Vecteur2D> sommets;
+    };
+
+    bool _cadrage = false;       ///< Vrai si une vue a été définie.
+    Boite2D _vue;                ///< Partie visible de la scène.
+    double _tolerance = 0;       ///< Écart toléré en unités de la scène (puissance de deux).
+    int _niveau = 0;             ///< Exposant de la tolérance : identifie le niveau de zoom.
+    unsigned _numeroVue = 0;     ///< Change à chaque nouvelle vue (les groupes sont reparcourus).
+    unsigned _numeroEchelle = 0; ///< Change avec la tolérance (les formes visibles sont renvoyées).
+    std::unordered_map<std::uint64_t, Simplification> _simplifications; ///< Par polygone et niveau.
+    std::vector<Vecteur2D> _simplifie;                                  ///< Tampon des petits polygones.
+    std::vector<Vecteur2D> _places;                                     ///< Sommets placés d'un polygone d'instance.
+
+    /** @brief Couleur avec laquelle dessiner une forme. */
+    const std::string& couleur(const std::string& propre) const {
+        return _couleurGroupe ? *_couleurGroupe : propre;
+    }
+
+    void ecrireReel(double valeur);
+    void ecrirePoint(const Vecteur2D& p);
+
+    /** @brief Envoie la trame binaire si elle a atteint sa taille cible. */
+    void envoyerTrameSiPleine();
+
+    /**
+     * @brief Prépare l'envoi d'une forme simple (ou d'un groupe réduit à un point).
+     * @param version Date effective de la forme.
+     * @return false en mode différentiel si le serveur a déjà la forme à jour.
+     */
+    bool preparer(const Forme& f, std::uint64_t version);
+
+    /**
+     * @brief Applique la vue à une forme de boîte @p boite.
+     * @return true si la forme est traitée (hors de la vue, ou envoyée comme un point).
+     */
+    bool cadrer(const Forme& f, const Boite2D& boite, std::uint64_t version, const std::string& couleurForme);
+
+    /** @brief Sommets à envoyer pour un polygone : simplifiés si une vue est définie. */
+    const std::vector<Vecteur2D>* simplifier(const Polygone& polygone, std::uint64_t version);
+
+    /** @brief Envoie la suppression d'une forme déjà envoyée et de ses descendants. */
+    void supprimer(std::uint64_t identifiant);
+
+public:
+    /** @brief Taille visée d'une trame binaire, en octets. */
+    static const std::size_t TAILLE_TRAME = 16 * 1024;
+
+    /** @param connexion Connexion utilisée (par défaut, l'instance du Singleton). */
+    explicit VisiteurDessin(ConnexionManager* connexion = nullptr);
+
+    /**
+     * @brief Propose le protocole binaire au serveur.
+     * @param pas Pas de la grille de quantification des coordonnées.
+     * @return true si le serveur l'accepte ; sinon le visiteur reste en texte.
+     */
+    bool activerBinaire(double pas = ProtocoleDessin::PAS_DEFAUT);
+
+    /** @brief Vrai si les commandes partent en trames binaires. */
+    bool estBinaire() const { return _binaire != nullptr; }
+
+    /**
+     * @brief Passe en envoi différentiel ; l'état mémorisé repart de zéro.
+     * @details La première image envoie donc tout, sous forme d'ajouts.
+     */
+    void activerDifferentiel();
+
+    /** @brief Vrai en envoi différentiel. */
+    bool estDifferentiel() const { return _differentiel; }
+
+    /** @brief Polygones à partir desquels une simplification est mémorisée. */
+    static const std::size_t SOMMETS_SIMPLIFICATION_MEMORISEE = 64;
+
+    /**
+     * @brief Restreint le dessin à une vue.
+     * @param vue Partie visible, en coordonnées de la scène.
+     * @param unitesParPixel Taille d'un pixel à l'écran, en unités de la scène.
+     * @param tolerancePixels Écart maximal, en pixels, entre une forme et son dessin simplifié.
+     */
+    void definirVue(const Boite2D& vue, double unitesParPixel, double tolerancePixels = 0.5);
+
+    /** @brief Revient au dessin complet, sans élimination ni simplification. */
+    void supprimerVue();
+
+    /** @brief Oublie les polygones simplifiés mémorisés. */
+    void viderSimplifications() { _simplifications.clear(); }
+
+    /**
+     * @brief Fin d'image : envoie la trame en cours et vide la connexion.
+     * @details En mode différentiel, les racines de l'image précédente qui n'ont pas été
+     * visitées cette fois sont supprimées. Si la connexion a été rétablie pendant l'image
+     * (ConnexionManager::generation()), le nouveau pair n'a pas les formes déjà envoyées :
+     * l'image suivante est envoyée en entier. Si elle est de plus revenue au texte (serveur
+     * retrouvé qui refuse l'offre), le visiteur y revient aussi.
+     */
+    void terminer();
+
+    /**
+     * @name Méthodes de visite
+     * @{
+     */
+    void visite(const Cercle& cercle) override;
+    void visite(const Segment& segment) override;
+    void visite(const Polygone& polygone) override;
+    void visite(const Groupe& groupe) override;
+
+    /**
+     * @brief Dessine les formes du prototype, placées par la transformation de l'instance.
+     * @details Le prototype n'est pas copié. En mode différentiel, l'instance est suivie sous son
+     * propre identifiant : ses pièces ne sont renvoyées que si elle, son prototype ou ses
+     * ancêtres ont changé.
+     */
+    void visite(const Instance& instance) override;
+    /** @} */
+};
+
+#endif
@@ -1,11 +1,17 @@
 #ifndef VISITEUR_FORME_H
 #define VISITEUR_FORME_H
 
+#include <string>
+#include <vector>
+#include "Transformation2D.h"
+#include "Boite2D.h"
+
 // Forward declarations: telling the compiler these classes exist
 class Cercle;
 class Segment;
 class Polygone;
 class Groupe;
+class Instance;
 
 /**
  * Interface abstraite pour le Design Pattern Visitor.
@@ -18,6 +24,51 @@ public:
     virtual void visite(const Segment& segment) = 0;
     virtual void visite(const Polygone& polygone) = 0;
     virtual void visite(const Groupe& groupe) = 0;
+
+    /**
+     * Instance d'un groupe partagé. Par défaut, son prototype est visité tel quel, sans copie
+     * (visiterPrototype) : les visites reçoivent les formes du prototype, que placer() et
+     * couleurGroupe() situent dans la scène.
+     */
+    virtual void visite(const Instance& instance);
+
+protected:
+    /**
+     * @brief Visite le prototype partagé de @p instance, placé par sa transformation.
+     * @details Le prototype est reçu par visite(const Groupe&) ; jusqu'à la fin de sa visite,
+     * repere() compose la transformation de l'instance avec celle des instances englobantes.
+     */
+    void visiterPrototype(const Instance& instance);
+
+    /** @brief Vrai pendant la visite du prototype d'une instance. */
+    bool dansInstance() const { return _prototype != nullptr; }
+
+    /** @brief Similitude qui place les formes visitées dans la scène (identité hors d'une instance). */
+    const Transformation2D& repere() const { return _repere; }
+
+    /** @brief Point d'une forme visitée, placé dans la scène. */
+    Vecteur2D placer(const Vecteur2D& p) const { return _prototype ? _repere.appliquer(p) : p; }
+
+    /** @brief Longueur (rayon) d'une forme visitée, à l'échelle de la scène. */
+    double placer(double longueur) const { return _prototype ? longueur * _repere.echelle() : longueur; }
+
+    /** @brief Boîte d'une forme visitée, placée dans la scène (englobante, exacte sans rotation). */
+    Boite2D placer(const Boite2D& boite) const { return _prototype ? boite.transformee(_repere) : boite; }
+
+    /**
+     * @brief Sommets d'un polygone visité, placés dans la scène.
+     * @return Les sommets du polygone lui-même hors d'une instance ; sinon leurs images, écrites
+     * dans @p places (réutilisé d'un polygone à l'autre).
+     */
+    const Vecteur2D* placer(const Polygone& polygone, std::vector<Vecteur2D>& places) const;
+
+    /** @brief Couleur d'un groupe visité : celle de l'instance pour le prototype qu'elle montre. */
+    const std::string& couleurGroupe(const Groupe& groupe) const;
+
+private:
+    Transformation2D _repere;                      ///< Transformation des instances en cours de visite.
+    const Groupe* _prototype = nullptr;            ///< Prototype de l'instance la plus intérieure.
+    const std::string* _couleurInstance = nullptr; ///< Couleur de cette instance.
 };
 
-#endif
\ No newline at end of file
+#endif
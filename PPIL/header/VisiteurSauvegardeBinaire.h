@@ -0,0 +1,88 @@
+/**
+ * @file VisiteurSauvegardeBinaire.h
+ * @brief Visiteur concret pour la sauvegarde des formes au format binaire compact.
+ */
+
+#ifndef VISITEUR_SAUVEGARDE_BINAIRE_H
+#define VISITEUR_SAUVEGARDE_BINAIRE_H
+
+#include "VisiteurForme.h"
+#include "TamponFichier.h"
+#include "EncodeurSauvegarde.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include "vecteur2D.h"
+
+ /**
+  * @class VisiteurSauvegardeBinaire
+  * @brief Exporte les formes dans le format décrit par FormatBinaire.h.
+  * * Les réels sont écrits tels quels (aucune perte de précision), ou, si un pas de
+  * quantification est donné, arrondis à ce pas et codés en écarts (fichier bien plus petit,
+  * voir FormatBinaire.h). Chaque groupe est préfixé par la longueur de son contenu,
+  * complétée une fois ses enfants écrits.
+  * Le prototype d'une instance n'est écrit qu'une fois, au premier niveau du fichier, juste
+  * avant la forme de premier niveau qui l'utilise la première fois (même au fond d'un groupe) ;
+  * les instances n'en écrivent que le numéro. Les enregistrements sont écrits par
+  * EncodeurBinaire, qui définit le format.
+  */
+class VisiteurSauvegardeBinaire : public VisiteurForme {
+private:
+    TamponFichier _sortie; ///< Sortie tamponnée de la session de sauvegarde.
+    int _exceptionsEnCours; ///< std::uncaught_exceptions() à la construction.
+    EncodeurBinaire _encodeur; ///< Écrit l'en-tête et les enregistrements dans _sortie.
+    std::unordered_map<const Groupe*, std::uint32_t> _prototypes; ///< Numéros des prototypes déjà écrits.
+    std::size_t _profondeur = 0; ///< Nombre de groupes (ou prototypes) ouverts : 0 au premier niveau.
+
+    /** @brief Écrit les enregistrements des enfants de @p groupe. */
+    void ecrireEnfants(const Groupe& groupe);
+
+    /** @brief Écrit, au premier niveau, les prototypes pas encore écrits utilisés sous @p forme. */
+    void definirPrototypes(const Forme& forme);
+
+    /** @brief Écrit @p prototype s'il ne l'est pas encore, après les prototypes qu'il utilise. */
+    void definirPrototype(const Groupe& prototype);
+
+public:
+    /**
+     * @brief Constructeur : ouvre la session et écrit l'en-tête du fichier.
+     * @param nomFichier Chemin du fichier disque.
+     * @param seuilVidage Taille du tampon d'écriture en octets.
+     * @param pasQuantification Pas de la grille des coordonnées ; 0 (défaut) : réels exacts.
+     * @throw std::invalid_argument Si le pas est négatif ou non fini.
+     */
+    VisiteurSauvegardeBinaire(const std::string& nomFichier,
+                              std::size_t seuilVidage = TamponFichier::SEUIL_DEFAUT,
+                              double pasQuantification = 0);
+
+    /**
+     * @brief Destructeur virtuel.
+     * @details Valide la session si valider() n'a pas été appelée explicitement, sauf si le
+     * visiteur est détruit par une exception levée pendant la sauvegarde : le fichier
+     * temporaire, incomplet, est alors supprimé et la destination reste inchangée.
+     */
+    virtual ~VisiteurSauvegardeBinaire();
+
+    /**
+     * @brief Termine la sauvegarde et publie le fichier sous son nom définitif.
+     * @throw std::runtime_error En cas d'échec d'écriture ou de renommage.
+     */
+    void valider() { _sortie.valider(); }
+
+    /**
+     * @name Méthodes de visite
+     * @{
+     */
+    void visite(const Cercle& cercle) override;
+    void visite(const Segment& segment) override;
+    void visite(const Polygone& polygone) override;
+
+    /** @brief Sauvegarde un Groupe sous forme d'enregistrement imbriqué de longueur connue. */
+    void visite(const Groupe& groupe) override;
+
+    /** @brief Sauvegarde une instance : la référence à son prototype, puis sa transformation. */
+    void visite(const Instance& instance) override;
+    /** @} */
+};
+
+#endif
@@ -7,30 +7,50 @@
 #define VISITEUR_SAUVEGARDE_TEXTE_H
 
 #include "VisiteurForme.h"
+#include "TamponFichier.h"
+#include "EncodeurSauvegarde.h"
 #include <string>
-#include <fstream>
+#include <vector>
 
  /**
   * @class VisiteurSauvegardeTexte
   * @brief Implémente le Design Pattern Visitor pour l'exportation sur disque.
   * * Cette classe sépare l'algorithmique de sauvegarde de la structure des formes,
   * permettant ainsi d'envisager d'autres formats (XML, BDD) sans modifier les classes Forme.
+  * Le fichier est ouvert une seule fois par session et alimenté via un TamponFichier ;
+  * il n'apparaît sous son nom définitif qu'à la validation (renommage atomique).
+  * Les lignes sont écrites par EncodeurTexte, qui définit le format.
   */
 class VisiteurSauvegardeTexte : public VisiteurForme {
 private:
     std::string _nomFichier; ///< Nom du fichier texte de destination.
+    TamponFichier _sortie;   ///< Sortie tamponnée de la session de sauvegarde.
+    int _exceptionsEnCours; ///< std::uncaught_exceptions() à la construction.
+    EncodeurTexte _encodeur; ///< Écrit les lignes dans _sortie.
+    std::vector<Vecteur2D> _places; ///< Sommets placés d'un polygone d'instance.
 
 public:
     /**
      * @brief Constructeur du visiteur de sauvegarde.
      * @param nomFichier Chemin du fichier disque.
+     * @param seuilVidage Taille du tampon d'écriture en octets.
      */
-    VisiteurSauvegardeTexte(const std::string& nomFichier);
+    VisiteurSauvegardeTexte(const std::string& nomFichier,
+                            std::size_t seuilVidage = TamponFichier::SEUIL_DEFAUT);
 
     /**
      * @brief Destructeur virtuel.
+     * @details Valide la session si valider() n'a pas été appelée explicitement, sauf si le
+     * visiteur est détruit par une exception levée pendant la sauvegarde : le fichier
+     * temporaire, incomplet, est alors supprimé et la destination reste inchangée.
      */
-    virtual ~VisiteurSauvegardeTexte() {}
+    virtual ~VisiteurSauvegardeTexte();
+
+    /**
+     * @brief Termine la sauvegarde et publie le fichier sous son nom définitif.
+     * @throw std::runtime_error En cas d'échec d'écriture ou de renommage.
+     */
+    void valider() { _sortie.valider(); }
 
     /**
      * @name Méthodes de visite
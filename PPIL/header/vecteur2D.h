@@ -7,10 +7,10 @@
 #define VECTEUR_2D_H
 
 #include <iostream>
-#include <sstream>
 #include <string>
 #include <cmath>
 #include <cstdio> // Pour sscanf
+#include "FormatTexte.h"
 
  /**
   * @class Vecteur2D
@@ -42,12 +42,11 @@ public:
 
     /**
      * @brief Conversion du vecteur en chaîne de caractères.
-     * @return Une chaîne au format "(x,y)".
+     * @return Une chaîne au format "(x,y)", chaque réel relisible à l'identique.
      */
     operator std::string() const {
-        std::ostringstream os;
-        os << "(" << x << "," << y << ")";
-        return os.str();
+        char tampon[FormatTexte::TAILLE_MAX_POINT];
+        return std::string(tampon, FormatTexte::ecrirePoint(tampon, x, y));
     }
 
     // --- Opérations Algébriques ---
@@ -79,6 +78,11 @@ public:
         return Vecteur2D(-x, -y);
     }
 
+    /** @brief Égalité exacte des coordonnées. */
+    bool operator==(const Vecteur2D& v) const {
+        return x == v.x && y == v.y;
+    }
+
     /**
      * @brief Calcule le déterminant de deux vecteurs.
      * @details Crucial pour le calcul de l'aire des polygones.
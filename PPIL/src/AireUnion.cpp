@@ -0,0 +1,288 @@
+/**
+ * @file AireUnion.cpp
+ * @brief Bandes verticales, intersections des contours et intégration exacte de la réunion.
+ */
+
+#include "../header/AireUnion.h"
+#include "../header/VisiteurForme.h"
+#include "../header/Cercle.h"
+#include "../header/Segement.h"
+#include "../header/Polygone.h"
+#include "../header/Group.h"
+#include "../header/PoolThreads.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    /** @brief Côtés ou cercles traités par tâche lors de la recherche des intersections. */
+    const std::size_t PRIMITIVES_PAR_PAQUET = 1024;
+
+    /** @brief Ajoute les formes simples visitées à l'ensemble, placées dans la scène. */
+    class CollecteurUnion : public VisiteurForme {
+    private:
+        AireUnion& _union;
+        std::vector<Vecteur2D> _places; ///< Sommets d'un polygone d'instance, placés.
+
+    public:
+        explicit CollecteurUnion(AireUnion& u) : _union(u) {}
+
+        void visite(const Cercle& cercle) override {
+            _union.ajouterCercle(placer(cercle.getCentre()), placer(cercle.getRayon()));
+        }
+
+        void visite(const Segment&) override {}
+
+        void visite(const Polygone& polygone) override {
+            _union.ajouterPolygone(placer(polygone, _places), polygone.getSommets().size());
+        }
+
+        void visite(const Groupe& groupe) override {
+            for (const Forme* f : groupe.getFormes()) f->accepte(this);
+        }
+    };
+
+    /** @brief Primitive de sqrt(r² - u²). */
+    double primitiveArc(double u, double r) {
+        const double s = std::clamp(u / r, -1.0, 1.0);
+        return 0.5 * (u * std::sqrt(std::max(0.0, r * r - u * u)) + r * r * std::asin(s));
+    }
+
+    double produitVectoriel(double ax, double ay, double bx, double by) { return ax * by - ay * bx; }
+}
+
+void AireUnion::ajouter(const Forme& f) {
+    CollecteurUnion c(*this);
+    f.accepte(&c);
+}
+
+void AireUnion::ajouterPolygone(const Vecteur2D* sommets, std::size_t n) {
+    if (n < 3) return;
+    const std::uint32_t forme = _nbFormes++;
+    for (std::size_t i = 0; i < n; ++i) {
+        const Vecteur2D& p = sommets[i];
+        const Vecteur2D& q = sommets[(i + 1) % n];
+        // Un côté vertical ne traverse aucune bande ; son abscisse est déjà une borne.
+        if (!(p.x != q.x)) continue;
+        const Vecteur2D& g = p.x < q.x ? p : q;
+        const Vecteur2D& d = p.x < q.x ? q : p;
+        _courbes.push_back(Courbe{ g.x, d.x, g.y, (d.y - g.y) / (d.x - g.x), 0, forme,
+                                   static_cast<std::int8_t>(q.x > p.x ? 1 : -1), DROITE });
+        _primitives.push_back(Primitive{ g.x, std::min(p.y, q.y), d.x, std::max(p.y, q.y), p, q, false });
+    }
+}
+
+void AireUnion::ajouterCercle(const Vecteur2D& centre, double rayon) {
+    if (!(rayon > 0)) return;
+    const std::uint32_t forme = _nbFormes++;
+    const double x0 = centre.x - rayon, x1 = centre.x + rayon;
+    // Parcours trigonométrique : la moitié basse va vers les x croissants.
+    _courbes.push_back(Courbe{ x0, x1, centre.x, centre.y, rayon, forme, 1, ARC_BAS });
+    _courbes.push_back(Courbe{ x0, x1, centre.x, centre.y, rayon, forme, -1, ARC_HAUT });
+    _primitives.push_back(Primitive{ x0, centre.y - rayon, x1, centre.y + rayon, centre, Vecteur2D(rayon, 0), true });
+}
+
+double AireUnion::ordonnee(const Courbe& k, double x) {
+    if (k.type == DROITE) return k.a + k.b * (x - k.x0);
+    const double u = x - k.a;
+    const double h = std::sqrt(std::max(0.0, k.c * k.c - u * u));
+    return k.type == ARC_HAUT ? k.b + h : k.b - h;
+}
+
+double AireUnion::integrale(const Courbe& k, double xg, double xd, double yMilieu) {
+    // Une droite est intégrée exactement par sa valeur au milieu.
+    if (k.type == DROITE) return (xd - xg) * yMilieu;
+    const double arc = primitiveArc(xd - k.a, k.c) - primitiveArc(xg - k.a, k.c);
+    return k.b * (xd - xg) + (k.type == ARC_HAUT ? arc : -arc);
+}
+
+void AireUnion::intersections(const Primitive& i, const Primitive& j, std::vector<double>& xs) {
+    const double xmin = std::max(i.xmin, j.xmin), xmax = std::min(i.xmax, j.xmax);
+    auto retenir = [&](double x) { if (x >= xmin && x <= xmax) xs.push_back(x); };
+
+    if (!i.cercle && !j.cercle) {
+        const double rx = i.q.x - i.p.x, ry = i.q.y - i.p.y;
+        const double sx = j.q.x - j.p.x, sy = j.q.y - j.p.y;
+        const double rs = produitVectoriel(rx, ry, sx, sy);
+        if (rs == 0) return; // Parallèles : aucun croisement à l'intérieur d'une bande.
+        const double ex = j.p.x - i.p.x, ey = j.p.y - i.p.y;
+        const double t = produitVectoriel(ex, ey, sx, sy) / rs;
+        const double u = produitVectoriel(ex, ey, rx, ry) / rs;
+        if (t >= 0 && t <= 1 && u >= 0 && u <= 1) retenir(i.p.x + t * rx);
+        return;
+    }
+
+    if (i.cercle && j.cercle) {
+        const double dx = j.p.x - i.p.x, dy = j.p.y - i.p.y;
+        const double r1 = i.q.x, r2 = j.q.x;
+        const double d = std::hypot(dx, dy);
+        if (d == 0 || d > r1 + r2 || d < std::abs(r1 - r2)) return;
+        const double a = (r1 * r1 - r2 * r2 + d * d) / (2 * d);
+        const double h = std::sqrt(std::max(0.0, r1 * r1 - a * a));
+        const double mx = i.p.x + a * dx / d;
+        retenir(mx + h * dy / d);
+        retenir(mx - h * dy / d);
+        return;
+    }
+
+    // Côté et cercle : |p + t.(q - p) - c|² = r², t dans [0, 1].
+    const Primitive& s = i.cercle ? j : i;
+    const Primitive& c = i.cercle ? i : j;
+    const double dx = s.q.x - s.p.x, dy = s.q.y - s.p.y;
+    const double fx = s.p.x - c.p.x, fy = s.p.y - c.p.y;
+    const double A = dx * dx + dy * dy;
+    const double B = 2 * (fx * dx + fy * dy);
+    const double C = fx * fx + fy * fy - c.q.x * c.q.x;
+    const double discriminant = B * B - 4 * A * C;
+    if (A == 0 || discriminant < 0) return;
+    const double racine = std::sqrt(discriminant);
+    for (double t : { (-B - racine) / (2 * A), (-B + racine) / (2 * A) }) {
+        if (t >= 0 && t <= 1) retenir(s.p.x + t * dx);
+    }
+}
+
+std::vector<double> AireUnion::bornes(const std::vector<Courbe>& courbes, PoolThreads* pool) const {
+    std::vector<double> xs;
+    xs.reserve(2 * courbes.size());
+    for (const Courbe& k : courbes) {
+        xs.push_back(k.x0);
+        xs.push_back(k.x1);
+    }
+
+    std::vector<Primitive> primitives(_primitives);
+    std::sort(primitives.begin(), primitives.end(),
+              [](const Primitive& a, const Primitive& b) { return a.xmin < b.xmin; });
+    const std::size_t n = primitives.size();
+
+    // Paires dont les boîtes se chevauchent : j parcourt les primitives qui commencent avant la fin de i.
+    auto chercher = [&](std::size_t debut, std::size_t fin, std::vector<double>& sortie) {
+        for (std::size_t i = debut; i < fin; ++i) {
+            const Primitive& a = primitives[i];
+            for (std::size_t j = i + 1; j < n && primitives[j].xmin <= a.xmax; ++j) {
+                const Primitive& b = primitives[j];
+                if (b.ymin <= a.ymax && a.ymin <= b.ymax) intersections(a, b, sortie);
+            }
+        }
+    };
+
+    if (pool && n > PRIMITIVES_PAR_PAQUET) {
+        const std::size_t nbPaquets = (n + PRIMITIVES_PAR_PAQUET - 1) / PRIMITIVES_PAR_PAQUET;
+        std::vector<std::vector<double>> parties(nbPaquets);
+        pool->executer(nbPaquets, [&](std::size_t p) {
+            chercher(p * PRIMITIVES_PAR_PAQUET, std::min(n, (p + 1) * PRIMITIVES_PAR_PAQUET), parties[p]);
+        });
+        for (const auto& partie : parties) xs.insert(xs.end(), partie.begin(), partie.end());
+    }
+    else {
+        chercher(0, n, xs);
+    }
+
+    std::sort(xs.begin(), xs.end());
+    xs.erase(std::unique(xs.begin(), xs.end()), xs.end());
+    return xs;
+}
+
+void AireUnion::balayer(const std::vector<Courbe>& courbes, const std::vector<double>& xs,
+                        std::size_t debut, std::size_t fin, std::vector<double>& sommes) const {
+    struct Actif {
+        double y;
+        std::uint32_t indice; ///< Indice dans courbes, qui départage les ordonnées égales.
+    };
+    auto avant = [](const Actif& a, const Actif& b) { return a.y < b.y || (a.y == b.y && a.indice < b.indice); };
+
+    std::size_t b = debut * BANDES_PAR_PAQUET;
+    const std::size_t derniere = std::min(xs.size() - 1, fin * BANDES_PAR_PAQUET);
+    if (b >= derniere) return;
+
+    // Contours commencés avant la première bande du paquet et qui la traversent.
+    std::vector<Actif> actifs;
+    std::size_t prochain = static_cast<std::size_t>(std::upper_bound(courbes.begin(), courbes.end(), xs[b],
+        [](double x, const Courbe& k) { return x < k.x0; }) - courbes.begin());
+    for (std::size_t i = 0; i < prochain; ++i) {
+        if (courbes[i].x1 > xs[b]) actifs.push_back(Actif{ 0, static_cast<std::uint32_t>(i) });
+    }
+    std::size_t nbTries = 0;
+
+    std::vector<int> enroulement(_nbFormes, 0);
+
+    for (; b < derniere; ++b) {
+        const double xg = xs[b], xd = xs[b + 1], xm = (xg + xd) / 2;
+
+        // Les bornes contiennent toutes les extrémités : un contour traverse la bande entière ou pas du tout.
+        std::size_t conserves = 0, triesConserves = 0;
+        for (std::size_t i = 0; i < actifs.size(); ++i) {
+            if (courbes[actifs[i].indice].x1 <= xg) continue;
+            if (i < nbTries) ++triesConserves;
+            actifs[conserves++] = actifs[i];
+        }
+        actifs.resize(conserves);
+        nbTries = triesConserves;
+        for (; prochain < courbes.size() && courbes[prochain].x0 <= xg; ++prochain) {
+            if (courbes[prochain].x1 > xg) actifs.push_back(Actif{ 0, static_cast<std::uint32_t>(prochain) });
+        }
+        if (actifs.empty()) continue;
+
+        for (Actif& a : actifs) a.y = ordonnee(courbes[a.indice], xm);
+
+        // L'ordre de la bande précédente ne change qu'aux croisements : tri par insertion,
+        // puis fusion avec les contours qui commencent ici.
+        for (std::size_t i = 1; i < nbTries; ++i) {
+            const Actif v = actifs[i];
+            std::size_t j = i;
+            for (; j > 0 && avant(v, actifs[j - 1]); --j) actifs[j] = actifs[j - 1];
+            actifs[j] = v;
+        }
+        const auto milieu = actifs.begin() + static_cast<std::ptrdiff_t>(nbTries);
+        std::sort(milieu, actifs.end(), avant);
+        std::inplace_merge(actifs.begin(), milieu, actifs.end(), avant);
+        nbTries = actifs.size();
+
+        // De bas en haut : un intervalle est couvert tant qu'au moins une forme a un enroulement non nul.
+        double aire = 0;
+        int couvertes = 0;
+        const Actif* bas = nullptr;
+        for (const Actif& a : actifs) {
+            const Courbe& k = courbes[a.indice];
+            int& w = enroulement[k.forme];
+            const int ancien = w;
+            w += k.sens;
+            if (ancien == 0 && w != 0) {
+                if (couvertes++ == 0) bas = &a;
+            }
+            else if (ancien != 0 && w == 0) {
+                if (--couvertes == 0) {
+                    aire += integrale(k, xg, xd, a.y) - integrale(courbes[bas->indice], xg, xd, bas->y);
+                }
+            }
+        }
+        for (const Actif& a : actifs) enroulement[courbes[a.indice].forme] = 0;
+        sommes[b / BANDES_PAR_PAQUET] += aire;
+    }
+}
+
+double AireUnion::calculer(PoolThreads* pool) const {
+    if (_courbes.empty()) return 0;
+
+    std::vector<Courbe> courbes(_courbes);
+    std::stable_sort(courbes.begin(), courbes.end(), [](const Courbe& a, const Courbe& b) { return a.x0 < b.x0; });
+    const std::vector<double> xs = bornes(courbes, pool);
+    if (xs.size() < 2) return 0;
+
+    const std::size_t nbBandes = xs.size() - 1;
+    const std::size_t nbPaquets = (nbBandes + BANDES_PAR_PAQUET - 1) / BANDES_PAR_PAQUET;
+    std::vector<double> sommes(nbPaquets, 0.0);
+
+    if (pool && nbPaquets > 1) {
+        // Blocs de paquets consécutifs : chaque bloc ne reconstruit ses contours actifs qu'une fois.
+        const std::size_t nbBlocs = std::min(nbPaquets, 4 * pool->taille());
+        pool->executer(nbBlocs, [&](std::size_t i) {
+            balayer(courbes, xs, i * nbPaquets / nbBlocs, (i + 1) * nbPaquets / nbBlocs, sommes);
+        });
+    }
+    else {
+        balayer(courbes, xs, 0, nbPaquets, sommes);
+    }
+
+    double aire = 0;
+    for (double s : sommes) aire += s;
+    return aire;
+}
@@ -0,0 +1,67 @@
+/**
+ * @file ArenaFormes.cpp
+ * @brief Gestion des blocs de l'arène.
+ */
+
+#include "../header/ArenaFormes.h"
+#include "../header/Group.h"
+#include <algorithm>
+#include <cstdlib>
+#include <typeinfo>
+
+void ArenaFormes::nouveauBloc(std::size_t taille) {
+    // Une allocation plus grande qu'un bloc ordinaire reçoit un bloc à sa mesure.
+    std::size_t tailleBloc = std::max(_tailleBloc, taille);
+    void* bloc = std::malloc(tailleBloc);
+    if (!bloc) throw std::bad_alloc();
+    _blocs.push_back(bloc);
+    const std::uintptr_t debut = reinterpret_cast<std::uintptr_t>(bloc);
+    const std::pair<std::uintptr_t, std::uintptr_t> bornes(debut, debut + tailleBloc);
+    _bornes.insert(std::upper_bound(_bornes.begin(), _bornes.end(), bornes), bornes);
+    _courant = static_cast<char*>(bloc);
+    _finBloc = _courant + tailleBloc;
+    _tailleBloc = std::min(_tailleBloc * 2, TAILLE_BLOC_MAX);
+}
+
+void ArenaFormes::liberer() {
+    for (void* bloc : _blocs) std::free(bloc);
+    _blocs.clear();
+    _bornes.clear();
+    _courant = _finBloc = nullptr;
+    _tailleBloc = TAILLE_BLOC_INITIALE;
+    _utilise = 0;
+}
+
+void ArenaFormes::recommencer() {
+    if (_blocs.empty()) return;
+    void* garde = _blocs.back();
+    const std::size_t tailleGarde = static_cast<std::size_t>(_finBloc - static_cast<char*>(garde));
+    _blocs.pop_back();
+    for (void* bloc : _blocs) std::free(bloc);
+    _blocs.assign(1, garde);
+    const std::uintptr_t debut = reinterpret_cast<std::uintptr_t>(garde);
+    _bornes.assign(1, { debut, debut + tailleGarde });
+    _courant = static_cast<char*>(garde);
+    _finBloc = _courant + tailleGarde;
+    _utilise = 0;
+}
+
+bool ArenaFormes::contient(const void* p) const {
+    const std::uintptr_t a = reinterpret_cast<std::uintptr_t>(p);
+    // Dernier bloc commençant au plus tard en a.
+    auto it = std::upper_bound(_bornes.begin(), _bornes.end(), a,
+                               [](std::uintptr_t x, const std::pair<std::uintptr_t, std::uintptr_t>& b) { return x < b.first; });
+    return it != _bornes.begin() && a < (it - 1)->second;
+}
+
+void ArenaFormes::detruire(Forme* f) {
+    if (!f) return;
+    if (typeid(*f) == typeid(Groupe)) { // Groupe n'a pas de classe dérivée.
+        // Le groupe détruirait ses enfants par delete : ils sont détachés et traités ici.
+        Groupe* g = static_cast<Groupe*>(f);
+        for (Forme* enfant : g->_formes) detruire(enfant);
+        g->_formes.clear();
+    }
+    if (contient(f)) f->~Forme();
+    else delete f;
+}
@@ -0,0 +1,205 @@
+/**
+ * @file ChargeurBinaire.cpp
+ * @brief Implémentation du chargement des scènes au format binaire.
+ */
+
+#include "../header/ChargeurBinaire.h"
+#include "../header/FormatBinaire.h"
+#include "../header/Cercle.h"
+#include "../header/Segement.h"
+#include "../header/Polygone.h"
+#include "../header/Group.h"
+#include "../header/Instance.h"
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+
+namespace {
+
+    /** @brief Curseur borné sur le contenu binaire. */
+    struct Curseur {
+        const char* p;
+        const char* fin;
+        double pas = 0; ///< Pas de quantification, ou 0 : réels en clair.
+
+        void exiger(std::size_t n) const {
+            if (static_cast<std::size_t>(fin - p) < n) {
+                throw std::runtime_error("Fichier binaire tronqué ou corrompu");
+            }
+        }
+
+        template <typename T>
+        T lire() {
+            exiger(sizeof(T));
+            T v = FormatBinaire::decoder<T>(p);
+            p += sizeof(T);
+            return v;
+        }
+
+        double lireReel() {
+            exiger(8);
+            double v = FormatBinaire::decoderReel(p);
+            p += 8;
+            return v;
+        }
+
+        std::uint64_t lireVarint() {
+            std::uint64_t v = 0;
+            for (int decalage = 0; decalage < 64; decalage += 7) {
+                const std::uint8_t o = lire<std::uint8_t>();
+                v |= static_cast<std::uint64_t>(o & 0x7F) << decalage;
+                if (!(o & 0x80)) return v;
+            }
+            throw std::runtime_error("Entier trop long dans le fichier binaire");
+        }
+
+        /** @brief Point suivant d'un enregistrement ; @p precedent est le point précédent, en pas. */
+        Vecteur2D lirePoint(std::int64_t (&precedent)[2]) {
+            if (!pas) {
+                double x = lireReel();
+                double y = lireReel();
+                return Vecteur2D(x, y);
+            }
+            // Arithmétique non signée : un fichier corrompu ne provoque pas de dépassement signé.
+            for (std::int64_t& c : precedent) {
+                c = static_cast<std::int64_t>(static_cast<std::uint64_t>(c) +
+                                              static_cast<std::uint64_t>(FormatBinaire::dezigzag(lireVarint())));
+            }
+            return Vecteur2D(static_cast<double>(precedent[0]) * pas, static_cast<double>(precedent[1]) * pas);
+        }
+
+        double lireRayon() {
+            const double r = pas ? static_cast<double>(FormatBinaire::dezigzag(lireVarint())) * pas : lireReel();
+            if (!(r > 0)) throw std::runtime_error("Rayon invalide dans le fichier binaire");
+            return r;
+        }
+
+        std::string lireCouleur() {
+            std::uint8_t indice = lire<std::uint8_t>();
+            if (indice < FormatBinaire::TAILLE_PALETTE) return FormatBinaire::couleurPalette(indice);
+            if (indice != FormatBinaire::COULEUR_LIBRE) {
+                throw std::runtime_error("Indice de couleur inconnu dans le fichier binaire");
+            }
+            std::uint16_t longueur = lire<std::uint16_t>();
+            exiger(longueur);
+            std::string couleur(p, longueur);
+            p += longueur;
+            return couleur;
+        }
+    };
+
+    /**
+     * @brief Lit un enregistrement complet (récursivement pour les groupes).
+     * @return La forme lue, ou nullptr pour une définition de prototype.
+     */
+    Forme* lireForme(Curseur& c, ChargeurBinaire::Prototypes& prototypes) {
+        std::uint8_t etiquette = c.lire<std::uint8_t>();
+        std::string couleur = c.lireCouleur();
+        switch (etiquette) {
+        case FormatBinaire::CERCLE: {
+            std::int64_t precedent[2] = {};
+            Vecteur2D centre = c.lirePoint(precedent);
+            double r = c.lireRayon();
+            return new Cercle(centre, r, couleur);
+        }
+        case FormatBinaire::SEGMENT: {
+            std::int64_t precedent[2] = {};
+            Vecteur2D p1 = c.lirePoint(precedent);
+            Vecteur2D p2 = c.lirePoint(precedent);
+            return new Segment(p1, p2, couleur);
+        }
+        case FormatBinaire::POLYGONE: {
+            // Chaque sommet occupe au moins 16 octets en clair, 2 quantifié : borne avant d'allouer.
+            std::uint64_t n = c.pas ? c.lireVarint() : c.lire<std::uint32_t>();
+            if (n > static_cast<std::uint64_t>(c.fin - c.p) / (c.pas ? 2 : 16)) {
+                throw std::runtime_error("Fichier binaire tronqué ou corrompu");
+            }
+            std::vector<Vecteur2D> sommets;
+            sommets.reserve(static_cast<std::size_t>(n));
+            std::int64_t precedent[2] = {};
+            for (std::uint64_t i = 0; i < n; ++i) sommets.push_back(c.lirePoint(precedent));
+            return new Polygone(std::move(sommets), couleur);
+        }
+        case FormatBinaire::GROUPE: {
+            std::uint64_t longueur = c.lire<std::uint64_t>();
+            c.exiger(static_cast<std::size_t>(longueur));
+            std::unique_ptr<Groupe> groupe(new Groupe(couleur));
+            ChargeurBinaire::chargerEnfants(c.p, static_cast<std::size_t>(longueur), *groupe, prototypes, c.pas);
+            c.p += longueur;
+            return groupe.release();
+        }
+        case FormatBinaire::PROTOTYPE: {
+            std::uint32_t numero = c.lire<std::uint32_t>();
+            std::uint64_t longueur = c.lire<std::uint64_t>();
+            c.exiger(static_cast<std::size_t>(longueur));
+            if (numero != prototypes.size()) {
+                throw std::runtime_error("Numéro de prototype inattendu dans le fichier binaire");
+            }
+            prototypes.emplace_back(); // Réservé : ses enfants peuvent définir d'autres prototypes.
+            std::unique_ptr<Groupe> groupe(new Groupe(couleur));
+            ChargeurBinaire::chargerEnfants(c.p, static_cast<std::size_t>(longueur), *groupe, prototypes, c.pas);
+            c.p += longueur;
+            prototypes[numero] = std::move(groupe);
+            return nullptr;
+        }
+        case FormatBinaire::INSTANCE: {
+            std::uint32_t numero = c.lire<std::uint32_t>();
+            if (numero >= prototypes.size() || !prototypes[numero]) {
+                throw std::runtime_error("Instance d'un prototype non défini dans le fichier binaire");
+            }
+            double m[6];
+            for (double& v : m) v = c.lireReel();
+            return new Instance(prototypes[numero], Transformation2D(m[0], m[1], m[2], m[3], m[4], m[5]), couleur);
+        }
+        default:
+            throw std::runtime_error("Étiquette d'enregistrement inconnue dans le fichier binaire");
+        }
+    }
+}
+
+void ChargeurBinaire::chargerEnfants(const char* donnees, std::size_t taille, Groupe& groupe, Prototypes& prototypes,
+                                     double pas) {
+    Curseur c{ donnees, donnees + taille, pas };
+    while (c.p < c.fin) {
+        if (Forme* f = lireForme(c, prototypes)) groupe.ajouter(f);
+    }
+}
+
+std::vector<Forme*> ChargeurBinaire::chargerMemoire(const char* donnees, std::size_t taille) {
+    Curseur c{ donnees, donnees + taille };
+    c.exiger(FormatBinaire::TAILLE_EN_TETE);
+    const std::uint16_t drapeaux = FormatBinaire::lireEnTete(c.p);
+    c.p += FormatBinaire::TAILLE_EN_TETE;
+    if (drapeaux & FormatBinaire::QUANTIFIE) {
+        c.exiger(8);
+        c.pas = FormatBinaire::lirePas(c.p);
+        c.p += 8;
+    }
+
+    std::vector<Forme*> formes;
+    Prototypes prototypes;
+    try {
+        while (c.p < c.fin) {
+            if (Forme* f = lireForme(c, prototypes)) formes.push_back(f);
+        }
+    }
+    catch (...) {
+        for (Forme* f : formes) delete f;
+        throw;
+    }
+    return formes;
+}
+
+std::vector<Forme*> ChargeurBinaire::chargerFichier(const std::string& nomFichier) {
+    std::ifstream ifs(nomFichier, std::ios::binary | std::ios::ate);
+    if (!ifs) {
+        throw std::runtime_error("Impossible d'ouvrir le fichier : " + nomFichier);
+    }
+    std::string contenu(static_cast<std::size_t>(ifs.tellg()), '\0');
+    ifs.seekg(0);
+    ifs.read(contenu.data(), static_cast<std::streamsize>(contenu.size()));
+    if (!ifs) {
+        throw std::runtime_error("Lecture incomplète du fichier : " + nomFichier);
+    }
+    return chargerMemoire(contenu.data(), contenu.size());
+}
@@ -0,0 +1,147 @@
+/**
+ * @file ChargeurTexteMmap.cpp
+ * @brief Implémentation du chargeur texte par projection mémoire.
+ */
+
+#include "../header/ChargeurTexteMmap.h"
+#include "../header/FichierMappe.h"
+#include "../header/AnalyseTexte.h"
+#include "../header/Cercle.h"
+#include "../header/Segement.h"
+#include "../header/Polygone.h"
+#include "../header/Group.h"
+#include <array>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+    /** @brief Nature d'une ligne, déterminée par son préfixe. */
+    enum TypeLigne : unsigned char {
+        INCONNUE,
+        CERCLE,
+        SEGMENT,
+        POLYGONE,
+        GROUPE
+    };
+
+    /** @brief Entrée de la table de répartition : préfixe complet attendu et type associé. */
+    struct Entree {
+        std::string_view prefixe;
+        TypeLigne type;
+    };
+
+    /** @brief Table indexée par le premier octet de la ligne (les préfixes ont des initiales distinctes). */
+    constexpr std::array<Entree, 256> construireTable() {
+        std::array<Entree, 256> table{};
+        table['C'] = { AnalyseTexte::PREFIXE_CERCLE, CERCLE };
+        table['S'] = { AnalyseTexte::PREFIXE_SEGMENT, SEGMENT };
+        table['P'] = { AnalyseTexte::PREFIXE_POLYGONE, POLYGONE };
+        table['G'] = { AnalyseTexte::PREFIXE_GROUPE, GROUPE };
+        return table;
+    }
+
+    constexpr std::array<Entree, 256> TABLE = construireTable();
+
+    /** @brief Numéro (à partir de 1) de la ligne commençant en @p ligne, pour les messages d'erreur. */
+    std::size_t numeroLigne(const char* debut, const char* ligne) {
+        std::size_t n = 1;
+        for (const char* p = debut; p < ligne; ++p) n += (*p == '\n');
+        return n;
+    }
+}
+
+std::vector<Forme*> ChargeurTexteMmap::chargerFichier(const std::string& nomFichier) const {
+    FichierMappe fichier(nomFichier);
+    return chargerMemoire(fichier.debut(), fichier.fin());
+}
+
+std::vector<Forme*> ChargeurTexteMmap::chargerMemoire(const char* debut, const char* fin) const {
+    std::vector<Forme*> racines;
+    std::vector<Groupe*> pile;               // Groupes ouverts (déjà rattachés à leur parent).
+    std::vector<Vecteur2D> sommets;          // Tampon réutilisé pour les polygones.
+
+    auto rattacher = [&](Forme* f) {
+        if (pile.empty()) racines.push_back(f);
+        else pile.back()->ajouter(f);
+    };
+    auto erreur = [&](const char* ligne, const char* message) {
+        throw std::runtime_error(std::string(message) + " (ligne "
+                                 + std::to_string(numeroLigne(debut, ligne)) + ")");
+    };
+
+    try {
+        const char* p = debut;
+        while (p < fin) {
+            const char* finLigne = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(fin - p)));
+            if (!finLigne) finLigne = fin;
+            std::string_view ligne = AnalyseTexte::sansRetourChariot(
+                std::string_view(p, static_cast<std::size_t>(finLigne - p)));
+            const char* debutLigne = p;
+            p = finLigne + 1;
+            if (ligne.empty()) continue;
+
+            const Entree& e = TABLE[static_cast<unsigned char>(ligne[0])];
+            bool reconnue = false;
+            if (e.type != INCONNUE && ligne.starts_with(e.prefixe)) {
+                std::string_view corps = ligne.substr(e.prefixe.size());
+                std::string_view couleur;
+                switch (e.type) {
+                case CERCLE: {
+                    Vecteur2D centre;
+                    double rayon;
+                    if (AnalyseTexte::analyserCercle(corps, couleur, centre, rayon)) {
+                        rattacher(new Cercle(centre, rayon, std::string(couleur)));
+                        reconnue = true;
+                    }
+                    break;
+                }
+                case SEGMENT: {
+                    Vecteur2D p1, p2;
+                    if (AnalyseTexte::analyserSegment(corps, couleur, p1, p2)) {
+                        rattacher(new Segment(p1, p2, std::string(couleur)));
+                        reconnue = true;
+                    }
+                    break;
+                }
+                case POLYGONE:
+                    sommets.clear();
+                    if (AnalyseTexte::analyserPolygone(corps, couleur, sommets)) {
+                        rattacher(new Polygone(sommets, std::string(couleur)));
+                        reconnue = true;
+                    }
+                    break;
+                case GROUPE:
+                    if (corps.starts_with(AnalyseTexte::MARQUEUR_DEBUT)) {
+                        Groupe* g = new Groupe(std::string(corps.substr(AnalyseTexte::MARQUEUR_DEBUT.size())));
+                        rattacher(g);
+                        pile.push_back(g);
+                        reconnue = true;
+                    }
+                    else if (corps == AnalyseTexte::MARQUEUR_FIN) {
+                        if (pile.empty()) erreur(debutLigne, "Groupe;Fin sans Groupe;Debut correspondant");
+                        pile.pop_back();
+                        reconnue = true;
+                    }
+                    break;
+                default:
+                    break;
+                }
+            }
+
+            if (!reconnue) {
+                // Seules les lignes inconnues paient le prix d'une std::string.
+                Forme* f = _secours ? _secours->charger(std::string(ligne)) : nullptr;
+                if (!f) erreur(debutLigne, "Ligne non reconnue");
+                rattacher(f);
+            }
+        }
+        if (!pile.empty()) erreur(fin, "Groupe;Debut sans Groupe;Fin correspondant");
+    }
+    catch (...) {
+        // Les groupes ouverts sont déjà rattachés : libérer les racines suffit.
+        for (Forme* f : racines) delete f;
+        throw;
+    }
+    return racines;
+}
@@ -0,0 +1,142 @@
+/**
+ * @file ChargeurTexteParallele.cpp
+ * @brief Implémentation du chargement multi-thread du format texte.
+ */
+
+#include "../header/ChargeurTexteParallele.h"
+#include "../header/ChargeurTexteMmap.h"
+#include "../header/FichierMappe.h"
+#include "../header/AnalyseTexte.h"
+#include "../header/Group.h"
+#include <cstring>
+#include <string_view>
+
+namespace {
+
+    /** @brief En dessous de cette taille, le découpage coûte plus qu'il ne rapporte. */
+    const std::size_t TAILLE_MIN_PARALLELE = std::size_t(1) << 20;
+
+    /** @brief Nombre de tranches par thread, pour lisser les écarts de charge. */
+    const std::size_t TRANCHES_PAR_THREAD = 4;
+
+    /** @brief Nombre maximal de groupes englobants traversés pour trouver un découpage. */
+    const int PROFONDEUR_MAX_ENVELOPPES = 8;
+
+    /** @brief Rôle d'une ligne dans l'imbrication des groupes. */
+    enum Nature { AUTRE, VIDE, DEBUT, FIN };
+
+    Nature nature(std::string_view ligne) {
+        ligne = AnalyseTexte::sansRetourChariot(ligne);
+        if (ligne.empty()) return VIDE;
+        if (ligne[0] != 'G' || !ligne.starts_with(AnalyseTexte::PREFIXE_GROUPE)) return AUTRE;
+        std::string_view corps = ligne.substr(AnalyseTexte::PREFIXE_GROUPE.size());
+        if (corps.starts_with(AnalyseTexte::MARQUEUR_DEBUT)) return DEBUT;
+        if (corps == AnalyseTexte::MARQUEUR_FIN) return FIN;
+        return AUTRE;
+    }
+
+    /** @brief Résultat du repérage des formes de premier niveau d'une zone. */
+    struct Reperage {
+        std::vector<const char*> debuts; ///< Début de chaque forme de premier niveau.
+        const char* derniereFin;         ///< Début de la ligne Groupe;Fin fermant la dernière forme (si groupe).
+    };
+
+    /**
+     * @brief Repère les formes de premier niveau de [debut, fin).
+     * @return false si l'imbrication des groupes est incorrecte.
+     */
+    bool reperer(const char* debut, const char* fin, Reperage& r) {
+        r.debuts.clear();
+        r.derniereFin = nullptr;
+        long profondeur = 0;
+        const char* p = debut;
+        while (p < fin) {
+            const char* finLigne = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(fin - p)));
+            if (!finLigne) finLigne = fin;
+            Nature n = nature(std::string_view(p, static_cast<std::size_t>(finLigne - p)));
+            if (n != VIDE && profondeur == 0) {
+                r.debuts.push_back(p);
+                r.derniereFin = nullptr;
+            }
+            if (n == DEBUT) ++profondeur;
+            else if (n == FIN) {
+                if (--profondeur < 0) return false;
+                if (profondeur == 0) r.derniereFin = p;
+            }
+            p = finLigne + 1;
+        }
+        return profondeur == 0;
+    }
+}
+
+std::vector<Forme*> ChargeurTexteParallele::chargerFichier(const std::string& nomFichier) const {
+    FichierMappe fichier(nomFichier);
+    return chargerMemoire(fichier.debut(), fichier.fin());
+}
+
+std::vector<Forme*> ChargeurTexteParallele::chargerMemoire(const char* debut, const char* fin) const {
+    // Une chaîne de secours par analyse : les maillons ne sont pas partagés entre threads.
+    auto analyser = [this](const char* d, const char* f) {
+        const ChargeurTexteMmap chargeur(_secours ? _secours() : nullptr);
+        return chargeur.chargerMemoire(d, f);
+    };
+    if (_pool.taille() < 2 || static_cast<std::size_t>(fin - debut) < TAILLE_MIN_PARALLELE) {
+        return analyser(debut, fin);
+    }
+
+    // 1. Traverse les groupes englobants uniques jusqu'à obtenir plusieurs formes à répartir.
+    std::vector<std::string> enveloppes;
+    const char* d = debut;
+    const char* f = fin;
+    Reperage r;
+    for (;;) {
+        if (!reperer(d, f, r)) {
+            // Imbrication incorrecte : le chargeur séquentiel produit le diagnostic exact.
+            return analyser(debut, fin);
+        }
+        if (r.debuts.size() != 1 || !r.derniereFin
+            || static_cast<int>(enveloppes.size()) >= PROFONDEUR_MAX_ENVELOPPES) break;
+        const char* finPremiere = static_cast<const char*>(
+            std::memchr(r.debuts[0], '\n', static_cast<std::size_t>(f - r.debuts[0])));
+        std::string_view entete = AnalyseTexte::sansRetourChariot(
+            std::string_view(r.debuts[0], static_cast<std::size_t>(finPremiere - r.debuts[0])));
+        enveloppes.emplace_back(entete.substr(AnalyseTexte::PREFIXE_GROUPE.size() + AnalyseTexte::MARQUEUR_DEBUT.size()));
+        d = finPremiere + 1;
+        f = r.derniereFin;
+    }
+
+    // 2. Regroupe les formes de premier niveau en tranches contiguës de taille comparable.
+    std::vector<const char*> bornes{ d };
+    std::size_t cible = static_cast<std::size_t>(f - d) / (_pool.taille() * TRANCHES_PAR_THREAD) + 1;
+    for (const char* debutForme : r.debuts) {
+        if (static_cast<std::size_t>(debutForme - bornes.back()) >= cible) bornes.push_back(debutForme);
+    }
+    bornes.push_back(f);
+
+    // 3. Analyse les tranches en parallèle.
+    std::size_t nbTranches = bornes.size() - 1;
+    std::vector<std::vector<Forme*>> resultats(nbTranches);
+    auto liberer = [&] {
+        for (auto& tranche : resultats) for (Forme* forme : tranche) delete forme;
+    };
+    try {
+        _pool.executer(nbTranches, [&](std::size_t i) {
+            resultats[i] = analyser(bornes[i], bornes[i + 1]);
+        });
+    }
+    catch (...) {
+        liberer();
+        // Les numéros de ligne d'une tranche sont relatifs : relancer sur tout le fichier.
+        return analyser(debut, fin);
+    }
+
+    // 4. Recolle les sous-arbres dans l'ordre du fichier, puis reconstruit les groupes englobants.
+    std::vector<Forme*> formes;
+    for (auto& tranche : resultats) formes.insert(formes.end(), tranche.begin(), tranche.end());
+    for (auto it = enveloppes.rbegin(); it != enveloppes.rend(); ++it) {
+        Groupe* g = new Groupe(*it);
+        for (Forme* forme : formes) g->ajouter(forme);
+        formes.assign(1, g);
+    }
+    return formes;
+}
@@ -0,0 +1,378 @@
+/**
+ * @file ConnexionTCP.cpp
+ * @brief Implémentation de la connexion TCP asynchrone (sockets POSIX et Winsock).
+ */
+
+#include "../header/ConnexionTCP.h"
+#include "../header/ProtocoleDessin.h"
+#include "../header/FormatBinaire.h"
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <cerrno>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace {
+#ifdef _WIN32
+    using Socket = SOCKET;
+    const Socket SOCKET_INVALIDE = INVALID_SOCKET;
+    void fermerSocket(Socket s) { ::closesocket(s); }
+    int ecrireSocket(Socket s, const char* p, std::size_t n) {
+        return ::send(s, p, static_cast<int>(std::min<std::size_t>(n, 1 << 30)), 0);
+    }
+    int lireSocket(Socket s, char* p, std::size_t n) { return ::recv(s, p, static_cast<int>(n), 0); }
+    bool interrompu() { return false; }
+#else
+    using Socket = int;
+    const Socket SOCKET_INVALIDE = -1;
+    void fermerSocket(Socket s) { ::close(s); }
+    // MSG_NOSIGNAL : une connexion coupée donne EPIPE au lieu de tuer le processus par SIGPIPE.
+    ssize_t ecrireSocket(Socket s, const char* p, std::size_t n) { return ::send(s, p, n, MSG_NOSIGNAL); }
+    ssize_t lireSocket(Socket s, char* p, std::size_t n) { return ::recv(s, p, n, 0); }
+    bool interrompu() { return errno == EINTR; }
+#endif
+
+    /** @brief Tentatives d'attente active avant qu'un producteur bloqué s'endorme. */
+    const int ESSAIS_AVANT_SOMMEIL = 64;
+
+    /** @brief Premier délai de reconnexion, doublé à chaque échec. */
+    const std::chrono::milliseconds DELAI_RECONNEXION_MIN(10);
+}
+
+ConnexionTCP::ConnexionTCP(const std::string& hote, std::uint16_t port, const Options& options)
+    : _hote(hote), _port(std::to_string(port)), _options(options),
+      _socket(static_cast<std::intptr_t>(SOCKET_INVALIDE)), _file(options.capaciteFile), _arret(false), _trames(false),
+      _consommateurEndormi(false), _signalRequete(0), _producteursBloques(0), _signalPlace(0), _retirees(0),
+      _requetes(0), _octets(0), _lots(0), _reconnexions(0), _perdues(0) {
+#ifdef _WIN32
+    WSADATA donnees;
+    if (WSAStartup(MAKEWORD(2, 2), &donnees) != 0) {
+        throw std::runtime_error("Initialisation de Winsock impossible");
+    }
+#endif
+    if (!connecter()) {
+#ifdef _WIN32
+        WSACleanup();
+#endif
+        throw std::runtime_error("Connexion impossible au serveur de dessin " + hote + ":" + _port);
+    }
+    _thread = std::thread(&ConnexionTCP::boucle, this);
+}
+
+ConnexionTCP::~ConnexionTCP() {
+    _arret.store(true);
+    reveillerConsommateur();
+    _thread.join();
+    fermer();
+#ifdef _WIN32
+    WSACleanup();
+#endif
+}
+
+bool ConnexionTCP::connecter() {
+    addrinfo criteres{};
+    criteres.ai_family = AF_UNSPEC;
+    criteres.ai_socktype = SOCK_STREAM;
+    addrinfo* adresses = nullptr;
+    if (::getaddrinfo(_hote.c_str(), _port.c_str(), &criteres, &adresses) != 0) return false;
+
+    Socket s = SOCKET_INVALIDE;
+    for (addrinfo* a = adresses; a; a = a->ai_next) {
+        s = ::socket(a->ai_family, a->ai_socktype, a->ai_protocol);
+        if (s == SOCKET_INVALIDE) continue;
+        if (::connect(s, a->ai_addr, static_cast<int>(a->ai_addrlen)) == 0) break;
+        fermerSocket(s);
+        s = SOCKET_INVALIDE;
+    }
+    ::freeaddrinfo(adresses);
+    if (s == SOCKET_INVALIDE) return false;
+
+    // Le regroupement est fait ici : l'algorithme de Nagle ne ferait qu'ajouter de la latence.
+    int un = 1;
+    ::setsockopt(s, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&un), sizeof(un));
+    _socket = static_cast<std::intptr_t>(s);
+    return true;
+}
+
+void ConnexionTCP::fermer() {
+    if (static_cast<Socket>(_socket) == SOCKET_INVALIDE) return;
+    fermerSocket(static_cast<Socket>(_socket));
+    _socket = static_cast<std::intptr_t>(SOCKET_INVALIDE);
+}
+
+void ConnexionTCP::reveillerConsommateur() {
+    // Barrière appariée avec celle de boucle() : soit le thread d'envoi voit la requête déposée,
+    // soit le producteur le voit endormi et le réveille.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (_consommateurEndormi.load(std::memory_order_relaxed) || _arret.load(std::memory_order_relaxed)) {
+        _signalRequete.fetch_add(1, std::memory_order_release);
+        _signalRequete.notify_one();
+    }
+}
+
+bool ConnexionTCP::essayerEnvoyer(std::string requete) {
+    if (!_file.essayerDeposer(Paquet{ std::move(requete), 0, _trames.load(std::memory_order_acquire) })) return false;
+    reveillerConsommateur();
+    return true;
+}
+
+void ConnexionTCP::envoyer(const std::string& requete) {
+    PPIL_CHRONO("ConnexionTCP::envoyer");
+    deposer(Paquet{ requete, 0, _trames.load(std::memory_order_acquire) });
+}
+
+void ConnexionTCP::envoyerPaquet(std::string paquet, std::size_t nbRequetes, bool trame) {
+    if (nbRequetes == 0) return;
+    PPIL_CHRONO("ConnexionTCP::envoyerPaquet");
+    deposer(Paquet{ std::move(paquet), static_cast<std::uint32_t>(nbRequetes), trame });
+}
+
+void ConnexionTCP::ajouterRequete(std::string& paquet, const std::string& requete, bool trame) {
+    if (trame) {
+        char longueur[4];
+        FormatBinaire::encoder<std::uint32_t>(longueur, static_cast<std::uint32_t>(requete.size()));
+        paquet.append(longueur, 4);
+        paquet += requete;
+    }
+    else {
+        paquet += requete;
+        paquet += '\n';
+    }
+}
+
+void ConnexionTCP::deposer(Paquet&& paquet) {
+    for (int essai = 0; !_file.essayerDeposer(std::move(paquet)); ++essai) {
+        if (essai < ESSAIS_AVANT_SOMMEIL) {
+            std::this_thread::yield();
+            continue;
+        }
+        // Contre-pression : s'endormir jusqu'à ce que le thread d'envoi ait libéré des places.
+        const std::uint32_t signal = _signalPlace.load(std::memory_order_acquire);
+        _producteursBloques.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst); // Appariée avec celle de boucle().
+        if (!_file.essayerDeposer(std::move(paquet))) {
+            _signalPlace.wait(signal, std::memory_order_acquire);
+            _producteursBloques.fetch_sub(1, std::memory_order_relaxed);
+            continue;
+        }
+        _producteursBloques.fetch_sub(1, std::memory_order_relaxed);
+        break;
+    }
+    reveillerConsommateur();
+}
+
+void ConnexionTCP::vider() {
+    const std::uint64_t cible = _file.nbReserves();
+    reveillerConsommateur();
+    for (std::uint64_t fait = _retirees.load(std::memory_order_acquire); fait < cible;
+         fait = _retirees.load(std::memory_order_acquire)) {
+        _retirees.wait(fait, std::memory_order_acquire);
+    }
+}
+
+bool ConnexionTCP::ecrireTout(const char* donnees, std::size_t taille) {
+    while (taille > 0) {
+        const auto n = ecrireSocket(static_cast<Socket>(_socket), donnees, taille);
+        if (n > 0) {
+            donnees += n;
+            taille -= static_cast<std::size_t>(n);
+        }
+        else if (!(n < 0 && interrompu())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ConnexionTCP::lireLigne(std::string& ligne, std::chrono::milliseconds delai) {
+    const Socket s = static_cast<Socket>(_socket);
+    const auto limite = std::chrono::steady_clock::now() + delai;
+    ligne.clear();
+    for (;;) {
+        const auto reste = std::chrono::duration_cast<std::chrono::microseconds>(limite - std::chrono::steady_clock::now());
+        if (reste.count() <= 0) return false;
+        fd_set lecture;
+        FD_ZERO(&lecture);
+        FD_SET(s, &lecture);
+        timeval attente{};
+        attente.tv_sec = static_cast<long>(reste.count() / 1000000);
+        attente.tv_usec = static_cast<long>(reste.count() % 1000000);
+        const int pret = ::select(static_cast<int>(s + 1), &lecture, nullptr, nullptr, &attente);
+        if (pret < 0 && interrompu()) continue;
+        if (pret <= 0) return false;
+        // Lecture octet par octet : rien au-delà de la réponse ne doit être consommé.
+        char c;
+        const auto n = lireSocket(s, &c, 1);
+        if (n <= 0) return false;
+        if (c == '\n') {
+            if (!ligne.empty() && ligne.back() == '\r') ligne.pop_back();
+            return true;
+        }
+        ligne += c;
+    }
+}
+
+bool ConnexionTCP::negocier(const std::string& offre) {
+    envoyer(offre);
+    vider();
+    std::string reponse;
+    if (static_cast<Socket>(_socket) == SOCKET_INVALIDE) return false;
+    if (!lireLigne(reponse, _options.delaiNegociation)) {
+        // Réponse perdue ou tardive : le serveur a peut-être accepté, seule une nouvelle connexion le remet en texte.
+        revenirAuTexte();
+        return false;
+    }
+    if (reponse != ProtocoleDessin::ACCEPTATION) return false;
+    _preambule = offre + '\n';
+    _trames.store(true, std::memory_order_release);
+    return true;
+}
+
+void ConnexionTCP::revenirAuTexte() {
+    vider();
+    _preambule.clear();
+    _trames.store(false, std::memory_order_release);
+    fermer();
+    if (connecter()) _reconnexions.fetch_add(1, std::memory_order_release);
+}
+
+ConnexionTCP::Statistiques ConnexionTCP::statistiques() const {
+    Statistiques s;
+    s.perdues = _perdues.load(std::memory_order_relaxed);
+    s.requetes = _requetes.load(std::memory_order_relaxed);
+    s.octets = _octets.load(std::memory_order_relaxed);
+    s.lots = _lots.load(std::memory_order_relaxed);
+    s.reconnexions = _reconnexions.load(std::memory_order_relaxed);
+    return s;
+}
+
+std::size_t ConnexionTCP::transmettre(const std::string& lot, const std::size_t* fins, std::size_t nbElements) {
+    std::size_t envoye = 0;
+    std::chrono::milliseconds delai = DELAI_RECONNEXION_MIN;
+    // Éléments qui ne sont pas entièrement partis.
+    const auto restants = [&] {
+        return nbElements - static_cast<std::size_t>(std::upper_bound(fins, fins + nbElements, envoye) - fins);
+    };
+    while (envoye < lot.size()) {
+        if (static_cast<Socket>(_socket) == SOCKET_INVALIDE) {
+            if (connecter()) {
+                _reconnexions.fetch_add(1, std::memory_order_release);
+                // Le nouveau pair doit d'abord accepter le protocole négocié.
+                if (!_trames.load(std::memory_order_acquire)) {
+                    delai = DELAI_RECONNEXION_MIN;
+                    continue;
+                }
+                std::string reponse;
+                if (ecrireTout(_preambule.data(), _preambule.size()) && lireLigne(reponse, _options.delaiNegociation)) {
+                    if (reponse == ProtocoleDessin::ACCEPTATION) {
+                        delai = DELAI_RECONNEXION_MIN;
+                        continue;
+                    }
+                    // Refus : retour au texte. Les trames de ce lot n'ont plus de sens pour ce pair.
+                    _preambule.clear();
+                    _trames.store(false, std::memory_order_release);
+                    return restants();
+                }
+                // Pair muet : traité comme un serveur injoignable (délai croissant, abandon à la fermeture).
+                fermer();
+            }
+            if (_arret.load(std::memory_order_acquire)) {
+                // Fermeture sans serveur : abandonner ce qui n'est pas entièrement parti.
+                return restants();
+            }
+            std::this_thread::sleep_for(delai);
+            delai = std::min(delai * 2, _options.delaiReconnexionMax);
+            continue;
+        }
+        const auto n = ecrireSocket(static_cast<Socket>(_socket), lot.data() + envoye, lot.size() - envoye);
+        if (n > 0) {
+            envoye += static_cast<std::size_t>(n);
+            _octets.fetch_add(static_cast<std::uint64_t>(n), std::memory_order_relaxed);
+            continue;
+        }
+        if (n < 0 && interrompu()) continue;
+        // Connexion perdue : le nouveau pair doit recevoir des requêtes entières,
+        // on repart donc du début du premier élément incomplet.
+        fermer();
+        const std::size_t* complete = std::upper_bound(fins, fins + nbElements, envoye);
+        envoye = complete == fins ? 0 : *(complete - 1);
+    }
+    _lots.fetch_add(1, std::memory_order_relaxed);
+    return 0;
+}
+
+void ConnexionTCP::boucle() {
+    std::string lot;
+    lot.reserve(_options.tailleLot + 256);
+    std::vector<std::size_t> fins;
+    std::vector<std::uint32_t> nombres; // Requêtes de chaque élément du lot.
+    std::size_t ecartes = 0;             // Éléments en trames retirés après un retour au texte.
+    Paquet element;
+    for (;;) {
+        while (lot.size() < _options.tailleLot && _file.essayerRetirer(element)) {
+            if (element.trame && !_trames.load(std::memory_order_acquire)) {
+                _perdues.fetch_add(element.nbRequetes == 0 ? 1 : element.nbRequetes, std::memory_order_relaxed);
+                ++ecartes;
+                continue;
+            }
+            if (element.nbRequetes == 0) {
+                ajouterRequete(lot, element.octets, element.trame);
+                nombres.push_back(1);
+            }
+            else {
+                lot += element.octets;
+                nombres.push_back(element.nbRequetes);
+            }
+            fins.push_back(lot.size());
+        }
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!fins.empty() && _producteursBloques.load(std::memory_order_relaxed) > 0) {
+            _signalPlace.fetch_add(1, std::memory_order_release);
+            _signalPlace.notify_all();
+        }
+
+        if (ecartes > 0) {
+            _retirees.fetch_add(ecartes, std::memory_order_release);
+            _retirees.notify_all();
+            ecartes = 0;
+        }
+
+        if (fins.empty()) {
+            if (_arret.load(std::memory_order_acquire)) return;
+            const std::uint32_t signal = _signalRequete.load(std::memory_order_acquire);
+            _consommateurEndormi.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (_file.estVide() && !_arret.load(std::memory_order_relaxed)) {
+                _signalRequete.wait(signal, std::memory_order_acquire);
+            }
+            _consommateurEndormi.store(false, std::memory_order_relaxed);
+            continue;
+        }
+
+        const std::size_t perdus = transmettre(lot, fins.data(), fins.size());
+        std::uint64_t requetes = 0, perdues = 0;
+        for (std::size_t i = 0; i < nombres.size(); ++i) {
+            (i + perdus < nombres.size() ? requetes : perdues) += nombres[i];
+        }
+        _requetes.fetch_add(requetes, std::memory_order_relaxed);
+        _perdues.fetch_add(perdues, std::memory_order_relaxed);
+        _retirees.fetch_add(fins.size(), std::memory_order_release);
+        _retirees.notify_all();
+        lot.clear();
+        fins.clear();
+        nombres.clear();
+    }
+}
@@ -0,0 +1,9 @@
+/**
+ * @file Connexion_m.cpp
+ * @brief Instance du Singleton ConnexionManager.
+ */
+
+#include "../header/Connexion_m.h"
+
+std::atomic<ConnexionManager*> ConnexionManager::_instance{ nullptr };
+std::mutex ConnexionManager::_verrouInstance;
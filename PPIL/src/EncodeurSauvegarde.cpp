@@ -0,0 +1,175 @@
+/**
+ * @file EncodeurSauvegarde.cpp
+ * @brief Enregistrements des formats de sauvegarde texte et binaire.
+ */
+
+#include "../header/EncodeurSauvegarde.h"
+#include "../header/FormatBinaire.h"
+#include "../header/FormatTexte.h"
+#include <cmath>
+#include <stdexcept>
+
+void EncodeurTexte::ecrireReel(double valeur) {
+    char tampon[FormatTexte::TAILLE_MAX_REEL];
+    _sortie.ecrire(tampon, static_cast<std::size_t>(FormatTexte::ecrireReel(tampon, valeur) - tampon));
+}
+
+void EncodeurTexte::ecrirePoint(const Vecteur2D& p) {
+    char tampon[FormatTexte::TAILLE_MAX_POINT];
+    _sortie.ecrire(tampon, static_cast<std::size_t>(FormatTexte::ecrirePoint(tampon, p.x, p.y) - tampon));
+}
+
+void EncodeurTexte::cercle(const std::string& couleur, const Vecteur2D& centre, double rayon) {
+    _sortie.ecrire("Cercle;", 7);
+    _sortie.ecrire(couleur);
+    _sortie.ecrire(';');
+    ecrirePoint(centre);
+    _sortie.ecrire(';');
+    ecrireReel(rayon);
+    _sortie.ecrire('\n');
+}
+
+void EncodeurTexte::segment(const std::string& couleur, const Vecteur2D& p1, const Vecteur2D& p2) {
+    _sortie.ecrire("Segment;", 8);
+    _sortie.ecrire(couleur);
+    _sortie.ecrire(';');
+    ecrirePoint(p1);
+    _sortie.ecrire(';');
+    ecrirePoint(p2);
+    _sortie.ecrire('\n');
+}
+
+void EncodeurTexte::polygone(const std::string& couleur, const Vecteur2D* sommets, std::size_t nombre) {
+    _sortie.ecrire("Polygone;", 9);
+    _sortie.ecrire(couleur);
+    for (std::size_t i = 0; i < nombre; ++i) {
+        _sortie.ecrire(';');
+        ecrirePoint(sommets[i]);
+    }
+    _sortie.ecrire('\n');
+}
+
+void EncodeurTexte::debutGroupe(const std::string& couleur) {
+    _sortie.ecrire("Groupe;Debut;", 13);
+    _sortie.ecrire(couleur);
+    _sortie.ecrire('\n');
+}
+
+void EncodeurTexte::finGroupe() {
+    _sortie.ecrire("Groupe;Fin\n", 11);
+}
+
+EncodeurBinaire::EncodeurBinaire(TamponFichier& sortie, double pasQuantification)
+    : _sortie(sortie), _inversePas(pasQuantification > 0 ? 1 / pasQuantification : 0) {
+    if (!(pasQuantification >= 0) || !std::isfinite(pasQuantification)) {
+        throw std::invalid_argument("Le pas de quantification doit être positif et fini");
+    }
+    char entete[FormatBinaire::TAILLE_EN_TETE + 8];
+    _sortie.ecrire(entete, FormatBinaire::ecrireEnTete(entete, pasQuantification));
+}
+
+void EncodeurBinaire::ecrireEntete(unsigned char etiquette, const std::string& couleur) {
+    _sortie.ecrire(static_cast<char>(etiquette));
+    std::uint8_t indice = FormatBinaire::indicePalette(couleur);
+    _sortie.ecrire(static_cast<char>(indice));
+    if (indice == FormatBinaire::COULEUR_LIBRE) {
+        if (couleur.size() > 0xFFFF) {
+            throw std::length_error("Nom de couleur trop long pour le format binaire");
+        }
+        char longueur[2];
+        FormatBinaire::encoder<std::uint16_t>(longueur, static_cast<std::uint16_t>(couleur.size()));
+        _sortie.ecrire(longueur, 2);
+        _sortie.ecrire(couleur);
+    }
+}
+
+void EncodeurBinaire::ecrireReels(const double* valeurs, std::size_t nombre) {
+    char octets[8];
+    for (std::size_t i = 0; i < nombre; ++i) {
+        FormatBinaire::encoderReel(octets, valeurs[i]);
+        _sortie.ecrire(octets, 8);
+    }
+}
+
+void EncodeurBinaire::ecrireVarint(std::uint64_t valeur) {
+    char octets[FormatBinaire::TAILLE_MAX_VARINT];
+    _sortie.ecrire(octets, static_cast<std::size_t>(FormatBinaire::encoderVarint(octets, valeur) - octets));
+}
+
+void EncodeurBinaire::ecrirePoints(const Vecteur2D* points, std::size_t nombre) {
+    if (!_inversePas) {
+        for (std::size_t i = 0; i < nombre; ++i) {
+            const double donnees[2] = { points[i].x, points[i].y };
+            ecrireReels(donnees, 2);
+        }
+        return;
+    }
+    std::int64_t px = 0, py = 0;
+    for (std::size_t i = 0; i < nombre; ++i) {
+        const std::int64_t x = FormatBinaire::quantifier(points[i].x, _inversePas);
+        const std::int64_t y = FormatBinaire::quantifier(points[i].y, _inversePas);
+        ecrireVarint(FormatBinaire::zigzag(x - px));
+        ecrireVarint(FormatBinaire::zigzag(y - py));
+        px = x;
+        py = y;
+    }
+}
+
+std::uint64_t EncodeurBinaire::reserverLongueur() {
+    const std::uint64_t position = _sortie.position();
+    const char longueur[8] = {};
+    _sortie.ecrire(longueur, 8);
+    return position;
+}
+
+void EncodeurBinaire::cercle(const std::string& couleur, const Vecteur2D& centre, double rayon) {
+    ecrireEntete(FormatBinaire::CERCLE, couleur);
+    ecrirePoints(&centre, 1);
+    if (_inversePas) ecrireVarint(FormatBinaire::zigzag(FormatBinaire::quantifierRayon(rayon, _inversePas)));
+    else ecrireReels(&rayon, 1);
+}
+
+void EncodeurBinaire::segment(const std::string& couleur, const Vecteur2D& p1, const Vecteur2D& p2) {
+    ecrireEntete(FormatBinaire::SEGMENT, couleur);
+    const Vecteur2D points[2] = { p1, p2 };
+    ecrirePoints(points, 2);
+}
+
+void EncodeurBinaire::polygone(const std::string& couleur, const Vecteur2D* sommets, std::size_t nombre) {
+    ecrireEntete(FormatBinaire::POLYGONE, couleur);
+    if (_inversePas) ecrireVarint(nombre);
+    else {
+        char n[4];
+        FormatBinaire::encoder<std::uint32_t>(n, static_cast<std::uint32_t>(nombre));
+        _sortie.ecrire(n, 4);
+    }
+    ecrirePoints(sommets, nombre);
+}
+
+std::uint64_t EncodeurBinaire::debutGroupe(const std::string& couleur) {
+    ecrireEntete(FormatBinaire::GROUPE, couleur);
+    return reserverLongueur();
+}
+
+std::uint64_t EncodeurBinaire::debutPrototype(const std::string& couleur, std::uint32_t numero) {
+    ecrireEntete(FormatBinaire::PROTOTYPE, couleur);
+    char n[4];
+    FormatBinaire::encoder<std::uint32_t>(n, numero);
+    _sortie.ecrire(n, 4);
+    return reserverLongueur();
+}
+
+void EncodeurBinaire::finGroupe(std::uint64_t debut) {
+    char longueur[8];
+    FormatBinaire::encoder<std::uint64_t>(longueur, _sortie.position() - debut - 8);
+    _sortie.reecrire(debut, longueur, 8);
+}
+
+void EncodeurBinaire::instance(const std::string& couleur, std::uint32_t numero, const Transformation2D& m) {
+    char n[4];
+    FormatBinaire::encoder<std::uint32_t>(n, numero);
+    ecrireEntete(FormatBinaire::INSTANCE, couleur);
+    _sortie.ecrire(n, 4);
+    const double donnees[6] = { m.a, m.b, m.c, m.d, m.tx, m.ty };
+    ecrireReels(donnees, 6);
+}
@@ -0,0 +1,82 @@
+/**
+ * @file FichierMappe.cpp
+ * @brief Implémentation de la projection de fichier en mémoire (POSIX et Windows).
+ */
+
+#include "../header/FichierMappe.h"
+#include <stdexcept>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+FichierMappe::FichierMappe(const std::string& nomFichier)
+    : _donnees(nullptr), _taille(0), _fichier(INVALID_HANDLE_VALUE), _projection(nullptr) {
+    _fichier = CreateFileA(nomFichier.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                           OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (_fichier == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Impossible d'ouvrir le fichier : " + nomFichier);
+    }
+    LARGE_INTEGER taille;
+    GetFileSizeEx(_fichier, &taille);
+    _taille = static_cast<std::size_t>(taille.QuadPart);
+    if (_taille == 0) return;
+
+    _projection = CreateFileMappingA(_fichier, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (_projection) {
+        _donnees = static_cast<const char*>(MapViewOfFile(_projection, FILE_MAP_READ, 0, 0, 0));
+    }
+    if (!_donnees) {
+        if (_projection) CloseHandle(_projection);
+        CloseHandle(_fichier);
+        throw std::runtime_error("Impossible de projeter le fichier : " + nomFichier);
+    }
+}
+
+FichierMappe::~FichierMappe() {
+    if (_donnees) UnmapViewOfFile(_donnees);
+    if (_projection) CloseHandle(_projection);
+    if (_fichier != INVALID_HANDLE_VALUE) CloseHandle(_fichier);
+}
+
+#else
+
+FichierMappe::FichierMappe(const std::string& nomFichier) : _donnees(nullptr), _taille(0) {
+    int fd = ::open(nomFichier.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Impossible d'ouvrir le fichier : " + nomFichier);
+    }
+    struct stat infos;
+    if (::fstat(fd, &infos) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Impossible de lire la taille du fichier : " + nomFichier);
+    }
+    _taille = static_cast<std::size_t>(infos.st_size);
+    if (_taille > 0) {
+        void* p = ::mmap(nullptr, _taille, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED) {
+            ::close(fd);
+            throw std::runtime_error("Impossible de projeter le fichier : " + nomFichier);
+        }
+        // Lecture strictement séquentielle : lecture anticipée agressive du noyau.
+        ::madvise(p, _taille, MADV_SEQUENTIAL);
+        _donnees = static_cast<const char*>(p);
+    }
+    // La projection reste valide après la fermeture du descripteur.
+    ::close(fd);
+}
+
+FichierMappe::~FichierMappe() {
+    if (_donnees) ::munmap(const_cast<char*>(_donnees), _taille);
+}
+
+#endif
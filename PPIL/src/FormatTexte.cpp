@@ -0,0 +1,80 @@
+/**
+ * @file FormatTexte.cpp
+ * @brief Descriptions lisibles des formes, écrites en un seul passage.
+ */
+
+#include "../header/FormatTexte.h"
+#include "../header/VisiteurForme.h"
+#include "../header/Cercle.h"
+#include "../header/Segement.h"
+#include "../header/Polygone.h"
+#include "../header/Group.h"
+
+namespace {
+    /** @brief Ajoute les descriptions à une seule chaîne, groupes compris. */
+    class VisiteurDescription : public VisiteurForme {
+    private:
+        std::string& _s;
+
+        void point(const Vecteur2D& p) {
+            const Vecteur2D q = placer(p);
+            FormatTexte::ajouterPoint(_s, q.x, q.y);
+        }
+
+        void couleur(const Forme& f) {
+            _s += "], ";
+            _s += f.getCouleur();
+        }
+
+    public:
+        explicit VisiteurDescription(std::string& s) : _s(s) {}
+
+        /** @details Format : "Cercle [C:(x,y), R:rayon], couleur". */
+        void visite(const Cercle& cercle) override {
+            _s += "Cercle [C:";
+            point(cercle.getCentre());
+            _s += ", R:";
+            FormatTexte::ajouterReel(_s, placer(cercle.getRayon()));
+            couleur(cercle);
+        }
+
+        /** @details Format : "Segment [(x1,y1), (x2,y2)], couleur". */
+        void visite(const Segment& segment) override {
+            _s += "Segment [";
+            point(segment.getP1());
+            _s += ", ";
+            point(segment.getP2());
+            couleur(segment);
+        }
+
+        /** @details Format : "Polygone [(x1,y1) (x2,y2) ... ], couleur". */
+        void visite(const Polygone& polygone) override {
+            _s += "Polygone [";
+            for (const Vecteur2D& v : polygone.getSommets()) {
+                point(v);
+                _s += ' ';
+            }
+            couleur(polygone);
+        }
+
+        /** @details Format : "Groupe couleur { forme ; forme ; }". */
+        void visite(const Groupe& groupe) override {
+            _s += "Groupe ";
+            _s += couleurGroupe(groupe);
+            _s += " { ";
+            for (const Forme* f : groupe.getFormes()) {
+                f->accepte(this);
+                _s += " ; ";
+            }
+            _s += '}';
+        }
+    };
+}
+
+namespace FormatTexte {
+
+    void ajouterDescription(std::string& s, const Forme& f) {
+        VisiteurDescription v(s);
+        f.accepte(&v);
+    }
+}
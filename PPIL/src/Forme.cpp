@@ -6,4 +6,4 @@ const std::string Forme::BLUE = "blue";
 const std::string Forme::RED = "red";
 const std::string Forme::GREEN = "green";
 const std::string Forme::YELLOW = "yellow";
-const std::string Forme::CYAN = "cyan";
\ No newline at end of file
+const std::string Forme::CYAN = "cyan";
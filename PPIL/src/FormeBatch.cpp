@@ -0,0 +1,341 @@
+/**
+ * @file FormeBatch.cpp
+ * @brief Implémentation du stockage en tableaux séparés et des noyaux de transformation.
+ */
+
+#include "../header/FormeBatch.h"
+#include "../header/VisiteurForme.h"
+#include "../header/Cercle.h"
+#include "../header/Segement.h"
+#include "../header/Polygone.h"
+#include "../header/Group.h"
+#include "../header/ArenaFormes.h"
+#include <cmath>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && !defined(__AVX2__)
+ // Noyau AVX2 compilé à part et choisi à l'exécution si le processeur le permet.
+#define PPIL_AVX2_DYNAMIQUE 1
+#define PPIL_CIBLE_AVX2 __attribute__((target("avx2")))
+#else
+#define PPIL_CIBLE_AVX2
+#endif
+
+#if defined(__AVX2__) || defined(PPIL_AVX2_DYNAMIQUE)
+#define PPIL_NOYAU_AVX2 1
+#include <immintrin.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PPIL_NOYAU_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+    /**
+     * @brief Transformation affine relative à un point d'origine :
+     * x' = ox + a.(x - ox) + b.(y - oy) + tx ; y' = oy + c.(x - ox) + d.(y - oy) + ty.
+     */
+    struct Affine {
+        double ox, oy, a, b, c, d, tx, ty;
+    };
+
+    using Noyau = void (*)(double* x, double* y, std::size_t n, const Affine& m);
+
+    void noyauScalaire(double* x, double* y, std::size_t n, const Affine& m) {
+        const double ex = m.ox + m.tx, ey = m.oy + m.ty;
+        for (std::size_t i = 0; i < n; ++i) {
+            double dx = x[i] - m.ox, dy = y[i] - m.oy;
+            x[i] = ex + (m.a * dx + m.b * dy);
+            y[i] = ey + (m.c * dx + m.d * dy);
+        }
+    }
+
+#ifdef PPIL_NOYAU_SSE2
+    void noyauSSE2(double* x, double* y, std::size_t n, const Affine& m) {
+        const __m128d ox = _mm_set1_pd(m.ox), oy = _mm_set1_pd(m.oy);
+        const __m128d a = _mm_set1_pd(m.a), b = _mm_set1_pd(m.b), c = _mm_set1_pd(m.c), d = _mm_set1_pd(m.d);
+        const __m128d ex = _mm_set1_pd(m.ox + m.tx), ey = _mm_set1_pd(m.oy + m.ty);
+        std::size_t i = 0;
+        for (; i + 2 <= n; i += 2) {
+            __m128d dx = _mm_sub_pd(_mm_loadu_pd(x + i), ox);
+            __m128d dy = _mm_sub_pd(_mm_loadu_pd(y + i), oy);
+            _mm_storeu_pd(x + i, _mm_add_pd(ex, _mm_add_pd(_mm_mul_pd(a, dx), _mm_mul_pd(b, dy))));
+            _mm_storeu_pd(y + i, _mm_add_pd(ey, _mm_add_pd(_mm_mul_pd(c, dx), _mm_mul_pd(d, dy))));
+        }
+        noyauScalaire(x + i, y + i, n - i, m);
+    }
+#endif
+
+#ifdef PPIL_NOYAU_AVX2
+    // Pas de FMA : les trois versions donnent ainsi des résultats identiques au bit près.
+    PPIL_CIBLE_AVX2 void noyauAVX2(double* x, double* y, std::size_t n, const Affine& m) {
+        const __m256d ox = _mm256_set1_pd(m.ox), oy = _mm256_set1_pd(m.oy);
+        const __m256d a = _mm256_set1_pd(m.a), b = _mm256_set1_pd(m.b);
+        const __m256d c = _mm256_set1_pd(m.c), d = _mm256_set1_pd(m.d);
+        const __m256d ex = _mm256_set1_pd(m.ox + m.tx), ey = _mm256_set1_pd(m.oy + m.ty);
+        std::size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m256d dx = _mm256_sub_pd(_mm256_loadu_pd(x + i), ox);
+            __m256d dy = _mm256_sub_pd(_mm256_loadu_pd(y + i), oy);
+            _mm256_storeu_pd(x + i, _mm256_add_pd(ex, _mm256_add_pd(_mm256_mul_pd(a, dx), _mm256_mul_pd(b, dy))));
+            _mm256_storeu_pd(y + i, _mm256_add_pd(ey, _mm256_add_pd(_mm256_mul_pd(c, dx), _mm256_mul_pd(d, dy))));
+        }
+        noyauScalaire(x + i, y + i, n - i, m);
+    }
+#endif
+
+    struct ChoixNoyau {
+        Noyau noyau;
+        const char* nom;
+    };
+
+    ChoixNoyau choisirNoyau() {
+#if defined(__AVX2__)
+        return { noyauAVX2, "avx2" };
+#else
+#ifdef PPIL_AVX2_DYNAMIQUE
+        if (__builtin_cpu_supports("avx2")) return { noyauAVX2, "avx2" };
+#endif
+#ifdef PPIL_NOYAU_SSE2
+        return { noyauSSE2, "sse2" };
+#else
+        return { noyauScalaire, "scalaire" };
+#endif
+#endif
+    }
+
+    const ChoixNoyau& noyau() {
+        static const ChoixNoyau choix = choisirNoyau();
+        return choix;
+    }
+}
+
+/**
+ * @class RemplisseurBatch
+ * @brief Visiteur copiant un arbre de formes dans les tableaux d'un FormeBatch.
+ * @details Une instance y devient le groupe équivalent, formes du prototype placées.
+ */
+class RemplisseurBatch : public VisiteurForme {
+private:
+    FormeBatch& _lot;
+
+public:
+    explicit RemplisseurBatch(FormeBatch& lot) : _lot(lot) {}
+
+    void visite(const Cercle& cercle) override {
+        _lot._structure.push_back({ FormeBatch::CERCLE, static_cast<std::uint32_t>(_lot._rayon.size()),
+                                    _lot.indiceCouleur(cercle.getCouleur()) });
+        const Vecteur2D c = placer(cercle.getCentre());
+        _lot._cx.push_back(c.x);
+        _lot._cy.push_back(c.y);
+        _lot._rayon.push_back(placer(cercle.getRayon()));
+    }
+
+    void visite(const Segment& segment) override {
+        _lot._structure.push_back({ FormeBatch::SEGMENT, static_cast<std::uint32_t>(_lot._x1.size()),
+                                    _lot.indiceCouleur(segment.getCouleur()) });
+        const Vecteur2D p1 = placer(segment.getP1()), p2 = placer(segment.getP2());
+        _lot._x1.push_back(p1.x);
+        _lot._y1.push_back(p1.y);
+        _lot._x2.push_back(p2.x);
+        _lot._y2.push_back(p2.y);
+    }
+
+    void visite(const Polygone& polygone) override {
+        _lot._structure.push_back({ FormeBatch::POLYGONE, static_cast<std::uint32_t>(_lot.nbPolygones()),
+                                    _lot.indiceCouleur(polygone.getCouleur()) });
+        for (const auto& s : polygone.getSommets()) {
+            const Vecteur2D p = placer(s);
+            _lot._px.push_back(p.x);
+            _lot._py.push_back(p.y);
+        }
+        _lot._debutSommets.push_back(static_cast<std::uint32_t>(_lot._px.size()));
+    }
+
+    void visite(const Groupe& groupe) override {
+        _lot._structure.push_back({ FormeBatch::DEBUT_GROUPE, 0, _lot.indiceCouleur(couleurGroupe(groupe)) });
+        for (const Forme* f : groupe.getFormes()) f->accepte(this);
+        _lot._structure.push_back({ FormeBatch::FIN_GROUPE, 0, 0 });
+    }
+};
+
+std::uint32_t FormeBatch::indiceCouleur(const std::string& couleur) {
+    auto it = _indicesCouleurs.find(couleur);
+    if (it != _indicesCouleurs.end()) return it->second;
+    std::uint32_t indice = static_cast<std::uint32_t>(_couleurs.size());
+    _couleurs.push_back(couleur);
+    _indicesCouleurs.emplace(couleur, indice);
+    return indice;
+}
+
+void FormeBatch::ajouter(const Forme& forme) {
+    RemplisseurBatch remplisseur(*this);
+    forme.accepte(&remplisseur);
+}
+
+void FormeBatch::vider() {
+    *this = FormeBatch();
+}
+
+void FormeBatch::transformer(double ox, double oy, double a, double b, double c, double d, double tx, double ty) {
+    const Affine m{ ox, oy, a, b, c, d, tx, ty };
+    Noyau n = noyau().noyau;
+    n(_cx.data(), _cy.data(), _cx.size(), m);
+    n(_x1.data(), _y1.data(), _x1.size(), m);
+    n(_x2.data(), _y2.data(), _x2.size(), m);
+    n(_px.data(), _py.data(), _px.size(), m);
+}
+
+void FormeBatch::translation(const Vecteur2D& v) {
+    transformer(0, 0, 1, 0, 0, 1, v.x, v.y);
+}
+
+void FormeBatch::homothetie(const Vecteur2D& centre, double rapport) {
+    transformer(centre.x, centre.y, rapport, 0, 0, rapport, 0, 0);
+    const double facteur = std::abs(rapport);
+    for (double& r : _rayon) r *= facteur;
+}
+
+void FormeBatch::rotation(const Vecteur2D& centre, double angle) {
+    const double co = std::cos(angle), si = std::sin(angle);
+    transformer(centre.x, centre.y, co, -si, si, co, 0, 0);
+}
+
+void FormeBatch::appliquer(const Transformation2D& m) {
+    transformer(0, 0, m.a, m.b, m.c, m.d, m.tx, m.ty);
+    const double facteur = m.echelle();
+    for (double& r : _rayon) r *= facteur;
+}
+
+double FormeBatch::calculerAire() const {
+    double total = 0;
+    for (std::size_t i = 0; i < _rayon.size(); ++i) total += M_PI * _rayon[i] * _rayon[i];
+    for (std::size_t p = 0; p + 1 < _debutSommets.size(); ++p) {
+        std::size_t debut = _debutSommets[p], fin = _debutSommets[p + 1];
+        if (fin - debut < 3) continue;
+        double aire = _px[fin - 1] * _py[debut] - _py[fin - 1] * _px[debut];
+        for (std::size_t i = debut; i + 1 < fin; ++i) aire += _px[i] * _py[i + 1] - _py[i] * _px[i + 1];
+        total += std::abs(aire) / 2.0;
+    }
+    return total;
+}
+
+void FormeBatch::sommetsPolygone(std::uint32_t indice, std::vector<Vecteur2D>& sommets) const {
+    sommets.clear();
+    for (std::uint32_t i = _debutSommets[indice]; i < _debutSommets[indice + 1]; ++i) {
+        sommets.emplace_back(_px[i], _py[i]);
+    }
+}
+
+std::vector<Forme*> FormeBatch::construire(std::size_t debut, std::size_t fin, ArenaFormes* arene,
+                                           std::vector<Vecteur2D>& sommets) const {
+    std::vector<Forme*> racines;
+    std::vector<Groupe*> pile; // Groupes ouverts, rattachés à leur parent une fois complets.
+    auto rattacher = [&](Forme* f) {
+        if (pile.empty()) racines.push_back(f);
+        else pile.back()->ajouter(f);
+    };
+    try {
+        for (std::size_t k = debut; k < fin; ++k) {
+            const Noeud& n = _structure[k];
+            switch (n.type) {
+            case CERCLE: {
+                const Vecteur2D centre(_cx[n.indice], _cy[n.indice]);
+                rattacher(arene ? arene->creer<Cercle>(centre, _rayon[n.indice], _couleurs[n.couleur])
+                                : new Cercle(centre, _rayon[n.indice], _couleurs[n.couleur]));
+                break;
+            }
+            case SEGMENT: {
+                const Vecteur2D p1(_x1[n.indice], _y1[n.indice]), p2(_x2[n.indice], _y2[n.indice]);
+                rattacher(arene ? arene->creer<Segment>(p1, p2, _couleurs[n.couleur])
+                                : new Segment(p1, p2, _couleurs[n.couleur]));
+                break;
+            }
+            case POLYGONE: {
+                sommetsPolygone(n.indice, sommets);
+                const Vecteur2D* d = sommets.data();
+                const Vecteur2D* f = d + sommets.size();
+                rattacher(arene ? arene->creer<Polygone>(d, f, _couleurs[n.couleur])
+                                : new Polygone(d, f, _couleurs[n.couleur]));
+                break;
+            }
+            case DEBUT_GROUPE:
+                pile.push_back(arene ? arene->creer<Groupe>(_couleurs[n.couleur]) : new Groupe(_couleurs[n.couleur]));
+                break;
+            case FIN_GROUPE: {
+                // Rattaché complet : chaque ajout ne remonte que jusqu'au groupe en construction.
+                Groupe* g = pile.back();
+                pile.pop_back();
+                rattacher(g);
+                break;
+            }
+            }
+        }
+    }
+    catch (...) {
+        auto jeter = [arene](Forme* f) { if (arene) arene->detruire(f); else delete f; };
+        for (Groupe* g : pile) jeter(g);
+        for (Forme* f : racines) jeter(f);
+        throw;
+    }
+    return racines;
+}
+
+std::vector<Forme*> FormeBatch::versFormes() const {
+    std::vector<Vecteur2D> sommets;
+    return construire(0, _structure.size(), nullptr, sommets);
+}
+
+void FormeBatch::accepte(VisiteurForme* v) const {
+    ArenaFormes arene;               // Reprise d'un groupe à l'autre.
+    std::vector<Vecteur2D> sommets;  // Tampon réutilisé pour tous les polygones.
+    for (std::size_t k = 0; k < _structure.size(); ++k) {
+        const Noeud& n = _structure[k];
+        switch (n.type) {
+        case CERCLE: {
+            Cercle c(Vecteur2D(_cx[n.indice], _cy[n.indice]), _rayon[n.indice], _couleurs[n.couleur]);
+            c.accepte(v);
+            break;
+        }
+        case SEGMENT: {
+            Segment s(Vecteur2D(_x1[n.indice], _y1[n.indice]), Vecteur2D(_x2[n.indice], _y2[n.indice]),
+                      _couleurs[n.couleur]);
+            s.accepte(v);
+            break;
+        }
+        case POLYGONE: {
+            sommetsPolygone(n.indice, sommets);
+            Polygone p(sommets.data(), sommets.data() + sommets.size(), _couleurs[n.couleur]);
+            p.accepte(v);
+            break;
+        }
+        case DEBUT_GROUPE: {
+            // Un visiteur de groupe parcourt getFormes() : le sous-arbre est reconstruit le temps de la visite.
+            std::size_t fin = k + 1;
+            for (int profondeur = 1; profondeur > 0; ++fin) {
+                if (_structure[fin].type == DEBUT_GROUPE) ++profondeur;
+                else if (_structure[fin].type == FIN_GROUPE) --profondeur;
+            }
+            Forme* groupe = construire(k, fin, &arene, sommets)[0];
+            try {
+                groupe->accepte(v);
+            }
+            catch (...) {
+                arene.detruire(groupe);
+                throw;
+            }
+            arene.detruire(groupe); // Destructeurs seulement : la mémoire reste à l'arène.
+            arene.recommencer();
+            k = fin - 1;
+            break;
+        }
+        case FIN_GROUPE:
+            break;
+        }
+    }
+}
+
+const char* FormeBatch::jeuInstructions() {
+    return noyau().nom;
+}
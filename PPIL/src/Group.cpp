@@ -0,0 +1,26 @@
+/**
+ * @file Group.cpp
+ * @brief Répartition du travail d'un groupe sur la réserve de threads.
+ */
+
+#include "../header/Group.h"
+#include "../header/AireUnion.h"
+#include "../header/PoolThreads.h"
+
+namespace {
+    /** @brief Enfants par plage indivisible : amortit le coût d'une tâche sur plusieurs formes. */
+    const std::size_t ENFANTS_PAR_TACHE = 256;
+}
+
+void Groupe::pourChaqueEnfant(PoolThreads* pool, const function<void(size_t)>& tache) const {
+    // Les enfants qui sont de gros groupes relancent leur propre lot depuis la tâche :
+    // la réserve répartit alors leurs sous-arbres par vol de tâches.
+    size_t granularite = ENFANTS_PAR_TACHE;
+    if (_formes.size() < ENFANTS_PAR_TACHE * pool->taille()) granularite = 1;
+    pool->executer(_formes.size(), tache, granularite);
+}
+
+double Groupe::calculerAireUnion(PoolThreads* pool) const {
+    PPIL_CHRONO("Groupe::calculerAireUnion");
+    return AireUnion(*this).calculer(pool);
+}
@@ -0,0 +1,286 @@
+/**
+ * @file HierarchieBoites.cpp
+ * @brief Construction et parcours de la hiérarchie de boîtes englobantes.
+ */
+
+#include "../header/HierarchieBoites.h"
+#include "../header/Geometrie.h"
+#include "../header/VisiteurForme.h"
+#include "../header/Cercle.h"
+#include "../header/Segement.h"
+#include "../header/Polygone.h"
+#include "../header/Group.h"
+#include "../header/Instance.h"
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+    /** @brief Rassemble les formes simples d'un arbre, groupes aplatis. */
+    class CollecteurFeuilles : public VisiteurForme {
+    private:
+        std::vector<const Forme*>& _formes;
+
+    public:
+        explicit CollecteurFeuilles(std::vector<const Forme*>& formes) : _formes(formes) {}
+
+        void visite(const Cercle& cercle) override { _formes.push_back(&cercle); }
+        void visite(const Segment& segment) override { _formes.push_back(&segment); }
+        void visite(const Polygone& polygone) override { _formes.push_back(&polygone); }
+        void visite(const Groupe& groupe) override {
+            for (const Forme* f : groupe.getFormes()) f->accepte(this);
+        }
+
+        /** @brief Une instance est indexée d'un bloc : ses formes sont celles du prototype partagé. */
+        void visite(const Instance& instance) override { _formes.push_back(&instance); }
+    };
+
+    /** @brief Distance d'un point à une forme simple pleine (0 à l'intérieur). */
+    class MesureDistance : public VisiteurForme {
+    private:
+        Vecteur2D _point;
+        std::vector<Vecteur2D> _places; ///< Sommets placés d'un polygone d'instance.
+
+    public:
+        double resultat = 0;
+
+        explicit MesureDistance(const Vecteur2D& point) : _point(point) {}
+
+        void visite(const Cercle& cercle) override {
+            const Vecteur2D c = placer(cercle.getCentre());
+            resultat = std::max(0.0, std::hypot(_point.x - c.x, _point.y - c.y) - placer(cercle.getRayon()));
+        }
+
+        void visite(const Segment& segment) override {
+            resultat = Geometrie::distanceSegment(_point, placer(segment.getP1()), placer(segment.getP2()));
+        }
+
+        void visite(const Polygone& polygone) override {
+            const std::size_t n = polygone.getSommets().size();
+            const Vecteur2D* s = placer(polygone, _places);
+            if (n >= 3 && Geometrie::nombreEnroulement(_point, s, n) != 0) {
+                resultat = 0;
+                return;
+            }
+            resultat = std::numeric_limits<double>::infinity();
+            for (std::size_t i = 0; i < n; ++i) {
+                resultat = std::min(resultat, Geometrie::distanceSegment(_point, s[i], s[(i + 1) % n]));
+            }
+        }
+
+        /** @brief Prototype d'une instance : distance à la plus proche de ses formes. */
+        void visite(const Groupe& groupe) override {
+            double d = std::numeric_limits<double>::infinity();
+            for (const Forme* f : groupe.getFormes()) {
+                f->accepte(this);
+                d = std::min(d, resultat);
+            }
+            resultat = d;
+        }
+    };
+
+    /** @brief Teste si une forme simple pleine a au moins un point dans une boîte. */
+    class TestIntersection : public VisiteurForme {
+    private:
+        Boite2D _zone;
+        std::vector<Vecteur2D> _places; ///< Sommets placés d'un polygone d'instance.
+
+    public:
+        bool resultat = false;
+
+        explicit TestIntersection(const Boite2D& zone) : _zone(zone) {}
+
+        void visite(const Cercle& cercle) override {
+            resultat = _zone.distance(placer(cercle.getCentre())) <= placer(cercle.getRayon());
+        }
+
+        void visite(const Segment& segment) override {
+            resultat = Geometrie::segmentIntersecteBoite(placer(segment.getP1()), placer(segment.getP2()), _zone);
+        }
+
+        void visite(const Polygone& polygone) override {
+            const std::size_t n = polygone.getSommets().size();
+            const Vecteur2D* s = placer(polygone, _places);
+            for (std::size_t i = 0; i < n; ++i) {
+                if (Geometrie::segmentIntersecteBoite(s[i], s[(i + 1) % n], _zone)) {
+                    resultat = true;
+                    return;
+                }
+            }
+            // Aucun bord dans la zone : elle est soit disjointe, soit entièrement à l'intérieur.
+            resultat = n >= 3 && Geometrie::nombreEnroulement(_zone.centre(), s, n) != 0;
+        }
+
+        /** @brief Prototype d'une instance : vrai si l'une de ses formes touche la zone. */
+        void visite(const Groupe& groupe) override {
+            bool touche = false;
+            for (const Forme* f : groupe.getFormes()) {
+                f->accepte(this);
+                if ((touche = resultat)) break;
+            }
+            resultat = touche;
+        }
+    };
+
+    double distanceForme(const Forme* f, const Vecteur2D& p) {
+        MesureDistance mesure(p);
+        f->accepte(&mesure);
+        return mesure.resultat;
+    }
+}
+
+void HierarchieBoites::construire(const Forme& racine) {
+    _formes.clear();
+    _noeuds.clear();
+    CollecteurFeuilles collecteur(_formes);
+    racine.accepte(&collecteur);
+
+    const std::size_t n = _formes.size();
+    _boites.resize(n);
+    _ordre.resize(n);
+    std::vector<Vecteur2D> centres(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        _boites[i] = _formes[i]->calculerBoite();
+        centres[i] = _boites[i].centre();
+        _ordre[i] = static_cast<std::uint32_t>(i);
+    }
+    if (n == 0) return;
+
+    struct Tache { std::uint32_t noeud, debut, fin; };
+    std::vector<Tache> pile;
+    _noeuds.reserve(2 * (n / FORMES_PAR_FEUILLE + 1));
+    _noeuds.push_back(Noeud{ Boite2D(), 0, 0 });
+    pile.push_back(Tache{ 0, 0, static_cast<std::uint32_t>(n) });
+
+    while (!pile.empty()) {
+        const Tache t = pile.back();
+        pile.pop_back();
+
+        Boite2D boite, boiteCentres;
+        for (std::uint32_t i = t.debut; i < t.fin; ++i) {
+            boite.etendre(_boites[_ordre[i]]);
+            boiteCentres.etendre(centres[_ordre[i]]);
+        }
+        _noeuds[t.noeud].boite = boite;
+
+        const bool selonX = boiteCentres.largeur() >= boiteCentres.hauteur();
+        const double etendue = selonX ? boiteCentres.largeur() : boiteCentres.hauteur();
+        if (t.fin - t.debut <= FORMES_PAR_FEUILLE || etendue == 0) {
+            _noeuds[t.noeud].premier = t.debut;
+            _noeuds[t.noeud].nb = t.fin - t.debut;
+            continue;
+        }
+
+        // Coupure médiane : deux moitiés de même effectif, arbre équilibré.
+        const std::uint32_t milieu = t.debut + (t.fin - t.debut) / 2;
+        std::nth_element(_ordre.begin() + t.debut, _ordre.begin() + milieu, _ordre.begin() + t.fin,
+            [&](std::uint32_t a, std::uint32_t b) {
+                return selonX ? centres[a].x < centres[b].x : centres[a].y < centres[b].y;
+            });
+
+        const std::uint32_t gauche = static_cast<std::uint32_t>(_noeuds.size());
+        _noeuds[t.noeud].premier = gauche;
+        _noeuds[t.noeud].nb = 0;
+        _noeuds.push_back(Noeud{ Boite2D(), 0, 0 });
+        _noeuds.push_back(Noeud{ Boite2D(), 0, 0 });
+        pile.push_back(Tache{ gauche, t.debut, milieu });
+        pile.push_back(Tache{ gauche + 1, milieu, t.fin });
+    }
+}
+
+void HierarchieBoites::reajuster() {
+    for (std::size_t i = 0; i < _formes.size(); ++i) _boites[i] = _formes[i]->calculerBoite();
+    // Les enfants sont toujours rangés après leur parent : un parcours à rebours remonte l'arbre.
+    for (std::size_t i = _noeuds.size(); i-- > 0;) {
+        Noeud& noeud = _noeuds[i];
+        Boite2D boite;
+        if (noeud.nb > 0) {
+            for (std::uint32_t k = noeud.premier; k < noeud.premier + noeud.nb; ++k) boite.etendre(_boites[_ordre[k]]);
+        }
+        else {
+            boite.etendre(_noeuds[noeud.premier].boite);
+            boite.etendre(_noeuds[noeud.premier + 1].boite);
+        }
+        noeud.boite = boite;
+    }
+}
+
+std::vector<const Forme*> HierarchieBoites::formesAuPoint(const Vecteur2D& p, double tolerance) const {
+    std::vector<const Forme*> resultat;
+    if (_noeuds.empty()) return resultat;
+    std::vector<std::uint32_t> pile{ 0 };
+    while (!pile.empty()) {
+        const Noeud& noeud = _noeuds[pile.back()];
+        pile.pop_back();
+        if (noeud.boite.distance(p) > tolerance) continue;
+        if (noeud.nb == 0) {
+            pile.push_back(noeud.premier);
+            pile.push_back(noeud.premier + 1);
+            continue;
+        }
+        for (std::uint32_t k = noeud.premier; k < noeud.premier + noeud.nb; ++k) {
+            const std::uint32_t i = _ordre[k];
+            if (_boites[i].distance(p) <= tolerance && distanceForme(_formes[i], p) <= tolerance) {
+                resultat.push_back(_formes[i]);
+            }
+        }
+    }
+    return resultat;
+}
+
+std::vector<const Forme*> HierarchieBoites::formesDansRectangle(const Boite2D& zone) const {
+    std::vector<const Forme*> resultat;
+    if (_noeuds.empty() || zone.estVide()) return resultat;
+    TestIntersection test(zone);
+    std::vector<std::uint32_t> pile{ 0 };
+    while (!pile.empty()) {
+        const Noeud& noeud = _noeuds[pile.back()];
+        pile.pop_back();
+        if (!noeud.boite.intersecte(zone)) continue;
+        if (noeud.nb == 0) {
+            pile.push_back(noeud.premier);
+            pile.push_back(noeud.premier + 1);
+            continue;
+        }
+        for (std::uint32_t k = noeud.premier; k < noeud.premier + noeud.nb; ++k) {
+            const std::uint32_t i = _ordre[k];
+            if (!_boites[i].intersecte(zone)) continue;
+            _formes[i]->accepte(&test);
+            if (test.resultat) resultat.push_back(_formes[i]);
+        }
+    }
+    return resultat;
+}
+
+const Forme* HierarchieBoites::plusProche(const Vecteur2D& p, double* distance) const {
+    const Forme* meilleure = nullptr;
+    double meilleureDistance = std::numeric_limits<double>::infinity();
+    if (!_noeuds.empty()) {
+        std::vector<std::uint32_t> pile{ 0 };
+        while (!pile.empty()) {
+            const Noeud& noeud = _noeuds[pile.back()];
+            pile.pop_back();
+            if (noeud.boite.distance(p) >= meilleureDistance) continue;
+            if (noeud.nb == 0) {
+                // Empile l'enfant le plus proche en dernier pour le visiter d'abord :
+                // la meilleure distance baisse vite et élague davantage.
+                const std::uint32_t g = noeud.premier, d = noeud.premier + 1;
+                const bool gaucheDAbord = _noeuds[g].boite.distance(p) <= _noeuds[d].boite.distance(p);
+                pile.push_back(gaucheDAbord ? d : g);
+                pile.push_back(gaucheDAbord ? g : d);
+                continue;
+            }
+            for (std::uint32_t k = noeud.premier; k < noeud.premier + noeud.nb; ++k) {
+                const std::uint32_t i = _ordre[k];
+                if (_boites[i].distance(p) >= meilleureDistance) continue;
+                const double dist = distanceForme(_formes[i], p);
+                if (dist < meilleureDistance) {
+                    meilleureDistance = dist;
+                    meilleure = _formes[i];
+                }
+            }
+        }
+    }
+    if (distance) *distance = meilleureDistance;
+    return meilleure;
+}
@@ -0,0 +1,210 @@
+/**
+ * @file Instance.cpp
+ * @brief Instances de groupes partagés : copie sur écriture, métriques et visite du prototype en place.
+ */
+
+#include "../header/Instance.h"
+#include "../header/Cercle.h"
+#include "../header/Segement.h"
+#include "../header/Polygone.h"
+#include "../header/Group.h"
+#include "../header/FormatTexte.h"
+#include <stdexcept>
+
+namespace {
+    /** @brief Copie profonde d'un arbre ; les instances rencontrées restent partagées. */
+    class VisiteurClonage : public VisiteurForme {
+    public:
+        std::unique_ptr<Forme> resultat;
+
+        void visite(const Cercle& cercle) override { resultat.reset(new Cercle(cercle)); }
+        void visite(const Segment& segment) override { resultat.reset(new Segment(segment)); }
+        void visite(const Polygone& polygone) override { resultat.reset(new Polygone(polygone)); }
+
+        void visite(const Groupe& groupe) override {
+            std::unique_ptr<Groupe> copie(new Groupe(groupe.getCouleur()));
+            for (const Forme* f : groupe.getFormes()) {
+                f->accepte(this);
+                copie->ajouter(resultat.release());
+            }
+            resultat = std::move(copie);
+        }
+
+        void visite(const Instance& instance) override {
+            resultat.reset(new Instance(instance.getPartage(), instance.getTransformation(), instance.getCouleur()));
+        }
+    };
+
+    /** @brief Copie de @p groupe sous la couleur @p couleur. */
+    std::unique_ptr<Groupe> cloner(const Groupe& groupe, const std::string& couleur) {
+        VisiteurClonage clonage;
+        std::unique_ptr<Groupe> copie(new Groupe(couleur));
+        for (const Forme* f : groupe.getFormes()) {
+            f->accepte(&clonage);
+            copie->ajouter(clonage.resultat.release());
+        }
+        return copie;
+    }
+
+    /** @brief Boîte exacte des formes d'une instance, placées une à une sans copier le prototype. */
+    class VisiteurBoite : public VisiteurForme {
+    public:
+        Boite2D resultat;
+
+        void visite(const Cercle& cercle) override {
+            const Vecteur2D c = placer(cercle.getCentre());
+            const double r = placer(cercle.getRayon());
+            resultat.etendre(Boite2D(c.x - r, c.y - r, c.x + r, c.y + r));
+        }
+        void visite(const Segment& segment) override {
+            resultat.etendre(placer(segment.getP1()));
+            resultat.etendre(placer(segment.getP2()));
+        }
+        void visite(const Polygone& polygone) override {
+            for (const Vecteur2D& s : polygone.getSommets()) resultat.etendre(placer(s));
+        }
+        void visite(const Groupe& groupe) override {
+            for (const Forme* f : groupe.getFormes()) f->accepte(this);
+        }
+    };
+
+    /** @brief Vrai si la partie linéaire ne fait pas tourner les axes (boîte transformée exacte). */
+    bool sansRotation(const Transformation2D& m) { return m.b == 0 && m.c == 0; }
+}
+
+void VisiteurForme::visite(const Instance& instance) {
+    visiterPrototype(instance);
+}
+
+void VisiteurForme::visiterPrototype(const Instance& instance) {
+    const Transformation2D repere = _repere;
+    const Groupe* const prototype = _prototype;
+    const std::string* const couleur = _couleurInstance;
+    // Instance imbriquée : sa transformation s'applique avant celle de l'instance englobante.
+    _repere = instance.getTransformation();
+    if (prototype) _repere.puis(repere);
+    _prototype = &instance.getPrototype();
+    _couleurInstance = &instance.getCouleur();
+    try {
+        _prototype->accepte(this);
+    }
+    catch (...) {
+        _repere = repere;
+        _prototype = prototype;
+        _couleurInstance = couleur;
+        throw;
+    }
+    _repere = repere;
+    _prototype = prototype;
+    _couleurInstance = couleur;
+}
+
+const Vecteur2D* VisiteurForme::placer(const Polygone& polygone, std::vector<Vecteur2D>& places) const {
+    const Polygone::Sommets& sommets = polygone.getSommets();
+    if (!_prototype) return sommets.data();
+    places.resize(sommets.size());
+    for (std::size_t i = 0; i < sommets.size(); ++i) places[i] = _repere.appliquer(sommets[i]);
+    return places.data();
+}
+
+const std::string& VisiteurForme::couleurGroupe(const Groupe& groupe) const {
+    return &groupe == _prototype ? *_couleurInstance : groupe.getCouleur();
+}
+
+Instance::Instance(std::shared_ptr<const Groupe> prototype, const Transformation2D& transformation,
+                   const std::string& couleur)
+    : Forme(couleur), _prototype(std::move(prototype)), _transformation(transformation) {
+    if (!_prototype) throw std::invalid_argument("Instance sans prototype");
+    if (_prototype->getParent()) throw std::invalid_argument("Le prototype d'une instance ne doit appartenir a aucun groupe");
+    preparer();
+}
+
+std::shared_ptr<const Groupe> Instance::partager(Groupe* g) {
+    return std::shared_ptr<const Groupe>(g);
+}
+
+void Instance::preparer() const {
+    _prototype->calculerAire();
+    _prototype->calculerPerimetre();
+    _prototype->calculerBoite();
+}
+
+void Instance::transformer(const Transformation2D& m) {
+    _transformation.puis(m);
+    _boiteValide = false;
+}
+
+Groupe& Instance::modifier() {
+    synchroniser();
+    if (estPartagee()) _prototype = cloner(*_prototype, _prototype->getCouleur());
+    _boiteValide = false;
+    marquerModifiee();
+    // Le prototype n'est plus partagé : le seul propriétaire peut le modifier.
+    return const_cast<Groupe&>(*_prototype);
+}
+
+std::unique_ptr<Groupe> Instance::developper() const {
+    synchroniser();
+    std::unique_ptr<Groupe> g = cloner(*_prototype, _couleur);
+    g->appliquer(_transformation);
+    return g;
+}
+
+std::size_t Instance::nbFeuilles() const {
+    return _prototype->nbFeuilles();
+}
+
+void Instance::translation(const Vecteur2D& v) {
+    PPIL_COMPTER(GROUPE, TRANSFORMATION);
+    synchroniser();
+    transformer(Transformation2D::translation(v));
+    marquerModifiee();
+}
+
+void Instance::homothetie(const Vecteur2D& centre, double rapport) {
+    PPIL_COMPTER(GROUPE, TRANSFORMATION);
+    synchroniser();
+    transformer(Transformation2D::homothetie(centre, rapport));
+    marquerModifiee();
+}
+
+void Instance::rotation(const Vecteur2D& centre, double angle) {
+    PPIL_COMPTER(GROUPE, TRANSFORMATION);
+    synchroniser();
+    transformer(Transformation2D::rotation(centre, angle));
+    marquerModifiee();
+}
+
+double Instance::calculerAire() const {
+    synchroniser();
+    return _prototype->calculerAire() * std::abs(_transformation.determinant());
+}
+
+double Instance::calculerPerimetre() const {
+    synchroniser();
+    return _prototype->calculerPerimetre() * _transformation.echelle();
+}
+
+Boite2D Instance::calculerBoite() const {
+    synchroniser();
+    if (sansRotation(_transformation)) return _prototype->calculerBoite().transformee(_transformation);
+    if (!_boiteValide || _versionPrototype != _prototype->getVersionSousArbre()) {
+        VisiteurBoite boite;
+        accepte(&boite);
+        _boite = boite.resultat;
+        _versionPrototype = _prototype->getVersionSousArbre();
+        _boiteValide = true;
+    }
+    return _boite;
+}
+
+void Instance::accepte(VisiteurForme* v) const {
+    PPIL_COMPTER(GROUPE, VISITE);
+    PPIL_CHRONO("visite Instance");
+    synchroniser();
+    v->visite(*this);
+}
+
+Instance::operator std::string() const {
+    return FormatTexte::description(*this);
+}
@@ -0,0 +1,297 @@
+/**
+ * @file Instrumentation.cpp
+ * @brief Registres par thread, fusion et écriture du résumé et de la trace.
+ */
+
+#include "../header/Instrumentation.h"
+#include <ostream>
+
+#ifdef PPIL_INSTRUMENTATION
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "../header/TamponFichier.h"
+
+namespace {
+    using namespace Instrumentation;
+
+    /**
+     * @brief Durées cumulées d'un site pour un thread.
+     * @details Les bases sont les valeurs lues au dernier reinitialiser() ; elles ne sont lues et
+     * écrites que sous le verrou global.
+     */
+    struct Cumul {
+        std::atomic<std::uint64_t> appels{ 0 };
+        std::atomic<std::uint64_t> totalNs{ 0 };
+        std::atomic<std::uint64_t> maxNs{ 0 };
+        std::atomic<std::uint64_t> epoqueMax{ 0 }; ///< Époque de maxNs : un maximum plus ancien ne compte plus.
+        std::uint64_t baseAppels = 0;
+        std::uint64_t baseTotalNs = 0;
+    };
+
+    struct EvenementTrace {
+        std::uint32_t site;
+        std::int64_t debutNs;
+        std::int64_t dureeNs;
+    };
+
+    /** @brief Événements par morceau de trace ; un morceau alloué n'est jamais déplacé. */
+    const std::size_t EVENEMENTS_PAR_MORCEAU = 4096;
+    const std::size_t NB_MORCEAUX = (MAX_EVENEMENTS_TRACE + EVENEMENTS_PAR_MORCEAU - 1) / EVENEMENTS_PAR_MORCEAU;
+
+    struct Morceau {
+        EvenementTrace evenements[EVENEMENTS_PAR_MORCEAU];
+    };
+
+    /**
+     * @brief Tout ce qu'un thread a mesuré.
+     * @details Seul le thread propriétaire écrit. Sa trace est une suite de morceaux fixes : un
+     * événement est écrit à sa place, puis publié en avançant nbEvenements (libération) ; un
+     * lecteur ne lit que les événements publiés, que plus personne n'écrit.
+     */
+    struct Registre {
+        Compteurs compteurs;
+        Cumul cumuls[MAX_SITES];
+        std::uint32_t numero = 0;                        ///< Numéro du thread dans la trace.
+        std::atomic<Morceau*> morceaux[NB_MORCEAUX] = {}; ///< Alloués à la demande.
+        std::atomic<std::size_t> nbEvenements{ 0 };      ///< Événements publiés.
+        std::atomic<std::uint64_t> evenementsPerdus{ 0 };
+
+        /** @name Bases du dernier reinitialiser(), sous le verrou global @{ */
+        std::uint64_t baseCompteurs[NB_TYPES][NB_EVENEMENTS] = {};
+        std::size_t baseEvenements = 0;
+        std::uint64_t basePerdus = 0;
+        /** @} */
+
+        ~Registre() {
+            for (auto& m : morceaux) delete m.load(std::memory_order_relaxed);
+        }
+    };
+
+    /** @brief Registres de tous les threads, conservés après leur fin pour la fusion. */
+    struct Global {
+        std::mutex verrou;
+        std::vector<std::unique_ptr<Registre>> registres;
+        std::atomic<const char*> noms[MAX_SITES] = {};
+        std::atomic<std::uint32_t> nbSites{ 0 };
+        std::atomic<std::uint64_t> epoque{ 0 }; ///< Nombre de reinitialiser().
+        const std::chrono::steady_clock::time_point origine = std::chrono::steady_clock::now();
+    };
+
+    Global& global() {
+        static Global g; // Jamais détruit avant les registres qu'il possède.
+        return g;
+    }
+
+    thread_local Registre* registreCourant = nullptr;
+
+    Registre& registre() {
+        if (registreCourant) return *registreCourant;
+        auto nouveau = std::make_unique<Registre>();
+        Global& g = global();
+        std::lock_guard<std::mutex> verrou(g.verrou);
+        nouveau->numero = static_cast<std::uint32_t>(g.registres.size() + 1);
+        registreCourant = nouveau.get();
+        compteursCourants = &nouveau->compteurs;
+        g.registres.push_back(std::move(nouveau));
+        return *registreCourant;
+    }
+
+    std::int64_t maintenantNs() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - global().origine).count();
+    }
+
+    void ajouter(std::atomic<std::uint64_t>& v, std::uint64_t n) {
+        v.store(v.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+    /** @brief Valeur d'un compteur du registre depuis le dernier reinitialiser() (verrou global tenu). */
+    std::uint64_t valeurCompteur(const Registre& r, int type, int evenement) {
+        return r.compteurs.valeurs[type][evenement].load(std::memory_order_relaxed) - r.baseCompteurs[type][evenement];
+    }
+
+    /** @brief Ajoute un événement à la trace du thread propriétaire de @p r, sans verrou. */
+    void tracer(Registre& r, std::uint32_t site, std::int64_t debut, std::int64_t duree) {
+        const std::size_t n = r.nbEvenements.load(std::memory_order_relaxed);
+        if (n >= MAX_EVENEMENTS_TRACE) {
+            ajouter(r.evenementsPerdus, 1);
+            return;
+        }
+        std::atomic<Morceau*>& place = r.morceaux[n / EVENEMENTS_PAR_MORCEAU];
+        Morceau* m = place.load(std::memory_order_relaxed);
+        if (!m) {
+            m = new Morceau;
+            place.store(m, std::memory_order_relaxed); // Publié avec l'événement, ci-dessous.
+        }
+        m->evenements[n % EVENEMENTS_PAR_MORCEAU] = EvenementTrace{ site, debut, duree };
+        r.nbEvenements.store(n + 1, std::memory_order_release);
+    }
+
+    const char* const NOMS_TYPES[NB_TYPES] = { "Cercle", "Segment", "Polygone", "Groupe" };
+    const char* const NOMS_EVENEMENTS[NB_EVENEMENTS] = { "visites", "transformations", "aires" };
+}
+
+namespace Instrumentation {
+
+    Compteurs& creerCompteurs() {
+        return registre().compteurs;
+    }
+
+    Site::Site(const char* n) : nom(n) {
+        Global& g = global();
+        // Sites en surnombre : regroupés dans le dernier.
+        indice = std::min<std::uint32_t>(g.nbSites.fetch_add(1, std::memory_order_relaxed), MAX_SITES - 1);
+        const char* attendu = nullptr;
+        g.noms[indice].compare_exchange_strong(attendu, n, std::memory_order_release);
+    }
+
+    Chrono::Chrono(const Site& site) : _site(site), _debut(maintenantNs()) {}
+
+    Chrono::~Chrono() {
+        const std::int64_t duree = maintenantNs() - _debut;
+        Registre& r = registre();
+        Cumul& c = r.cumuls[_site.indice];
+        ajouter(c.appels, 1);
+        ajouter(c.totalNs, static_cast<std::uint64_t>(duree));
+        // Premier appel depuis reinitialiser() : le maximum repart de cette durée.
+        const std::uint64_t epoque = global().epoque.load(std::memory_order_relaxed);
+        if (c.epoqueMax.load(std::memory_order_relaxed) != epoque) {
+            c.maxNs.store(static_cast<std::uint64_t>(duree), std::memory_order_relaxed);
+            c.epoqueMax.store(epoque, std::memory_order_release);
+        }
+        else if (static_cast<std::uint64_t>(duree) > c.maxNs.load(std::memory_order_relaxed)) {
+            c.maxNs.store(static_cast<std::uint64_t>(duree), std::memory_order_relaxed);
+        }
+        tracer(r, _site.indice, _debut, duree);
+    }
+
+    std::uint64_t compteur(TypeForme type, Evenement evenement) {
+        Global& g = global();
+        std::lock_guard<std::mutex> verrou(g.verrou);
+        std::uint64_t total = 0;
+        for (const auto& r : g.registres) total += valeurCompteur(*r, type, evenement);
+        return total;
+    }
+
+    void ecrireResume(std::ostream& sortie) {
+        Global& g = global();
+        std::lock_guard<std::mutex> verrou(g.verrou);
+        char ligne[256];
+
+        sortie << "Compteurs (" << g.registres.size() << " thread(s))\n";
+        std::snprintf(ligne, sizeof(ligne), "  %-10s %16s %16s %16s\n", "", NOMS_EVENEMENTS[0], NOMS_EVENEMENTS[1], NOMS_EVENEMENTS[2]);
+        sortie << ligne;
+        for (int t = 0; t < NB_TYPES; ++t) {
+            std::uint64_t v[NB_EVENEMENTS] = {};
+            for (const auto& r : g.registres) {
+                for (int e = 0; e < NB_EVENEMENTS; ++e) v[e] += valeurCompteur(*r, t, e);
+            }
+            std::snprintf(ligne, sizeof(ligne), "  %-10s %16llu %16llu %16llu\n", NOMS_TYPES[t],
+                          static_cast<unsigned long long>(v[0]), static_cast<unsigned long long>(v[1]),
+                          static_cast<unsigned long long>(v[2]));
+            sortie << ligne;
+        }
+
+        sortie << "Chronometres (temps inclusif)\n";
+        std::snprintf(ligne, sizeof(ligne), "  %-34s %12s %12s %12s %12s\n", "site", "appels", "total ms", "moyen us", "max us");
+        sortie << ligne;
+        const std::uint32_t nbSites = std::min<std::uint32_t>(g.nbSites.load(std::memory_order_relaxed), MAX_SITES);
+        const std::uint64_t epoque = g.epoque.load(std::memory_order_relaxed);
+        for (std::uint32_t s = 0; s < nbSites; ++s) {
+            std::uint64_t appels = 0, total = 0, max = 0;
+            for (const auto& r : g.registres) {
+                const Cumul& c = r->cumuls[s];
+                appels += c.appels.load(std::memory_order_relaxed) - c.baseAppels;
+                total += c.totalNs.load(std::memory_order_relaxed) - c.baseTotalNs;
+                if (c.epoqueMax.load(std::memory_order_acquire) == epoque) {
+                    max = std::max<std::uint64_t>(max, c.maxNs.load(std::memory_order_relaxed));
+                }
+            }
+            if (appels == 0) continue;
+            const char* nom = g.noms[s].load(std::memory_order_acquire);
+            std::snprintf(ligne, sizeof(ligne), "  %-34s %12llu %12.3f %12.3f %12.3f\n", nom ? nom : "?",
+                          static_cast<unsigned long long>(appels), total / 1e6, total / 1e3 / appels, max / 1e3);
+            sortie << ligne;
+        }
+    }
+
+    bool ecrireTrace(const std::string& nomFichier) {
+        Global& g = global();
+        std::lock_guard<std::mutex> verrou(g.verrou);
+        try {
+            TamponFichier sortie(nomFichier);
+            sortie.ecrire(std::string("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n"));
+            char ligne[512];
+            auto ecrireLigne = [&](int n) { sortie.ecrire(ligne, std::min<std::size_t>(static_cast<std::size_t>(n), sizeof(ligne) - 1)); };
+            bool premier = true;
+            std::uint64_t perdus = 0;
+            for (const auto& r : g.registres) {
+                perdus += r->evenementsPerdus.load(std::memory_order_relaxed) - r->basePerdus;
+                ecrireLigne(std::snprintf(ligne, sizeof(ligne), "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"thread %u\"}}",
+                                          premier ? "" : ",\n", r->numero, r->numero));
+                premier = false;
+                const std::size_t n = r->nbEvenements.load(std::memory_order_acquire);
+                for (std::size_t i = r->baseEvenements; i < n; ++i) {
+                    const EvenementTrace& e =
+                        r->morceaux[i / EVENEMENTS_PAR_MORCEAU].load(std::memory_order_relaxed)->evenements[i % EVENEMENTS_PAR_MORCEAU];
+                    const char* nom = g.noms[e.site].load(std::memory_order_acquire);
+                    // ts et dur en microsecondes, comme l'attend le format.
+                    ecrireLigne(std::snprintf(ligne, sizeof(ligne), ",\n{\"name\":\"%s\",\"cat\":\"PPIL\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+                                              nom ? nom : "?", e.debutNs / 1e3, e.dureeNs / 1e3, r->numero));
+                }
+            }
+            ecrireLigne(std::snprintf(ligne, sizeof(ligne), "\n],\"otherData\":{\"evenementsPerdus\":%llu}}\n",
+                                      static_cast<unsigned long long>(perdus)));
+            sortie.valider();
+        }
+        catch (const std::exception&) {
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @details Les registres ne sont écrits que par leur thread : les remettre à zéro d'ici
+     * perdrait les incréments en cours. Leur état actuel est noté comme base, soustraite à
+     * chaque lecture ; les maximums sont ceux de la nouvelle époque.
+     */
+    void reinitialiser() {
+        Global& g = global();
+        std::lock_guard<std::mutex> verrou(g.verrou);
+        g.epoque.fetch_add(1, std::memory_order_relaxed);
+        for (const auto& r : g.registres) {
+            for (int t = 0; t < NB_TYPES; ++t) {
+                for (int e = 0; e < NB_EVENEMENTS; ++e) {
+                    r->baseCompteurs[t][e] = r->compteurs.valeurs[t][e].load(std::memory_order_relaxed);
+                }
+            }
+            for (Cumul& c : r->cumuls) {
+                c.baseAppels = c.appels.load(std::memory_order_relaxed);
+                c.baseTotalNs = c.totalNs.load(std::memory_order_relaxed);
+            }
+            r->baseEvenements = r->nbEvenements.load(std::memory_order_acquire);
+            r->basePerdus = r->evenementsPerdus.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+#else
+
+namespace Instrumentation {
+
+    std::uint64_t compteur(TypeForme, Evenement) { return 0; }
+
+    void ecrireResume(std::ostream& sortie) {
+        sortie << "Instrumentation non compilee (option CMake PPIL_INSTRUMENTATION)\n";
+    }
+
+    bool ecrireTrace(const std::string&) { return false; }
+
+    void reinitialiser() {}
+}
+
+#endif
@@ -0,0 +1,216 @@
+/**
+ * @file JournalTransformations.cpp
+ * @brief Notation, annulation et rétablissement des transformations ; points de reprise.
+ */
+
+#include "../header/JournalTransformations.h"
+#include "../header/Cercle.h"
+#include "../header/Segement.h"
+#include "../header/Polygone.h"
+#include "../header/Group.h"
+#include "../header/Instance.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+JournalTransformations::JournalTransformations(Groupe& racine, std::size_t intervalleCheckpoint,
+                                               std::size_t nbCheckpointsMax)
+    : _racine(racine), _intervalleCheckpoint(intervalleCheckpoint), _nbCheckpointsMax(nbCheckpointsMax) {}
+
+JournalTransformations::Chemin JournalTransformations::chemin(const Forme& f) const {
+    Chemin c;
+    for (const Forme* g = &f; g != &_racine; g = g->getParent()) {
+        const Groupe* parent = static_cast<const Groupe*>(g->getParent());
+        if (!parent) throw std::invalid_argument("La forme n'appartient pas a la scene du journal");
+        const vector<Forme*>& formes = parent->getFormes();
+        c.push_back(static_cast<std::uint32_t>(std::find(formes.begin(), formes.end(), g) - formes.begin()));
+    }
+    std::reverse(c.begin(), c.end());
+    return c;
+}
+
+Forme& JournalTransformations::resoudre(const std::uint32_t* chemin, std::size_t longueur) const {
+    Forme* f = &_racine;
+    for (std::size_t i = 0; i < longueur; ++i) {
+        Groupe* g = dynamic_cast<Groupe*>(f);
+        if (!g || chemin[i] >= g->getFormes().size()) {
+            throw std::out_of_range("Chemin de forme invalide : la structure de la scene a change");
+        }
+        f = g->getFormes()[chemin[i]];
+    }
+    return *f;
+}
+
+void JournalTransformations::appliquer(Forme& f, const Entree& e, bool inverse) {
+    const Vecteur2D p(e.x, e.y);
+    switch (e.type) {
+    case TRANSLATION: f.translation(inverse ? Vecteur2D(-e.x, -e.y) : p); break;
+    case HOMOTHETIE:  f.homothetie(p, inverse ? 1 / e.parametre : e.parametre); break;
+    case ROTATION:    f.rotation(p, inverse ? -e.parametre : e.parametre); break;
+    }
+}
+
+bool JournalTransformations::estInversible(const Entree& e) {
+    if (!std::isfinite(e.x) || !std::isfinite(e.y)) return false;
+    switch (e.type) {
+    case TRANSLATION: return true;
+    case HOMOTHETIE:  return std::isnormal(e.parametre) && std::isnormal(1 / e.parametre);
+    case ROTATION:    return std::isfinite(e.parametre);
+    }
+    return false;
+}
+
+void JournalTransformations::restaurer(Forme& f, const FormeValeur& v) {
+    // Les formes sont atteintes par getFormes() : aucune transformation d'ancêtre n'est en attente.
+    const auto differente = [] { return std::logic_error("La structure de la scene ne correspond plus a la copie"); };
+    visiter(Surcharges{
+        [&](const CercleValeur& c) {
+            Cercle* cercle = dynamic_cast<Cercle*>(&f);
+            if (!cercle) throw differente();
+            cercle->_centre = c.centre;
+            cercle->_rayon = c.rayon;
+            cercle->marquerModifiee();
+        },
+        [&](const SegmentValeur& s) {
+            Segment* segment = dynamic_cast<Segment*>(&f);
+            if (!segment) throw differente();
+            segment->_p1 = s.p1;
+            segment->_p2 = s.p2;
+            segment->marquerModifiee();
+        },
+        [&](const PolygoneValeur& p) {
+            Polygone* polygone = dynamic_cast<Polygone*>(&f);
+            if (!polygone) throw differente();
+            polygone->_sommets.assigner(p.sommets.data(), p.sommets.data() + p.sommets.size());
+            polygone->_cache.invalider();
+            polygone->marquerModifiee();
+        },
+        [&](const GroupeValeur& g) {
+            if (Instance* instance = dynamic_cast<Instance*>(&f)) {
+                // Une instance intacte garde son prototype partagé ; sinon elle reçoit le sien.
+                if (SceneValeur::versValeur(*instance) == v) return;
+                instance->_prototype = Instance::partager(static_cast<Groupe*>(SceneValeur::versForme(v)));
+                instance->_transformation = Transformation2D();
+                instance->_boiteValide = false;
+                instance->marquerModifiee();
+                return;
+            }
+            Groupe* groupe = dynamic_cast<Groupe*>(&f);
+            if (!groupe || groupe->getFormes().size() != g.formes.size()) throw differente();
+            const vector<Forme*>& formes = groupe->getFormes();
+            for (std::size_t i = 0; i < formes.size(); ++i) restaurer(*formes[i], g.formes[i]);
+        } }, v);
+}
+
+const JournalTransformations::Checkpoint* JournalTransformations::checkpointA(std::size_t position) const {
+    for (const Checkpoint& c : _checkpoints) {
+        if (c.position == position) return &c;
+    }
+    return nullptr;
+}
+
+void JournalTransformations::tronquer() {
+    if (_position == _entrees.size()) return;
+    _chemins.resize(_entrees[_position].debutChemin);
+    for (std::size_t i = _position; i < _entrees.size(); ++i) {
+        if (_entrees[i].instantane >= 0) {
+            _instantanes.resize(static_cast<std::size_t>(_entrees[i].instantane));
+            break;
+        }
+    }
+    _entrees.resize(_position);
+    while (!_checkpoints.empty() && _checkpoints.back().position > _position) _checkpoints.pop_back();
+}
+
+void JournalTransformations::noter(Forme& cible, const Chemin& chemin, TypeTransformation type,
+                                   const Vecteur2D& p, double parametre) {
+    tronquer();
+    Entree e{ p.x, p.y, parametre, static_cast<std::uint32_t>(_chemins.size()),
+              static_cast<std::uint32_t>(chemin.size()), -1, type };
+    if (!estInversible(e)) {
+        _instantanes.push_back(SceneValeur::versValeur(cible));
+        e.instantane = static_cast<std::int32_t>(_instantanes.size() - 1);
+    }
+    _chemins.insert(_chemins.end(), chemin.begin(), chemin.end());
+    _entrees.push_back(e);
+    appliquer(cible, e, false);
+    ++_position;
+    _travail += cible.nbFeuilles();
+
+    if (!_intervalleCheckpoint || !_nbCheckpointsMax) return;
+    const std::size_t precedent = _checkpoints.empty() ? 0 : _checkpoints.back().position;
+    if (_position - precedent >= _intervalleCheckpoint && _travail >= _racine.nbFeuilles()) {
+        _checkpoints.push_back(Checkpoint{ _position, SceneValeur::versValeur(_racine) });
+        if (_checkpoints.size() > _nbCheckpointsMax) _checkpoints.pop_front();
+        _travail = 0;
+    }
+}
+
+void JournalTransformations::translation(Forme& cible, const Vecteur2D& v) {
+    noter(cible, chemin(cible), TRANSLATION, v, 0);
+}
+
+void JournalTransformations::homothetie(Forme& cible, const Vecteur2D& centre, double rapport) {
+    noter(cible, chemin(cible), HOMOTHETIE, centre, rapport);
+}
+
+void JournalTransformations::rotation(Forme& cible, const Vecteur2D& centre, double angle) {
+    noter(cible, chemin(cible), ROTATION, centre, angle);
+}
+
+void JournalTransformations::translation(const Chemin& cible, const Vecteur2D& v) {
+    noter(resoudre(cible), cible, TRANSLATION, v, 0);
+}
+
+void JournalTransformations::homothetie(const Chemin& cible, const Vecteur2D& centre, double rapport) {
+    noter(resoudre(cible), cible, HOMOTHETIE, centre, rapport);
+}
+
+void JournalTransformations::rotation(const Chemin& cible, const Vecteur2D& centre, double angle) {
+    noter(resoudre(cible), cible, ROTATION, centre, angle);
+}
+
+bool JournalTransformations::annuler() {
+    if (!peutAnnuler()) return false;
+    const Entree& e = _entrees[--_position];
+    if (const Checkpoint* c = checkpointA(_position)) restaurer(_racine, c->scene);
+    else if (e.instantane >= 0) {
+        restaurer(resoudre(_chemins.data() + e.debutChemin, e.longueurChemin), _instantanes[e.instantane]);
+    }
+    else appliquer(resoudre(_chemins.data() + e.debutChemin, e.longueurChemin), e, true);
+    return true;
+}
+
+bool JournalTransformations::retablir() {
+    if (!peutRetablir()) return false;
+    const Entree& e = _entrees[_position++];
+    if (const Checkpoint* c = checkpointA(_position)) restaurer(_racine, c->scene);
+    else appliquer(resoudre(_chemins.data() + e.debutChemin, e.longueurChemin), e, false);
+    return true;
+}
+
+void JournalTransformations::revenirA(std::size_t position) {
+    if (position > _entrees.size()) throw std::out_of_range("Position au-dela de la fin du journal");
+    const std::size_t pas = position > _position ? position - _position : _position - position;
+
+    // Point de reprise le plus proche avant la cible : préférable s'il laisse moins d'entrées à rejouer.
+    const Checkpoint* reprise = nullptr;
+    for (const Checkpoint& c : _checkpoints) {
+        if (c.position <= position) reprise = &c;
+    }
+    if (reprise && position - reprise->position < pas) {
+        restaurer(_racine, reprise->scene);
+        _position = reprise->position;
+    }
+    while (_position > position) annuler();
+    while (_position < position) retablir();
+}
+
+void JournalTransformations::vider() {
+    _entrees.clear();
+    _chemins.clear();
+    _instantanes.clear();
+    _checkpoints.clear();
+    _position = 0;
+    _travail = 0;
+}
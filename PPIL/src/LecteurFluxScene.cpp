@@ -0,0 +1,367 @@
+/**
+ * @file LecteurFluxScene.cpp
+ * @brief Implémentation de la lecture en flux des fichiers de sauvegarde.
+ */
+
+#include "../header/LecteurFluxScene.h"
+#include "../header/AnalyseTexte.h"
+#include "../header/FormatBinaire.h"
+#include "../header/Cercle.h"
+#include "../header/Segement.h"
+#include "../header/Polygone.h"
+#include "../header/Group.h"
+#include "../header/Instance.h"
+#include "../header/ChargeurBinaire.h"
+#include <cstring>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+    /**
+     * @brief Fenêtre glissante sur un fichier lu par blocs.
+     * @details Le bloc n'est agrandi que si une unité (ligne, polygone) ne tient pas dedans.
+     */
+    class TamponLecture {
+    private:
+        std::ifstream _flux;
+        std::vector<char> _bloc;
+        std::size_t _debut;       ///< Premier octet non consommé.
+        std::size_t _fin;         ///< Fin des octets valides du bloc.
+        std::uint64_t _position;  ///< Position absolue de _bloc[_debut] dans le fichier.
+        std::uint64_t _taille;    ///< Taille du fichier à l'ouverture.
+        bool _finFichier;
+
+    public:
+        TamponLecture(const std::string& nomFichier, std::size_t tailleBloc)
+            : _flux(nomFichier, std::ios::binary), _bloc(tailleBloc ? tailleBloc : 1),
+              _debut(0), _fin(0), _position(0), _taille(0), _finFichier(false) {
+            if (!_flux) throw std::runtime_error("Impossible d'ouvrir le fichier : " + nomFichier);
+            _flux.seekg(0, std::ios::end);
+            _taille = static_cast<std::uint64_t>(_flux.tellg());
+            _flux.seekg(0);
+        }
+
+        const char* donnees() const { return _bloc.data() + _debut; }
+        std::size_t disponible() const { return _fin - _debut; }
+        std::uint64_t position() const { return _position; }
+
+        /** @brief Octets du fichier pas encore consommés : borne des tailles lues avant d'allouer. */
+        std::uint64_t restant() const { return _taille > _position ? _taille - _position : 0; }
+
+        /** @brief Vérifie que @p n octets peuvent encore suivre, sans rien lire ni allouer. */
+        void verifierRestant(std::uint64_t n) const {
+            if (n > restant()) throw std::runtime_error("Fichier binaire tronqué ou corrompu");
+        }
+        bool epuise() { return disponible() == 0 && !remplir(1); }
+
+        void avancer(std::size_t n) {
+            _debut += n;
+            _position += n;
+        }
+
+        /** @brief Garantit au moins @p n octets disponibles ; false si le fichier se termine avant. */
+        bool remplir(std::size_t n) {
+            while (disponible() < n) {
+                if (_finFichier) return false;
+                // Ramène les octets restants en tête du bloc, puis l'agrandit si nécessaire.
+                std::memmove(_bloc.data(), _bloc.data() + _debut, disponible());
+                _fin -= _debut;
+                _debut = 0;
+                if (_bloc.size() < n) _bloc.resize(n);
+                else if (_fin == _bloc.size()) _bloc.resize(_bloc.size() * 2);
+                _flux.read(_bloc.data() + _fin, static_cast<std::streamsize>(_bloc.size() - _fin));
+                std::size_t lus = static_cast<std::size_t>(_flux.gcount());
+                _fin += lus;
+                if (lus == 0 || _flux.eof()) _finFichier = true;
+            }
+            return true;
+        }
+
+        /** @brief Comme remplir(), mais un fichier trop court est une erreur. */
+        const char* exiger(std::size_t n) {
+            if (!remplir(n)) throw std::runtime_error("Fichier binaire tronqué ou corrompu");
+            return donnees();
+        }
+    };
+
+    void erreurLigne(std::size_t numero, const char* message) {
+        throw std::runtime_error(std::string(message) + " (ligne " + std::to_string(numero) + ")");
+    }
+
+    /** @brief Traite une ligne du format texte. */
+    void traiterLigne(std::string_view ligne, std::size_t numero, long& profondeur,
+                      std::vector<Vecteur2D>& sommets, VisiteurFlux& visiteur) {
+        ligne = AnalyseTexte::sansRetourChariot(ligne);
+        if (ligne.empty()) return;
+        std::string_view couleur;
+        if (ligne.starts_with(AnalyseTexte::PREFIXE_CERCLE)) {
+            Vecteur2D centre;
+            double rayon;
+            if (AnalyseTexte::analyserCercle(ligne.substr(AnalyseTexte::PREFIXE_CERCLE.size()), couleur, centre, rayon)) {
+                Cercle c(centre, rayon, std::string(couleur));
+                visiteur.visite(c);
+                return;
+            }
+        }
+        else if (ligne.starts_with(AnalyseTexte::PREFIXE_SEGMENT)) {
+            Vecteur2D p1, p2;
+            if (AnalyseTexte::analyserSegment(ligne.substr(AnalyseTexte::PREFIXE_SEGMENT.size()), couleur, p1, p2)) {
+                Segment s(p1, p2, std::string(couleur));
+                visiteur.visite(s);
+                return;
+            }
+        }
+        else if (ligne.starts_with(AnalyseTexte::PREFIXE_POLYGONE)) {
+            sommets.clear();
+            if (AnalyseTexte::analyserPolygone(ligne.substr(AnalyseTexte::PREFIXE_POLYGONE.size()), couleur, sommets)) {
+                Polygone p(sommets, std::string(couleur));
+                visiteur.visite(p);
+                return;
+            }
+        }
+        else if (ligne.starts_with(AnalyseTexte::PREFIXE_GROUPE)) {
+            std::string_view corps = ligne.substr(AnalyseTexte::PREFIXE_GROUPE.size());
+            if (corps.starts_with(AnalyseTexte::MARQUEUR_DEBUT)) {
+                ++profondeur;
+                visiteur.debutGroupe(std::string(corps.substr(AnalyseTexte::MARQUEUR_DEBUT.size())));
+                return;
+            }
+            if (corps == AnalyseTexte::MARQUEUR_FIN) {
+                if (--profondeur < 0) erreurLigne(numero, "Groupe;Fin sans Groupe;Debut correspondant");
+                visiteur.finGroupe();
+                return;
+            }
+        }
+        erreurLigne(numero, "Ligne non reconnue");
+    }
+
+    std::string lireCouleur(TamponLecture& t) {
+        std::uint8_t indice = static_cast<std::uint8_t>(*t.exiger(1));
+        t.avancer(1);
+        if (indice < FormatBinaire::TAILLE_PALETTE) return FormatBinaire::couleurPalette(indice);
+        if (indice != FormatBinaire::COULEUR_LIBRE) {
+            throw std::runtime_error("Indice de couleur inconnu dans le fichier binaire");
+        }
+        std::uint16_t longueur = FormatBinaire::decoder<std::uint16_t>(t.exiger(2));
+        t.avancer(2);
+        std::string couleur(t.exiger(longueur), longueur);
+        t.avancer(longueur);
+        return couleur;
+    }
+
+    /**
+     * @brief Transmet au visiteur de flux les formes d'une instance.
+     * @details Le prototype n'est pas copié : seule la forme en cours est placée, dans une copie
+     * temporaire qui ne vit que le temps de son passage au visiteur.
+     */
+    class RelaisFlux : public VisiteurForme {
+    private:
+        VisiteurFlux& _visiteur;
+
+        template<class T>
+        void transmettre(const T& forme) {
+            if (!dansInstance()) {
+                _visiteur.visite(forme);
+                return;
+            }
+            T placee(forme);
+            placee.appliquer(repere());
+            _visiteur.visite(placee);
+        }
+
+    public:
+        explicit RelaisFlux(VisiteurFlux& visiteur) : _visiteur(visiteur) {}
+
+        void visite(const Cercle& cercle) override { transmettre(cercle); }
+        void visite(const Segment& segment) override { transmettre(segment); }
+        void visite(const Polygone& polygone) override { transmettre(polygone); }
+        void visite(const Groupe& groupe) override {
+            _visiteur.debutGroupe(couleurGroupe(groupe));
+            for (const Forme* f : groupe.getFormes()) f->accepte(this);
+            _visiteur.finGroupe();
+        }
+    };
+
+    /** @brief Lit @p n réels consécutifs. */
+    void lireReels(TamponLecture& t, double* valeurs, std::size_t n) {
+        const char* p = t.exiger(n * 8);
+        for (std::size_t i = 0; i < n; ++i) valeurs[i] = FormatBinaire::decoderReel(p + 8 * i);
+        t.avancer(n * 8);
+    }
+
+    std::uint64_t lireVarint(TamponLecture& t) {
+        std::uint64_t v = 0;
+        for (int decalage = 0; decalage < 64; decalage += 7) {
+            const std::uint8_t o = static_cast<std::uint8_t>(*t.exiger(1));
+            t.avancer(1);
+            v |= static_cast<std::uint64_t>(o & 0x7F) << decalage;
+            if (!(o & 0x80)) return v;
+        }
+        throw std::runtime_error("Entier trop long dans le fichier binaire");
+    }
+
+    /**
+     * @brief Point suivant d'un enregistrement : réels en clair (pas nul) ou écart quantifié.
+     * @param precedent Point précédent de l'enregistrement, en pas.
+     */
+    Vecteur2D lirePoint(TamponLecture& t, double pas, std::int64_t (&precedent)[2]) {
+        if (!pas) {
+            double v[2];
+            lireReels(t, v, 2);
+            return Vecteur2D(v[0], v[1]);
+        }
+        for (std::int64_t& c : precedent) {
+            c = static_cast<std::int64_t>(static_cast<std::uint64_t>(c) +
+                                          static_cast<std::uint64_t>(FormatBinaire::dezigzag(lireVarint(t))));
+        }
+        return Vecteur2D(static_cast<double>(precedent[0]) * pas, static_cast<double>(precedent[1]) * pas);
+    }
+}
+
+void LecteurFluxScene::lireTexte(const std::string& nomFichier, VisiteurFlux& visiteur, std::size_t tailleBloc) {
+    TamponLecture t(nomFichier, tailleBloc);
+    std::vector<Vecteur2D> sommets;
+    std::size_t numero = 0;
+    long profondeur = 0;
+    std::size_t dejaParcouru = 0; // Octets déjà examinés sans trouver de fin de ligne.
+
+    while (!t.epuise()) {
+        const char* p = t.donnees();
+        const char* finLigne = static_cast<const char*>(
+            std::memchr(p + dejaParcouru, '\n', t.disponible() - dejaParcouru));
+        if (!finLigne) {
+            dejaParcouru = t.disponible();
+            if (t.remplir(t.disponible() + 1)) continue;
+            p = t.donnees(); // Le bloc a pu être compacté avant la détection de la fin du fichier.
+            finLigne = p + t.disponible(); // Dernière ligne sans '\n' final.
+        }
+        std::size_t longueur = static_cast<std::size_t>(finLigne - p);
+        traiterLigne(std::string_view(p, longueur), ++numero, profondeur, sommets, visiteur);
+        t.avancer(longueur < t.disponible() ? longueur + 1 : longueur);
+        dejaParcouru = 0;
+    }
+    if (profondeur != 0) erreurLigne(numero, "Groupe;Debut sans Groupe;Fin correspondant");
+}
+
+void LecteurFluxScene::lireBinaire(const std::string& nomFichier, VisiteurFlux& visiteur, std::size_t tailleBloc) {
+    TamponLecture t(nomFichier, tailleBloc);
+    const std::uint16_t drapeaux = FormatBinaire::lireEnTete(t.exiger(FormatBinaire::TAILLE_EN_TETE));
+    t.avancer(FormatBinaire::TAILLE_EN_TETE);
+    double pas = 0;
+    if (drapeaux & FormatBinaire::QUANTIFIE) {
+        pas = FormatBinaire::lirePas(t.exiger(8));
+        t.avancer(8);
+    }
+
+    std::vector<std::uint64_t> finsGroupes; // Position absolue de fin de chaque groupe ouvert.
+    std::vector<Vecteur2D> sommets;
+    ChargeurBinaire::Prototypes prototypes; // Seuls les prototypes restent en mémoire.
+    RelaisFlux relais(visiteur);
+    for (;;) {
+        while (!finsGroupes.empty() && t.position() == finsGroupes.back()) {
+            finsGroupes.pop_back();
+            visiteur.finGroupe();
+        }
+        if (!finsGroupes.empty() && t.position() > finsGroupes.back()) {
+            throw std::runtime_error("Enregistrement débordant de son groupe dans le fichier binaire");
+        }
+        if (t.epuise()) break;
+
+        std::uint8_t etiquette = static_cast<std::uint8_t>(*t.donnees());
+        t.avancer(1);
+        std::string couleur = lireCouleur(t);
+        switch (etiquette) {
+        case FormatBinaire::CERCLE: {
+            std::int64_t precedent[2] = {};
+            const Vecteur2D centre = lirePoint(t, pas, precedent);
+            double rayon;
+            if (pas) rayon = static_cast<double>(FormatBinaire::dezigzag(lireVarint(t))) * pas;
+            else lireReels(t, &rayon, 1);
+            if (!(rayon > 0)) throw std::runtime_error("Rayon invalide dans le fichier binaire");
+            Cercle c(centre, rayon, couleur);
+            visiteur.visite(c);
+            break;
+        }
+        case FormatBinaire::SEGMENT: {
+            std::int64_t precedent[2] = {};
+            const Vecteur2D p1 = lirePoint(t, pas, precedent);
+            const Vecteur2D p2 = lirePoint(t, pas, precedent);
+            Segment s(p1, p2, couleur);
+            visiteur.visite(s);
+            break;
+        }
+        case FormatBinaire::POLYGONE: {
+            std::uint64_t n;
+            if (pas) n = lireVarint(t);
+            else {
+                n = FormatBinaire::decoder<std::uint32_t>(t.exiger(4));
+                t.avancer(4);
+            }
+            // Un sommet occupe au moins 16 octets en clair, 2 quantifié : un nombre corrompu ne
+            // doit pas provoquer d'allocation démesurée.
+            if (n > t.restant() / (pas ? 2 : 16)) throw std::runtime_error("Fichier binaire tronqué ou corrompu");
+            sommets.clear();
+            sommets.reserve(static_cast<std::size_t>(n));
+            std::int64_t precedent[2] = {};
+            for (std::uint64_t i = 0; i < n; ++i) sommets.push_back(lirePoint(t, pas, precedent));
+            Polygone p(sommets, couleur);
+            visiteur.visite(p);
+            break;
+        }
+        case FormatBinaire::GROUPE: {
+            std::uint64_t longueur = FormatBinaire::decoder<std::uint64_t>(t.exiger(8));
+            t.avancer(8);
+            t.verifierRestant(longueur);
+            finsGroupes.push_back(t.position() + longueur);
+            visiteur.debutGroupe(couleur);
+            break;
+        }
+        case FormatBinaire::PROTOTYPE: {
+            std::uint32_t numero = FormatBinaire::decoder<std::uint32_t>(t.exiger(4));
+            t.avancer(4);
+            std::uint64_t longueur = FormatBinaire::decoder<std::uint64_t>(t.exiger(8));
+            t.avancer(8);
+            t.verifierRestant(longueur);
+            if (numero != prototypes.size()) {
+                throw std::runtime_error("Numéro de prototype inattendu dans le fichier binaire");
+            }
+            prototypes.emplace_back();
+            std::unique_ptr<Groupe> groupe(new Groupe(couleur));
+            ChargeurBinaire::chargerEnfants(t.exiger(static_cast<std::size_t>(longueur)),
+                                            static_cast<std::size_t>(longueur), *groupe, prototypes, pas);
+            t.avancer(static_cast<std::size_t>(longueur));
+            prototypes[numero] = std::move(groupe);
+            break;
+        }
+        case FormatBinaire::INSTANCE: {
+            std::uint32_t numero = FormatBinaire::decoder<std::uint32_t>(t.exiger(4));
+            t.avancer(4);
+            if (numero >= prototypes.size() || !prototypes[numero]) {
+                throw std::runtime_error("Instance d'un prototype non défini dans le fichier binaire");
+            }
+            double m[6];
+            lireReels(t, m, 6);
+            Instance instance(prototypes[numero], Transformation2D(m[0], m[1], m[2], m[3], m[4], m[5]), couleur);
+            instance.accepte(&relais);
+            break;
+        }
+        default:
+            throw std::runtime_error("Étiquette d'enregistrement inconnue dans le fichier binaire");
+        }
+    }
+    if (!finsGroupes.empty()) throw std::runtime_error("Fichier binaire tronqué ou corrompu");
+}
+
+void LecteurFluxScene::lire(const std::string& nomFichier, VisiteurFlux& visiteur, std::size_t tailleBloc) {
+    char signature[4] = {};
+    {
+        std::ifstream ifs(nomFichier, std::ios::binary);
+        if (!ifs) throw std::runtime_error("Impossible d'ouvrir le fichier : " + nomFichier);
+        ifs.read(signature, 4);
+    }
+    if (std::memcmp(signature, FormatBinaire::SIGNATURE, 4) == 0) lireBinaire(nomFichier, visiteur, tailleBloc);
+    else lireTexte(nomFichier, visiteur, tailleBloc);
+}
@@ -0,0 +1,303 @@
+/**
+ * @file NoyauxPolygone.cpp
+ * @brief Noyaux scalaire et AVX2 des sommes du lacet, des longueurs et des moments, découpage en paquets.
+ */
+
+#include "../header/NoyauxPolygone.h"
+#include "../header/Boite2D.h"
+#include "../header/PoolThreads.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && !defined(__AVX2__)
+ // Noyaux AVX2 compilés à part et choisis à l'exécution si le processeur le permet.
+#define PPIL_AVX2_DYNAMIQUE 1
+#define PPIL_CIBLE_AVX2 __attribute__((target("avx2")))
+#else
+#define PPIL_CIBLE_AVX2
+#endif
+
+#if defined(__AVX2__) || defined(PPIL_AVX2_DYNAMIQUE)
+#define PPIL_NOYAU_AVX2 1
+#include <immintrin.h>
+#endif
+
+static_assert(sizeof(Vecteur2D) == 2 * sizeof(double), "Les sommets sont lus comme une suite x0, y0, x1, y1, ...");
+
+namespace {
+    using namespace NoyauxPolygone;
+
+    /** @brief Quatre sommes de Kahan : valeurs et compensations. */
+    struct Voies {
+        double s[4] = {};
+        double c[4] = {};
+    };
+
+    struct VoiesCentroide {
+        Voies d, sx, sy; ///< Déterminants et moments (xi + xj).d, (yi + yj).d.
+    };
+
+    inline void kahan(double& s, double& c, double v) {
+        const double y = v - c;
+        const double t = s + y;
+        c = (t - s) - y;
+        s = t;
+    }
+
+    /** @brief Somme compensée d'une suite de valeurs. */
+    struct Somme {
+        double s = 0, c = 0;
+        void ajouter(double v) { kahan(s, c, v); }
+        void ajouter(const Voies& v) { for (int k = 0; k < 4; ++k) ajouter(v.s[k] - v.c[k]); }
+        double valeur() const { return s - c; }
+    };
+
+    /**
+     * @brief Voie de l'arête i + k d'un bloc de quatre arêtes : celle où le noyau AVX2 la range.
+     * @details _mm256_hsub_pd sur deux paires d'arêtes produit (i, i + 2, i + 1, i + 3).
+     */
+    const int VOIE[4] = { 0, 2, 1, 3 };
+
+    // Arête j : du sommet j au sommet j + 1 (p pointe sur x0, y0, x1, y1, ...).
+    inline double determinant(const double* p, std::size_t j, double rx, double ry) {
+        const double xi = p[2 * j] - rx, yi = p[2 * j + 1] - ry;
+        const double xj = p[2 * j + 2] - rx, yj = p[2 * j + 3] - ry;
+        return xi * yj - yi * xj;
+    }
+
+    inline double longueur(const double* p, std::size_t j) {
+        const double dx = p[2 * j + 2] - p[2 * j], dy = p[2 * j + 3] - p[2 * j + 1];
+        return std::sqrt(dx * dx + dy * dy);
+    }
+
+    using NoyauAire = void (*)(const double* p, std::size_t nbAretes, double rx, double ry, Voies& d);
+    using NoyauCentroide = void (*)(const double* p, std::size_t nbAretes, double rx, double ry, VoiesCentroide& v);
+    using NoyauPerimetre = void (*)(const double* p, std::size_t nbAretes, Voies& l);
+
+    // Les arêtes qui ne complètent pas un bloc de quatre vont toutes dans la voie 0.
+
+    void aireScalaire(const double* p, std::size_t m, double rx, double ry, Voies& d) {
+        std::size_t i = 0;
+        for (; i + 4 <= m; i += 4) {
+            for (int k = 0; k < 4; ++k) kahan(d.s[VOIE[k]], d.c[VOIE[k]], determinant(p, i + k, rx, ry));
+        }
+        for (; i < m; ++i) kahan(d.s[0], d.c[0], determinant(p, i, rx, ry));
+    }
+
+    void centroideScalaire(const double* p, std::size_t m, double rx, double ry, VoiesCentroide& v) {
+        auto ajouter = [&](std::size_t j, int voie) {
+            const double dd = determinant(p, j, rx, ry);
+            const double sx = (p[2 * j] - rx) + (p[2 * j + 2] - rx);
+            const double sy = (p[2 * j + 1] - ry) + (p[2 * j + 3] - ry);
+            kahan(v.d.s[voie], v.d.c[voie], dd);
+            kahan(v.sx.s[voie], v.sx.c[voie], sx * dd);
+            kahan(v.sy.s[voie], v.sy.c[voie], sy * dd);
+        };
+        std::size_t i = 0;
+        for (; i + 4 <= m; i += 4) {
+            for (int k = 0; k < 4; ++k) ajouter(i + k, VOIE[k]);
+        }
+        for (; i < m; ++i) ajouter(i, 0);
+    }
+
+    void perimetreScalaire(const double* p, std::size_t m, Voies& l) {
+        std::size_t i = 0;
+        for (; i + 4 <= m; i += 4) {
+            for (int k = 0; k < 4; ++k) kahan(l.s[VOIE[k]], l.c[VOIE[k]], longueur(p, i + k));
+        }
+        for (; i < m; ++i) kahan(l.s[0], l.c[0], longueur(p, i));
+    }
+
+#ifdef PPIL_NOYAU_AVX2
+    // Mêmes opérations, dans le même ordre, que les versions scalaires (pas de FMA).
+
+    PPIL_CIBLE_AVX2 inline void kahan4(__m256d& s, __m256d& c, __m256d v) {
+        const __m256d y = _mm256_sub_pd(v, c);
+        const __m256d t = _mm256_add_pd(s, y);
+        c = _mm256_sub_pd(_mm256_sub_pd(t, s), y);
+        s = t;
+    }
+
+    /** @brief Sommets i et i + 1, recentrés : (xi, yi, xi+1, yi+1). */
+    PPIL_CIBLE_AVX2 inline __m256d paire(const double* p, std::size_t i, __m256d r) {
+        return _mm256_sub_pd(_mm256_loadu_pd(p + 2 * i), r);
+    }
+
+    /** @brief Déterminants des arêtes i et i + 1 à partir de leurs paires de sommets (termes non soustraits). */
+    PPIL_CIBLE_AVX2 inline __m256d produits(__m256d a, __m256d b) {
+        return _mm256_mul_pd(a, _mm256_permute_pd(b, 0x5)); // (xi.yi+1, yi.xi+1, xi+1.yi+2, yi+1.xi+2)
+    }
+
+    PPIL_CIBLE_AVX2 void aireAVX2(const double* p, std::size_t m, double rx, double ry, Voies& d) {
+        const __m256d r = _mm256_setr_pd(rx, ry, rx, ry);
+        __m256d s = _mm256_setzero_pd(), c = _mm256_setzero_pd();
+        std::size_t i = 0;
+        for (; i + 4 <= m; i += 4) {
+            const __m256d a1 = paire(p, i, r), b1 = paire(p, i + 1, r);
+            const __m256d a2 = paire(p, i + 2, r), b2 = paire(p, i + 3, r);
+            kahan4(s, c, _mm256_hsub_pd(produits(a1, b1), produits(a2, b2)));
+        }
+        _mm256_storeu_pd(d.s, s);
+        _mm256_storeu_pd(d.c, c);
+        for (; i < m; ++i) kahan(d.s[0], d.c[0], determinant(p, i, rx, ry));
+    }
+
+    PPIL_CIBLE_AVX2 void centroideAVX2(const double* p, std::size_t m, double rx, double ry, VoiesCentroide& v) {
+        const __m256d r = _mm256_setr_pd(rx, ry, rx, ry);
+        __m256d sd = _mm256_setzero_pd(), cd = _mm256_setzero_pd();
+        __m256d sx = _mm256_setzero_pd(), cx = _mm256_setzero_pd();
+        __m256d sy = _mm256_setzero_pd(), cy = _mm256_setzero_pd();
+        std::size_t i = 0;
+        for (; i + 4 <= m; i += 4) {
+            const __m256d a1 = paire(p, i, r), b1 = paire(p, i + 1, r);
+            const __m256d a2 = paire(p, i + 2, r), b2 = paire(p, i + 3, r);
+            const __m256d dd = _mm256_hsub_pd(produits(a1, b1), produits(a2, b2));
+            const __m256d s1 = _mm256_add_pd(a1, b1), s2 = _mm256_add_pd(a2, b2);
+            kahan4(sd, cd, dd);
+            kahan4(sx, cx, _mm256_mul_pd(_mm256_unpacklo_pd(s1, s2), dd));
+            kahan4(sy, cy, _mm256_mul_pd(_mm256_unpackhi_pd(s1, s2), dd));
+        }
+        _mm256_storeu_pd(v.d.s, sd);
+        _mm256_storeu_pd(v.d.c, cd);
+        _mm256_storeu_pd(v.sx.s, sx);
+        _mm256_storeu_pd(v.sx.c, cx);
+        _mm256_storeu_pd(v.sy.s, sy);
+        _mm256_storeu_pd(v.sy.c, cy);
+        for (; i < m; ++i) {
+            const double dd = determinant(p, i, rx, ry);
+            kahan(v.d.s[0], v.d.c[0], dd);
+            kahan(v.sx.s[0], v.sx.c[0], ((p[2 * i] - rx) + (p[2 * i + 2] - rx)) * dd);
+            kahan(v.sy.s[0], v.sy.c[0], ((p[2 * i + 1] - ry) + (p[2 * i + 3] - ry)) * dd);
+        }
+    }
+
+    PPIL_CIBLE_AVX2 void perimetreAVX2(const double* p, std::size_t m, Voies& l) {
+        __m256d s = _mm256_setzero_pd(), c = _mm256_setzero_pd();
+        std::size_t i = 0;
+        for (; i + 4 <= m; i += 4) {
+            const __m256d d1 = _mm256_sub_pd(_mm256_loadu_pd(p + 2 * i + 2), _mm256_loadu_pd(p + 2 * i));
+            const __m256d d2 = _mm256_sub_pd(_mm256_loadu_pd(p + 2 * i + 6), _mm256_loadu_pd(p + 2 * i + 4));
+            const __m256d carres = _mm256_hadd_pd(_mm256_mul_pd(d1, d1), _mm256_mul_pd(d2, d2));
+            kahan4(s, c, _mm256_sqrt_pd(carres));
+        }
+        _mm256_storeu_pd(l.s, s);
+        _mm256_storeu_pd(l.c, c);
+        for (; i < m; ++i) kahan(l.s[0], l.c[0], longueur(p, i));
+    }
+#endif
+
+    struct Noyaux {
+        NoyauAire aire;
+        NoyauCentroide centroide;
+        NoyauPerimetre perimetre;
+        const char* nom;
+    };
+
+    Noyaux choisirNoyaux() {
+#if defined(__AVX2__)
+        return { aireAVX2, centroideAVX2, perimetreAVX2, "avx2" };
+#else
+#ifdef PPIL_AVX2_DYNAMIQUE
+        if (__builtin_cpu_supports("avx2")) return { aireAVX2, centroideAVX2, perimetreAVX2, "avx2" };
+#endif
+        return { aireScalaire, centroideScalaire, perimetreScalaire, "scalaire" };
+#endif
+    }
+
+    const Noyaux& noyaux() {
+        static const Noyaux choix = choisirNoyaux();
+        return choix;
+    }
+
+    const double* coordonnees(const Vecteur2D* sommets) { return &sommets[0].x; }
+
+    /**
+     * @brief Applique traiter(premiereArete, nbAretes, paquet) à chaque paquet des @p nbAretes arêtes.
+     * @details Le découpage ne dépend que de nbAretes : séquentiel ou réparti, chaque paquet
+     * est calculé de la même façon, puis les paquets sont cumulés dans l'ordre par l'appelant.
+     */
+    template <typename Paquet, typename F>
+    std::vector<Paquet> parPaquets(std::size_t nbAretes, PoolThreads* pool, const F& traiter) {
+        const std::size_t nb = (nbAretes + SOMMETS_PAR_PAQUET - 1) / SOMMETS_PAR_PAQUET;
+        std::vector<Paquet> paquets(nb);
+        auto tache = [&](std::size_t k) {
+            const std::size_t debut = k * SOMMETS_PAR_PAQUET;
+            traiter(debut, std::min(SOMMETS_PAR_PAQUET, nbAretes - debut), paquets[k]);
+        };
+        if (pool && nb > 1 && nbAretes + 1 >= SEUIL_PARALLELE) pool->executer(nb, tache);
+        else for (std::size_t k = 0; k < nb; ++k) tache(k);
+        return paquets;
+    }
+}
+
+namespace NoyauxPolygone {
+
+    double aireSignee(const Vecteur2D* sommets, std::size_t n, PoolThreads* pool) {
+        if (n < 3) return 0;
+        if (n < SEUIL_NOYAU) {
+            double aire = 0;
+            for (std::size_t i = 0; i + 1 < n; ++i) aire += sommets[i].determinant(sommets[i + 1]);
+            aire += sommets[n - 1].determinant(sommets[0]);
+            return aire / 2;
+        }
+        const double* p = coordonnees(sommets);
+        const double rx = sommets[0].x, ry = sommets[0].y;
+        const NoyauAire noyau = noyaux().aire;
+        Somme total;
+        for (const Voies& v : parPaquets<Voies>(n - 1, pool, [&](std::size_t debut, std::size_t m, Voies& v) {
+                 noyau(p + 2 * debut, m, rx, ry, v);
+             })) {
+            total.ajouter(v);
+        }
+        // L'arête de fermeture aboutit au premier sommet, origine du repère : son déterminant est nul.
+        return total.valeur() / 2;
+    }
+
+    double perimetre(const Vecteur2D* sommets, std::size_t n, PoolThreads* pool) {
+        if (n < 2) return 0;
+        if (n < SEUIL_NOYAU) {
+            double perimetre = 0;
+            for (std::size_t i = 0; i + 1 < n; ++i) {
+                perimetre += std::hypot(sommets[i + 1].x - sommets[i].x, sommets[i + 1].y - sommets[i].y);
+            }
+            return perimetre + std::hypot(sommets[0].x - sommets[n - 1].x, sommets[0].y - sommets[n - 1].y);
+        }
+        const double* p = coordonnees(sommets);
+        const NoyauPerimetre noyau = noyaux().perimetre;
+        Somme total;
+        for (const Voies& v : parPaquets<Voies>(n - 1, pool, [&](std::size_t debut, std::size_t m, Voies& v) {
+                 noyau(p + 2 * debut, m, v);
+             })) {
+            total.ajouter(v);
+        }
+        const double dx = sommets[0].x - sommets[n - 1].x, dy = sommets[0].y - sommets[n - 1].y;
+        total.ajouter(std::sqrt(dx * dx + dy * dy));
+        return total.valeur();
+    }
+
+    Vecteur2D centroide(const Vecteur2D* sommets, std::size_t n, PoolThreads* pool) {
+        if (n == 0) return Vecteur2D();
+        const double* p = coordonnees(sommets);
+        const double rx = sommets[0].x, ry = sommets[0].y;
+        const NoyauCentroide noyau = noyaux().centroide;
+        Somme d, sx, sy;
+        for (const VoiesCentroide& v : parPaquets<VoiesCentroide>(n - 1, pool, [&](std::size_t debut, std::size_t m, VoiesCentroide& v) {
+                 noyau(p + 2 * debut, m, rx, ry, v);
+             })) {
+            d.ajouter(v.d);
+            sx.ajouter(v.sx);
+            sy.ajouter(v.sy);
+        }
+        // L'arête de fermeture aboutit au premier sommet, origine du repère : son moment est nul.
+        const double deuxAires = d.valeur();
+        if (n < 3 || deuxAires == 0) {
+            Boite2D b;
+            for (std::size_t i = 0; i < n; ++i) b.etendre(sommets[i]);
+            return b.centre();
+        }
+        return Vecteur2D(rx + sx.valeur() / (3 * deuxAires), ry + sy.valeur() / (3 * deuxAires));
+    }
+
+    const char* jeuInstructions() { return noyaux().nom; }
+}
@@ -0,0 +1,138 @@
+/**
+ * @file PoolConnexions.cpp
+ * @brief Répartition des requêtes des threads producteurs sur les connexions du pool.
+ */
+
+#include "../header/PoolConnexions.h"
+#include <stdexcept>
+#include <unordered_map>
+
+namespace {
+    /** @brief Numéro du prochain pool créé (jamais réutilisé, contrairement aux adresses). */
+    std::atomic<std::uint64_t> prochainNumero{ 1 };
+
+    /** @brief Dernier tampon utilisé par le thread : le cas courant d'un seul pool ne cherche rien. */
+    struct CacheProducteur {
+        std::uint64_t numero = 0;
+        void* producteur = nullptr;
+        std::unordered_map<std::uint64_t, void*> autres; ///< Tampons du thread dans d'autres pools.
+    };
+
+    thread_local CacheProducteur cache;
+}
+
+PoolConnexions::PoolConnexions(const std::string& hote, std::uint16_t port, const Options& options)
+    : _options(options), _numero(prochainNumero.fetch_add(1, std::memory_order_relaxed)) {
+    if (options.nbConnexions == 0) throw std::invalid_argument("Un pool de connexions en compte au moins une");
+    _connexions.reserve(options.nbConnexions);
+    for (std::size_t i = 0; i < options.nbConnexions; ++i) {
+        _connexions.push_back(std::make_unique<ConnexionTCP>(hote, port, options.connexion));
+    }
+}
+
+PoolConnexions::~PoolConnexions() {
+    for (auto& p : _producteurs) {
+        for (std::size_t i = 0; i < _connexions.size(); ++i) deposer(*p, i);
+    }
+    // Les connexions transmettent ce qui reste en se détruisant.
+}
+
+PoolConnexions::Producteur& PoolConnexions::producteur() {
+    if (cache.numero == _numero) return *static_cast<Producteur*>(cache.producteur);
+    if (cache.numero != 0) cache.autres[cache.numero] = cache.producteur;
+
+    Producteur* p;
+    auto it = cache.autres.find(_numero);
+    if (it != cache.autres.end()) {
+        p = static_cast<Producteur*>(it->second);
+    }
+    else {
+        auto nouveau = std::make_unique<Producteur>();
+        nouveau->paquets.resize(_connexions.size());
+        nouveau->nbRequetes.assign(_connexions.size(), 0);
+        nouveau->trames.assign(_connexions.size(), 0);
+        nouveau->utilisees.assign(_connexions.size(), 0);
+        std::lock_guard<std::mutex> verrou(_verrouProducteurs);
+        nouveau->attitree = _prochaineAttitree++ % _connexions.size();
+        p = nouveau.get();
+        _producteurs.push_back(std::move(nouveau));
+    }
+    cache.numero = _numero;
+    cache.producteur = p;
+    return *p;
+}
+
+void PoolConnexions::preparer(Producteur& p, std::size_t indice, const std::string& requete) {
+    std::string& paquet = p.paquets[indice];
+    if (paquet.capacity() < _options.taillePaquet) paquet.reserve(_options.taillePaquet + 256);
+    // Le mode est fixé pour tout le paquet : le thread d'envoi peut revenir au texte entre-temps.
+    if (p.nbRequetes[indice] == 0) p.trames[indice] = _connexions[indice]->enTrames();
+    ConnexionTCP::ajouterRequete(paquet, requete, p.trames[indice]);
+    ++p.nbRequetes[indice];
+    p.utilisees[indice] = 1;
+    if (paquet.size() >= _options.taillePaquet) deposer(p, indice);
+}
+
+void PoolConnexions::deposer(Producteur& p, std::size_t indice) {
+    if (p.nbRequetes[indice] == 0) return;
+    _connexions[indice]->envoyerPaquet(std::move(p.paquets[indice]), p.nbRequetes[indice], p.trames[indice]);
+    p.paquets[indice] = std::string();
+    p.nbRequetes[indice] = 0;
+}
+
+void PoolConnexions::envoyer(const std::string& requete) {
+    PPIL_CHRONO("PoolConnexions::envoyer");
+    Producteur& p = producteur();
+    preparer(p, p.attitree, requete);
+}
+
+void PoolConnexions::envoyer(std::uint64_t flux, const std::string& requete) {
+    PPIL_CHRONO("PoolConnexions::envoyer (flux)");
+    preparer(producteur(), static_cast<std::size_t>(flux % _connexions.size()), requete);
+}
+
+void PoolConnexions::vider() {
+    Producteur& p = producteur();
+    for (std::size_t i = 0; i < _connexions.size(); ++i) deposer(p, i);
+    for (std::size_t i = 0; i < _connexions.size(); ++i) {
+        if (!p.utilisees[i]) continue;
+        _connexions[i]->vider();
+        p.utilisees[i] = 0;
+    }
+}
+
+bool PoolConnexions::negocier(const std::string& offre) {
+    // Tout ou rien : un refus ramène au texte les connexions qui avaient déjà accepté.
+    for (std::size_t i = 0; i < _connexions.size(); ++i) {
+        if (_connexions[i]->negocier(offre)) continue;
+        for (std::size_t j = 0; j < i; ++j) _connexions[j]->revenirAuTexte();
+        return false;
+    }
+    return true;
+}
+
+bool PoolConnexions::enTrames() const {
+    for (const auto& c : _connexions) {
+        if (!c->enTrames()) return false;
+    }
+    return true;
+}
+
+std::uint64_t PoolConnexions::generation() const {
+    std::uint64_t total = 0;
+    for (const auto& c : _connexions) total += c->generation();
+    return total;
+}
+
+ConnexionTCP::Statistiques PoolConnexions::statistiques() const {
+    ConnexionTCP::Statistiques total;
+    for (const auto& c : _connexions) {
+        const ConnexionTCP::Statistiques s = c->statistiques();
+        total.requetes += s.requetes;
+        total.octets += s.octets;
+        total.lots += s.lots;
+        total.reconnexions += s.reconnexions;
+        total.perdues += s.perdues;
+    }
+    return total;
+}
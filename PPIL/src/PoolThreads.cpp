@@ -0,0 +1,128 @@
+/**
+ * @file PoolThreads.cpp
+ * @brief Implémentation de la réserve de threads à vol de tâches.
+ */
+
+#include "../header/PoolThreads.h"
+
+namespace {
+    /** @brief Réserve à laquelle appartient le thread courant, et son indice de file. */
+    thread_local const PoolThreads* poolDuThread = nullptr;
+    thread_local std::size_t indiceDuThread = 0;
+}
+
+PoolThreads::PoolThreads(std::size_t nbThreads) : _enAttente(0), _arret(false) {
+    if (nbThreads == 0) nbThreads = std::thread::hardware_concurrency();
+    if (nbThreads == 0) nbThreads = 1;
+    for (std::size_t i = 0; i < nbThreads; ++i) _files.push_back(std::make_unique<File>());
+    for (std::size_t i = 1; i < nbThreads; ++i) {
+        _threads.emplace_back(&PoolThreads::boucle, this, i);
+    }
+}
+
+PoolThreads::~PoolThreads() {
+    {
+        std::lock_guard<std::mutex> verrou(_mutexSommeil);
+        _arret = true;
+    }
+    _travailDisponible.notify_all();
+    for (std::thread& t : _threads) t.join();
+}
+
+std::size_t PoolThreads::indiceCourant() const {
+    return poolDuThread == this ? indiceDuThread : 0;
+}
+
+void PoolThreads::deposer(std::size_t indice, const Plage& p) {
+    {
+        std::lock_guard<std::mutex> verrou(_files[indice]->mutex);
+        _files[indice]->plages.push_back(p);
+    }
+    _enAttente.fetch_add(1, std::memory_order_release);
+    // Prendre le verrou avant de notifier évite de perdre le réveil d'un thread en train de s'endormir.
+    { std::lock_guard<std::mutex> verrou(_mutexSommeil); }
+    _travailDisponible.notify_one();
+}
+
+bool PoolThreads::prendre(std::size_t indice, Plage& p) {
+    if (_enAttente.load(std::memory_order_acquire) == 0) return false;
+    {
+        File& propre = *_files[indice];
+        std::lock_guard<std::mutex> verrou(propre.mutex);
+        if (!propre.plages.empty()) {
+            p = propre.plages.back();
+            propre.plages.pop_back();
+            _enAttente.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    for (std::size_t k = 1; k < _files.size(); ++k) {
+        File& victime = *_files[(indice + k) % _files.size()];
+        std::lock_guard<std::mutex> verrou(victime.mutex);
+        if (!victime.plages.empty()) {
+            p = victime.plages.front();
+            victime.plages.pop_front();
+            _enAttente.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+void PoolThreads::traiter(std::size_t indice, Plage p) {
+    Lot& lot = *p.lot;
+    while (p.fin - p.debut > lot.granularite) {
+        std::size_t milieu = p.debut + (p.fin - p.debut) / 2;
+        deposer(indice, Plage{ p.lot, milieu, p.fin });
+        p.fin = milieu;
+    }
+    for (std::size_t i = p.debut; i < p.fin; ++i) {
+        try {
+            (*lot.tache)(i);
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> verrou(lot.mutexErreur);
+            if (!lot.erreur) lot.erreur = std::current_exception();
+        }
+    }
+    // Dernier accès au lot : son propriétaire peut le détruire dès que restants atteint 0.
+    lot.restants.fetch_sub(p.fin - p.debut, std::memory_order_acq_rel);
+}
+
+void PoolThreads::boucle(std::size_t indice) {
+    poolDuThread = this;
+    indiceDuThread = indice;
+    for (;;) {
+        Plage p;
+        if (prendre(indice, p)) {
+            traiter(indice, p);
+            continue;
+        }
+        std::unique_lock<std::mutex> verrou(_mutexSommeil);
+        _travailDisponible.wait(verrou, [&] {
+            return _arret || _enAttente.load(std::memory_order_acquire) > 0;
+        });
+        if (_arret) return;
+    }
+}
+
+void PoolThreads::executer(std::size_t nbTaches, const std::function<void(std::size_t)>& tache,
+                           std::size_t granularite) {
+    if (nbTaches == 0) return;
+    Lot lot;
+    lot.tache = &tache;
+    lot.granularite = granularite ? granularite : 1;
+    lot.restants.store(nbTaches, std::memory_order_relaxed);
+
+    const std::size_t indice = indiceCourant();
+    traiter(indice, Plage{ &lot, 0, nbTaches });
+
+    // Attente active : le thread exécute les tâches disponibles (de ce lot ou d'un autre)
+    // plutôt que de rester bloqué pendant que d'autres finissent les plages volées.
+    while (lot.restants.load(std::memory_order_acquire) != 0) {
+        Plage p;
+        if (prendre(indice, p)) traiter(indice, p);
+        else std::this_thread::yield();
+    }
+    if (lot.erreur) std::rethrow_exception(lot.erreur);
+}
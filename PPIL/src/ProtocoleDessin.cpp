@@ -0,0 +1,167 @@
+/**
+ * @file ProtocoleDessin.cpp
+ * @brief Encodage et décodage des trames du protocole binaire de dessin.
+ */
+
+#include "../header/ProtocoleDessin.h"
+#include "../header/FormatBinaire.h"
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+
+namespace {
+    void ecrireVarint(std::string& s, std::uint64_t v) {
+        char octets[FormatBinaire::TAILLE_MAX_VARINT];
+        s.append(octets, FormatBinaire::encoderVarint(octets, v));
+    }
+
+    using FormatBinaire::zigzag;
+    using FormatBinaire::dezigzag;
+
+    /** @brief Lecture bornée d'une trame. */
+    class Lecteur {
+    private:
+        const char* _p;
+        const char* _fin;
+
+    public:
+        Lecteur(const char* p, std::size_t n) : _p(p), _fin(p + n) {}
+
+        bool fini() const { return _p == _fin; }
+
+        std::uint8_t octet() {
+            if (_p == _fin) throw std::runtime_error("Trame de dessin tronquée");
+            return static_cast<std::uint8_t>(*_p++);
+        }
+
+        std::uint64_t varint() {
+            std::uint64_t v = 0;
+            for (int decalage = 0; decalage < 64; decalage += 7) {
+                const std::uint8_t o = octet();
+                v |= static_cast<std::uint64_t>(o & 0x7F) << decalage;
+                if (!(o & 0x80)) return v;
+            }
+            throw std::runtime_error("Entier trop long dans la trame de dessin");
+        }
+
+        std::string octets(std::size_t n) {
+            if (static_cast<std::size_t>(_fin - _p) < n) throw std::runtime_error("Trame de dessin tronquée");
+            std::string s(_p, n);
+            _p += n;
+            return s;
+        }
+    };
+}
+
+namespace ProtocoleDessin {
+
+    std::string offre(double pas) {
+        char tampon[64];
+        std::snprintf(tampon, sizeof(tampon), "Protocole;binaire;%u;%.17g", static_cast<unsigned>(VERSION), pas);
+        return tampon;
+    }
+
+    Encodeur::Encodeur(double pas) : _inversePas(1.0 / pas) {
+        if (!(pas > 0)) throw std::invalid_argument("Le pas de quantification doit être strictement positif");
+    }
+
+    void Encodeur::ecrireEntete(Code code, const std::string& couleur) {
+        _trame.push_back(static_cast<char>(code));
+        const std::uint8_t indice = FormatBinaire::indicePalette(couleur);
+        _trame.push_back(static_cast<char>(indice));
+        if (indice == FormatBinaire::COULEUR_LIBRE) {
+            ecrireVarint(_trame, couleur.size());
+            _trame += couleur;
+        }
+    }
+
+    void Encodeur::ecrirePoint(const Vecteur2D& p) {
+        const std::int64_t x = std::llround(p.x * _inversePas);
+        const std::int64_t y = std::llround(p.y * _inversePas);
+        ecrireVarint(_trame, zigzag(x - _x));
+        ecrireVarint(_trame, zigzag(y - _y));
+        _x = x;
+        _y = y;
+    }
+
+    void Encodeur::cercle(const Vecteur2D& centre, double rayon, const std::string& couleur) {
+        ecrireEntete(CERCLE, couleur);
+        ecrirePoint(centre);
+        ecrireVarint(_trame, static_cast<std::uint64_t>(std::llround(rayon * _inversePas)));
+    }
+
+    void Encodeur::segment(const Vecteur2D& p1, const Vecteur2D& p2, const std::string& couleur) {
+        ecrireEntete(SEGMENT, couleur);
+        ecrirePoint(p1);
+        ecrirePoint(p2);
+    }
+
+    void Encodeur::polygone(const Vecteur2D* sommets, std::size_t nbSommets, const std::string& couleur) {
+        ecrireEntete(POLYGONE, couleur);
+        ecrireVarint(_trame, nbSommets);
+        for (std::size_t i = 0; i < nbSommets; ++i) ecrirePoint(sommets[i]);
+    }
+
+    void Encodeur::point(const Vecteur2D& p, const std::string& couleur) {
+        ecrireEntete(POINT, couleur);
+        ecrirePoint(p);
+    }
+
+    void Encodeur::operation(Code code, std::uint64_t identifiant) {
+        _trame.push_back(static_cast<char>(code));
+        ecrireVarint(_trame, identifiant);
+    }
+
+    std::vector<Commande> decoder(const char* donnees, std::size_t taille, double pas) {
+        std::vector<Commande> commandes;
+        Lecteur l(donnees, taille);
+        std::int64_t x = 0, y = 0;
+        auto point = [&]() {
+            x += dezigzag(l.varint());
+            y += dezigzag(l.varint());
+            return Vecteur2D(x * pas, y * pas);
+        };
+        while (!l.fini()) {
+            Commande c;
+            c.code = static_cast<Code>(l.octet());
+            if (c.code == AJOUT || c.code == MISE_A_JOUR || c.code == SUPPRESSION) {
+                c.operation = c.code;
+                c.identifiant = l.varint();
+                if (c.operation == SUPPRESSION) {
+                    commandes.push_back(std::move(c));
+                    continue;
+                }
+                c.code = static_cast<Code>(l.octet());
+            }
+            const std::uint8_t indice = l.octet();
+            if (indice == FormatBinaire::COULEUR_LIBRE) c.couleur = l.octets(l.varint());
+            else if (indice < FormatBinaire::TAILLE_PALETTE) c.couleur = FormatBinaire::couleurPalette(indice);
+            else throw std::runtime_error("Indice de couleur inconnu dans la trame de dessin");
+
+            switch (c.code) {
+            case CERCLE:
+                c.points.push_back(point());
+                c.rayon = static_cast<double>(l.varint()) * pas;
+                break;
+            case POINT:
+                c.points.push_back(point());
+                break;
+            case SEGMENT:
+                c.points.push_back(point());
+                c.points.push_back(point());
+                break;
+            case POLYGONE: {
+                const std::uint64_t n = l.varint();
+                if (n > taille) throw std::runtime_error("Trame de dessin tronquée");
+                c.points.reserve(static_cast<std::size_t>(n));
+                for (std::uint64_t i = 0; i < n; ++i) c.points.push_back(point());
+                break;
+            }
+            default:
+                throw std::runtime_error("Code de commande inconnu dans la trame de dessin");
+            }
+            commandes.push_back(std::move(c));
+        }
+        return commandes;
+    }
+}
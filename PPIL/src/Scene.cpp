@@ -0,0 +1,21 @@
+/**
+ * @file Scene.cpp
+ * @brief Cycle de vie d'une scène allouée en arène.
+ */
+
+#include "../header/Scene.h"
+
+Scene::Scene(const std::string& couleur) : _racine(nullptr), _couleur(couleur) {
+    _racine = creer<Groupe>(_couleur);
+}
+
+Scene::~Scene() {
+    _arene.detruire(_racine); // Destructeurs des formes ; leur mémoire reste dans l'arène.
+}
+
+void Scene::vider() {
+    _arene.detruire(_racine);
+    _racine = nullptr;
+    _arene.liberer();
+    _racine = creer<Groupe>(_couleur);
+}
@@ -0,0 +1,118 @@
+/**
+ * @file SceneValeur.cpp
+ * @brief Conversions entre FormeValeur et la hiérarchie Forme, sauvegardes texte et binaire.
+ */
+
+#include "../header/SceneValeur.h"
+#include "../header/VisiteurForme.h"
+#include "../header/Cercle.h"
+#include "../header/Segement.h"
+#include "../header/Polygone.h"
+#include "../header/Group.h"
+#include "../header/EncodeurSauvegarde.h"
+#include "../header/TamponFichier.h"
+#include <memory>
+
+namespace {
+    /** @brief Copie la forme visitée dans une FormeValeur ; une instance devient le groupe équivalent. */
+    class VisiteurCopie : public VisiteurForme {
+    public:
+        FormeValeur resultat;
+
+        void visite(const Cercle& cercle) override {
+            resultat = CercleValeur{ placer(cercle.getCentre()), placer(cercle.getRayon()), cercle.getCouleur() };
+        }
+
+        void visite(const Segment& segment) override {
+            resultat = SegmentValeur{ placer(segment.getP1()), placer(segment.getP2()), segment.getCouleur() };
+        }
+
+        void visite(const Polygone& polygone) override {
+            const auto& sommets = polygone.getSommets();
+            std::vector<Vecteur2D> places(sommets.begin(), sommets.end());
+            if (dansInstance()) {
+                for (Vecteur2D& s : places) s = placer(s);
+            }
+            resultat = PolygoneValeur{ std::move(places), polygone.getCouleur() };
+        }
+
+        void visite(const Groupe& groupe) override {
+            GroupeValeur g{ couleurGroupe(groupe), {} };
+            g.formes.reserve(groupe.getFormes().size());
+            for (const Forme* f : groupe.getFormes()) {
+                f->accepte(this);
+                g.formes.push_back(std::move(resultat));
+            }
+            resultat = std::move(g);
+        }
+    };
+
+    /** @brief Construit la Forme correspondante. */
+    struct VisiteurConstruction {
+        Forme* operator()(const CercleValeur& c) const { return new Cercle(c.centre, c.rayon, c.couleur); }
+        Forme* operator()(const SegmentValeur& s) const { return new Segment(s.p1, s.p2, s.couleur); }
+        Forme* operator()(const PolygoneValeur& p) const { return new Polygone(p.sommets, p.couleur); }
+        Forme* operator()(const GroupeValeur& g) const {
+            auto groupe = std::make_unique<Groupe>(g.couleur);
+            for (const FormeValeur& f : g.formes) groupe->ajouter(visiter(*this, f));
+            return groupe.release();
+        }
+    };
+
+    /** @brief Même format que VisiteurSauvegardeTexte : le même encodeur écrit les lignes. */
+    struct SauvegardeTexte {
+        EncodeurTexte& encodeur;
+
+        void operator()(const CercleValeur& c) { encodeur.cercle(c.couleur, c.centre, c.rayon); }
+        void operator()(const SegmentValeur& s) { encodeur.segment(s.couleur, s.p1, s.p2); }
+        void operator()(const PolygoneValeur& p) { encodeur.polygone(p.couleur, p.sommets.data(), p.sommets.size()); }
+
+        void operator()(const GroupeValeur& g) {
+            encodeur.debutGroupe(g.couleur);
+            for (const FormeValeur& f : g.formes) visiter(*this, f);
+            encodeur.finGroupe();
+        }
+    };
+
+    /** @brief Même format que VisiteurSauvegardeBinaire (voir FormatBinaire.h), par le même encodeur. */
+    struct SauvegardeBinaire {
+        EncodeurBinaire& encodeur;
+
+        void operator()(const CercleValeur& c) { encodeur.cercle(c.couleur, c.centre, c.rayon); }
+        void operator()(const SegmentValeur& s) { encodeur.segment(s.couleur, s.p1, s.p2); }
+        void operator()(const PolygoneValeur& p) { encodeur.polygone(p.couleur, p.sommets.data(), p.sommets.size()); }
+
+        void operator()(const GroupeValeur& g) {
+            const std::uint64_t debut = encodeur.debutGroupe(g.couleur);
+            for (const FormeValeur& f : g.formes) visiter(*this, f);
+            encodeur.finGroupe(debut);
+        }
+    };
+}
+
+namespace SceneValeur {
+
+    FormeValeur versValeur(const Forme& f) {
+        VisiteurCopie v;
+        f.accepte(&v);
+        return std::move(v.resultat);
+    }
+
+    Forme* versForme(const FormeValeur& f) {
+        return visiter(VisiteurConstruction{}, f);
+    }
+
+    void sauvegarderTexte(const FormeValeur& f, const std::string& nomFichier) {
+        TamponFichier sortie(nomFichier);
+        EncodeurTexte encodeur(sortie);
+        visiter(SauvegardeTexte{ encodeur }, f);
+        sortie.valider();
+    }
+
+    void sauvegarderBinaire(const FormeValeur& f, const std::string& nomFichier, double pasQuantification) {
+        TamponFichier sortie(nomFichier, TamponFichier::SEUIL_DEFAUT, true);
+        EncodeurBinaire encodeur(sortie, pasQuantification);
+        visiter(SauvegardeBinaire{ encodeur }, f);
+        sortie.valider();
+    }
+}
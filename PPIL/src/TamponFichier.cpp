@@ -0,0 +1,73 @@
+/**
+ * @file TamponFichier.cpp
+ * @brief Implémentation du flux de sortie tamponné à validation atomique.
+ */
+
+#include "../header/TamponFichier.h"
+#include <stdexcept>
+#include <algorithm>
+#include <filesystem>
+#include <system_error>
+
+TamponFichier::TamponFichier(const std::string& nomFichier, std::size_t seuilVidage, bool binaire)
+    : _nomFichier(nomFichier), _nomTemporaire(nomFichier + ".tmp"),
+      _seuilVidage(seuilVidage ? seuilVidage : 1), _octetsVides(0), _valide(false) {
+    std::ios::openmode mode = std::ios::out | std::ios::trunc;
+    if (binaire) mode |= std::ios::binary;
+    _flux.open(_nomTemporaire, mode);
+    if (!_flux) {
+        throw std::runtime_error("Impossible de créer le fichier temporaire : " + _nomTemporaire);
+    }
+    _tampon.reserve(_seuilVidage);
+}
+
+TamponFichier::~TamponFichier() {
+    if (!_valide) {
+        // Session abandonnée : la destination n'est jamais touchée.
+        _flux.close();
+        std::error_code ec;
+        std::filesystem::remove(_nomTemporaire, ec);
+    }
+}
+
+void TamponFichier::vider() {
+    if (_tampon.empty()) return;
+    _flux.write(_tampon.data(), static_cast<std::streamsize>(_tampon.size()));
+    _octetsVides += _tampon.size();
+    _tampon.clear();
+}
+
+void TamponFichier::reecrire(std::uint64_t position, const char* donnees, std::size_t taille) {
+    if (position + taille > this->position()) {
+        throw std::out_of_range("Réécriture au-delà de la position courante");
+    }
+    std::size_t i = 0;
+    // Partie déjà sur disque : repositionnement temporaire du flux.
+    if (position < _octetsVides) {
+        std::size_t surDisque = static_cast<std::size_t>(
+            std::min<std::uint64_t>(taille, _octetsVides - position));
+        _flux.seekp(static_cast<std::streamoff>(position));
+        _flux.write(donnees, static_cast<std::streamsize>(surDisque));
+        _flux.seekp(0, std::ios::end);
+        i = surDisque;
+    }
+    // Partie encore dans le tampon.
+    for (; i < taille; ++i) {
+        _tampon[static_cast<std::size_t>(position + i - _octetsVides)] = donnees[i];
+    }
+}
+
+void TamponFichier::valider() {
+    if (_valide) return;
+    vider();
+    _flux.close();
+    if (_flux.fail()) {
+        throw std::runtime_error("Échec d'écriture du fichier temporaire : " + _nomTemporaire);
+    }
+    std::error_code ec;
+    std::filesystem::rename(_nomTemporaire, _nomFichier, ec);
+    if (ec) {
+        throw std::runtime_error("Impossible de renommer " + _nomTemporaire + " : " + ec.message());
+    }
+    _valide = true;
+}
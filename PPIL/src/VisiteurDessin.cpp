@@ -0,0 +1,399 @@
+/**
+ * @file VisiteurDessin.cpp
+ * @brief Construction des commandes de dessin (texte ou binaire) et envoi au serveur.
+ */
+
+#include "../header/VisiteurDessin.h"
+#include "../header/Connexion_m.h"
+#include "../header/Cercle.h"
+#include "../header/Segement.h"
+#include "../header/Polygone.h"
+#include "../header/Group.h"
+#include "../header/Instance.h"
+#include "../header/Geometrie.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace {
+    /** @brief Bornes de l'exposant de la tolérance, pour le ranger dans la clé du cache. */
+    const int NIVEAU_MIN = -60, NIVEAU_MAX = 60;
+
+    /** @brief Clé du cache des simplifications : identifiant du polygone et niveau de zoom. */
+    std::uint64_t cleSimplification(std::uint64_t identifiant, int niveau) {
+        return (identifiant << 7) | static_cast<std::uint64_t>(niveau - NIVEAU_MIN);
+    }
+}
+
+VisiteurDessin::VisiteurDessin(ConnexionManager* connexion)
+    : _connexion(connexion ? connexion : ConnexionManager::getInstance()) {
+}
+
+bool VisiteurDessin::activerBinaire(double pas) {
+    auto encodeur = std::make_unique<ProtocoleDessin::Encodeur>(pas);
+    if (!_connexion->negocier(ProtocoleDessin::offre(pas))) return false;
+    _binaire = std::move(encodeur);
+    return true;
+}
+
+void VisiteurDessin::activerDifferentiel() {
+    _differentiel = true;
+    _envois.clear();
+    _racines.clear();
+    _racinesImage.clear();
+    _generation = _connexion->generation();
+}
+
+/**
+ * @details La tolérance est arrondie à la puissance de deux inférieure : les vues de zooms
+ * voisins partagent le même niveau, donc les mêmes polygones simplifiés.
+ */
+void VisiteurDessin::definirVue(const Boite2D& vue, double unitesParPixel, double tolerancePixels) {
+    const double tolerance = unitesParPixel * tolerancePixels;
+    int niveau = NIVEAU_MIN;
+    if (tolerance > 0) niveau = std::clamp(std::ilogb(tolerance), NIVEAU_MIN, NIVEAU_MAX);
+    const double arrondie = tolerance > 0 ? std::ldexp(1.0, niveau) : 0;
+    if (_cadrage && _niveau == niveau && _tolerance == arrondie && _vue.xmin == vue.xmin &&
+        _vue.ymin == vue.ymin && _vue.xmax == vue.xmax && _vue.ymax == vue.ymax) {
+        return;
+    }
+    if (!_cadrage || _niveau != niveau || _tolerance != arrondie) ++_numeroEchelle;
+    _cadrage = true;
+    _vue = vue;
+    _tolerance = arrondie;
+    _niveau = niveau;
+    ++_numeroVue;
+}
+
+void VisiteurDessin::supprimerVue() {
+    if (!_cadrage) return;
+    _cadrage = false;
+    ++_numeroVue;
+    ++_numeroEchelle;
+}
+
+/**
+ * @details La date effective d'une forme simple est la plus récente entre la sienne et celle de
+ * ses groupes ancêtres (dont les transformations et la couleur la concernent aussi).
+ */
+bool VisiteurDessin::preparer(const Forme& f, std::uint64_t version) {
+    _requete.clear();
+    if (!_differentiel) return true;
+    std::uint64_t id;
+    bool nouveau = true;
+    if (dansInstance()) {
+        // Pièce d'un prototype partagé : son identifiant est celui de toutes ses instances.
+        id = PIECE_INSTANCE | _prochainePiece++;
+        _piecesInstance->push_back(id);
+        _envois.emplace(id, Envoi{ version, _numeroEchelle, false, {} });
+    }
+    else {
+        id = f.getIdentifiant();
+        auto it = _envois.find(id);
+        if (it != _envois.end() && it->second.groupe) {
+            supprimer(id); // Groupe détaillé jusqu'ici, désormais réduit à un point.
+            it = _envois.end();
+        }
+        nouveau = it == _envois.end();
+        if (nouveau) {
+            _envois.emplace(id, Envoi{ version, _numeroEchelle, false, {} });
+        }
+        else {
+            if (it->second.version == version && it->second.vue == _numeroEchelle) return false;
+            it->second.version = version;
+            it->second.vue = _numeroEchelle;
+        }
+    }
+    const ProtocoleDessin::Code operation = nouveau ? ProtocoleDessin::AJOUT : ProtocoleDessin::MISE_A_JOUR;
+    if (_binaire) {
+        _binaire->operation(operation, id);
+    }
+    else {
+        _requete = nouveau ? "Ajout;" : "MiseAJour;";
+        _requete += std::to_string(id);
+        _requete += ';';
+    }
+    return true;
+}
+
+void VisiteurDessin::supprimer(std::uint64_t identifiant) {
+    auto it = _envois.find(identifiant);
+    if (it == _envois.end()) return;
+    Envoi envoi = std::move(it->second);
+    _envois.erase(it);
+    if (envoi.groupe) {
+        for (std::uint64_t enfant : envoi.enfants) supprimer(enfant);
+        return;
+    }
+    if (_binaire) {
+        _binaire->operation(ProtocoleDessin::SUPPRESSION, identifiant);
+        envoyerTrameSiPleine();
+    }
+    else {
+        _connexion->envoyer("Suppression;" + std::to_string(identifiant));
+    }
+}
+
+bool VisiteurDessin::cadrer(const Forme& f, const Boite2D& boite, std::uint64_t version,
+                            const std::string& couleurForme) {
+    if (!boite.intersecte(_vue)) {
+        if (_differentiel && !dansInstance()) supprimer(f.getIdentifiant());
+        return true;
+    }
+    if (std::max(boite.largeur(), boite.hauteur()) > _tolerance) return false;
+
+    // Plus petit que la tolérance : un point suffit.
+    if (!preparer(f, version)) return true;
+    if (_binaire) {
+        _binaire->point(boite.centre(), couleur(couleurForme));
+        envoyerTrameSiPleine();
+        return true;
+    }
+    _requete += "Point;";
+    _requete += couleur(couleurForme);
+    _requete += ';';
+    ecrirePoint(boite.centre());
+    _connexion->envoyer(_requete);
+    return true;
+}
+
+/**
+ * @details Les polygones d'un prototype ne sont pas mémorisés : partagés par des instances
+ * placées différemment, leur identifiant ne désigne pas un seul dessin.
+ */
+const std::vector<Vecteur2D>* VisiteurDessin::simplifier(const Polygone& polygone, std::uint64_t version) {
+    const Polygone::Sommets& sommets = polygone.getSommets();
+    if (sommets.size() < SOMMETS_SIMPLIFICATION_MEMORISEE || dansInstance()) {
+        Geometrie::simplifier(placer(polygone, _places), sommets.size(), _tolerance, _simplifie);
+        return &_simplifie;
+    }
+    Simplification& s = _simplifications[cleSimplification(polygone.getIdentifiant(), _niveau)];
+    if (s.version != version || s.sommets.empty()) {
+        Geometrie::simplifier(sommets.data(), sommets.size(), _tolerance, s.sommets);
+        s.version = version;
+    }
+    return &s.sommets;
+}
+
+void VisiteurDessin::ecrireReel(double valeur) {
+    char tampon[32];
+    int n = std::snprintf(tampon, sizeof(tampon), "%g", valeur);
+    _requete.append(tampon, static_cast<std::size_t>(n));
+}
+
+void VisiteurDessin::ecrirePoint(const Vecteur2D& p) {
+    ecrireReel(p.x);
+    _requete += ',';
+    ecrireReel(p.y);
+}
+
+void VisiteurDessin::envoyerTrameSiPleine() {
+    if (_binaire->trame().size() < TAILLE_TRAME) return;
+    _connexion->envoyer(_binaire->trame());
+    _binaire->nouvelleTrame();
+}
+
+void VisiteurDessin::terminer() {
+    if (_differentiel) {
+        std::sort(_racinesImage.begin(), _racinesImage.end());
+        for (std::uint64_t id : _racines) {
+            if (!std::binary_search(_racinesImage.begin(), _racinesImage.end(), id)) supprimer(id);
+        }
+        _racines.swap(_racinesImage);
+        _racinesImage.clear();
+    }
+    if (_binaire && !_binaire->trame().empty()) {
+        _connexion->envoyer(_binaire->trame());
+        _binaire->nouvelleTrame();
+    }
+    _connexion->vider();
+    // Serveur retrouvé après une coupure mais hostile au binaire : l'image suivante repart en texte.
+    const bool texte = _binaire && !_connexion->enTrames();
+    if (texte) _binaire.reset();
+    const std::uint64_t generation = _connexion->generation();
+    if (texte || generation != _generation) {
+        // Nouveau pair, qui n'a rien de ce qui précède : l'image suivante est envoyée en entier.
+        _generation = generation;
+        _envois.clear();
+        _racines.clear();
+    }
+}
+
+/**
+ * @details Format texte : Cercle;couleur;cx,cy;rayon.
+ */
+void VisiteurDessin::visite(const Cercle& cercle) {
+    const std::uint64_t version = std::max(cercle.getVersion(), _versionAncetres);
+    if (_differentiel && _profondeur == 0) _racinesImage.push_back(cercle.getIdentifiant());
+    const Vecteur2D centre = placer(cercle.getCentre());
+    const double rayon = placer(cercle.getRayon());
+    if (_cadrage && cadrer(cercle, Boite2D(centre.x - rayon, centre.y - rayon, centre.x + rayon, centre.y + rayon),
+                           version, cercle.getCouleur())) {
+        return;
+    }
+    if (!preparer(cercle, version)) return;
+    if (_binaire) {
+        _binaire->cercle(centre, rayon, couleur(cercle.getCouleur()));
+        envoyerTrameSiPleine();
+        return;
+    }
+    _requete += "Cercle;";
+    _requete += couleur(cercle.getCouleur());
+    _requete += ';';
+    ecrirePoint(centre);
+    _requete += ';';
+    ecrireReel(rayon);
+    _connexion->envoyer(_requete);
+}
+
+/**
+ * @details Format texte : Segment;couleur;x1,y1;x2,y2.
+ */
+void VisiteurDessin::visite(const Segment& segment) {
+    const std::uint64_t version = std::max(segment.getVersion(), _versionAncetres);
+    if (_differentiel && _profondeur == 0) _racinesImage.push_back(segment.getIdentifiant());
+    const Vecteur2D p1 = placer(segment.getP1()), p2 = placer(segment.getP2());
+    if (_cadrage && cadrer(segment, Boite2D::entre(p1, p2), version, segment.getCouleur())) return;
+    if (!preparer(segment, version)) return;
+    if (_binaire) {
+        _binaire->segment(p1, p2, couleur(segment.getCouleur()));
+        envoyerTrameSiPleine();
+        return;
+    }
+    _requete += "Segment;";
+    _requete += couleur(segment.getCouleur());
+    _requete += ';';
+    ecrirePoint(p1);
+    _requete += ';';
+    ecrirePoint(p2);
+    _connexion->envoyer(_requete);
+}
+
+/**
+ * @details Format texte : Polygone;couleur;x1,y1;x2,y2;...
+ */
+void VisiteurDessin::visite(const Polygone& polygone) {
+    const std::uint64_t version = std::max(polygone.getVersion(), _versionAncetres);
+    if (_differentiel && _profondeur == 0) _racinesImage.push_back(polygone.getIdentifiant());
+    if (_cadrage && cadrer(polygone, placer(polygone.calculerBoite()), version, polygone.getCouleur())) return;
+    if (!preparer(polygone, version)) return;
+    const Vecteur2D* sommets = nullptr;
+    std::size_t nbSommets = polygone.getSommets().size();
+    if (!_cadrage) {
+        sommets = placer(polygone, _places);
+    }
+    else {
+        const std::vector<Vecteur2D>* simplifie = simplifier(polygone, version);
+        sommets = simplifie->data();
+        nbSommets = simplifie->size();
+    }
+    if (_binaire) {
+        _binaire->polygone(sommets, nbSommets, couleur(polygone.getCouleur()));
+        envoyerTrameSiPleine();
+        return;
+    }
+    _requete += "Polygone;";
+    _requete += couleur(polygone.getCouleur());
+    for (std::size_t i = 0; i < nbSommets; ++i) {
+        _requete += ';';
+        ecrirePoint(sommets[i]);
+    }
+    _connexion->envoyer(_requete);
+}
+
+/**
+ * @details Les pièces sont dessinées une à une, avec la couleur du groupe.
+ * En mode différentiel, un groupe dont le sous-arbre et les ancêtres n'ont pas changé depuis
+ * le dernier envoi est sauté ; sinon ses enfants disparus sont supprimés.
+ */
+void VisiteurDessin::visite(const Groupe& groupe) {
+    const std::uint64_t ancetres = _versionAncetres;
+    const std::uint64_t id = groupe.getIdentifiant();
+    const std::uint64_t version = std::max(groupe.getVersionSousArbre(), ancetres);
+    if (_differentiel && _profondeur == 0) _racinesImage.push_back(id);
+    // Boîte mémorisée par le groupe : un groupe hors de la vue coûte O(1).
+    if (_cadrage && cadrer(groupe, placer(groupe.calculerBoite()), version, couleurGroupe(groupe))) return;
+
+    // Dans un prototype, les pièces ne sont suivies qu'à travers leur instance.
+    const bool suivi = _differentiel && !dansInstance();
+    std::vector<std::uint64_t> anciens;
+    if (suivi) {
+        auto it = _envois.find(id);
+        if (it != _envois.end() && !it->second.groupe) {
+            supprimer(id); // Réduit à un point jusqu'ici, désormais détaillé.
+            it = _envois.end();
+        }
+        if (it == _envois.end()) {
+            _envois.emplace(id, Envoi{ version, _numeroVue, true, {} });
+        }
+        else {
+            if (it->second.version == version && it->second.vue == _numeroVue) return; // Sous-arbre inchangé.
+            it->second.version = version;
+            it->second.vue = _numeroVue;
+            anciens.swap(it->second.enfants);
+        }
+    }
+
+    _versionAncetres = std::max(ancetres, groupe.getVersion());
+    const bool exterieur = _couleurGroupe == nullptr;
+    if (exterieur) _couleurGroupe = &couleurGroupe(groupe);
+    ++_profondeur;
+    std::vector<std::uint64_t> enfants;
+    for (const Forme* f : groupe.getFormes()) {
+        f->accepte(this);
+        if (suivi) enfants.push_back(f->getIdentifiant());
+    }
+    --_profondeur;
+    if (exterieur) _couleurGroupe = nullptr;
+    _versionAncetres = ancetres;
+
+    if (suivi) {
+        std::vector<std::uint64_t> tries(enfants);
+        std::sort(tries.begin(), tries.end());
+        for (std::uint64_t enfant : anciens) {
+            if (!std::binary_search(tries.begin(), tries.end(), enfant)) supprimer(enfant);
+        }
+        // La table a pu être réorganisée pendant la visite des enfants : l'entrée est relue.
+        _envois[id].enfants = std::move(enfants);
+    }
+}
+
+/**
+ * @details Le prototype partagé est parcouru en place, ses formes placées par la transformation
+ * de l'instance. Elles portent l'identifiant de leur prototype, commun à toutes les instances :
+ * l'instance est donc notée comme un groupe dont les enfants sont ses pièces envoyées, chacune
+ * sous un identifiant propre à cet envoi ; quand l'instance change, ses pièces sont supprimées
+ * avant que les nouvelles ne soient ajoutées.
+ */
+void VisiteurDessin::visite(const Instance& instance) {
+    if (dansInstance()) {
+        // Instance contenue dans un prototype : ses pièces sont celles de l'instance englobante.
+        if (_cadrage && cadrer(instance, placer(instance.calculerBoite()), _versionAncetres, instance.getCouleur())) {
+            return;
+        }
+        visiterPrototype(instance);
+        return;
+    }
+    const std::uint64_t id = instance.getIdentifiant();
+    // Le prototype, s'il n'est plus partagé, peut avoir été modifié sans que l'instance soit datée.
+    const std::uint64_t version = std::max({ instance.getVersionSousArbre(),
+                                             instance.getPartage()->getVersionSousArbre(), _versionAncetres });
+    if (_differentiel && _profondeur == 0) _racinesImage.push_back(id);
+    if (_cadrage && cadrer(instance, instance.calculerBoite(), version, instance.getCouleur())) return;
+
+    if (_differentiel) {
+        auto it = _envois.find(id);
+        if (it != _envois.end()) {
+            if (it->second.groupe && it->second.version == version && it->second.vue == _numeroVue) return;
+            supprimer(id); // Anciennes pièces, ou point.
+        }
+    }
+
+    std::vector<std::uint64_t> pieces;
+    _piecesInstance = &pieces;
+    ++_profondeur;
+    visiterPrototype(instance);
+    --_profondeur;
+    _piecesInstance = nullptr;
+    if (_differentiel) _envois[id] = Envoi{ version, _numeroVue, true, std::move(pieces) };
+}
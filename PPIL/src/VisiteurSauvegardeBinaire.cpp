@@ -0,0 +1,128 @@
+/**
+ * @file VisiteurSauvegardeBinaire.cpp
+ * @brief Implémentation de la sauvegarde des formes au format binaire.
+ */
+
+#include "../header/VisiteurSauvegardeBinaire.h"
+#include "../header/Cercle.h"
+#include "../header/Segement.h"
+#include "../header/Polygone.h"
+#include "../header/Group.h"
+#include "../header/Instance.h"
+#include <exception>
+#include <typeinfo>
+#include <vector>
+
+namespace {
+    /**
+     * @brief Ajoute à @p prototypes ceux des instances sous @p forme, dans l'ordre de rencontre.
+     * @details Seuls les sous-arbres qui contiennent des instances (Forme::nbInstances) sont
+     * parcourus : une scène sans instance n'en paie pas le coût. Les prototypes ne sont pas parcourus.
+     */
+    void prototypesUtilises(const Forme& forme, std::vector<const Groupe*>& prototypes) {
+        if (forme.nbInstances() == 0) return;
+        if (typeid(forme) == typeid(Groupe)) {
+            for (const Forme* f : static_cast<const Groupe&>(forme).getFormes()) prototypesUtilises(*f, prototypes);
+        }
+        else {
+            prototypes.push_back(&static_cast<const Instance&>(forme).getPrototype());
+        }
+    }
+}
+
+VisiteurSauvegardeBinaire::VisiteurSauvegardeBinaire(const std::string& nomFichier, std::size_t seuilVidage,
+                                                     double pasQuantification)
+    : _sortie(nomFichier, seuilVidage, true), _exceptionsEnCours(std::uncaught_exceptions()),
+      _encodeur(_sortie, pasQuantification) {
+}
+
+VisiteurSauvegardeBinaire::~VisiteurSauvegardeBinaire() {
+    // Destruction pendant la propagation d'une exception : sauvegarde incomplète, jamais publiée.
+    if (std::uncaught_exceptions() > _exceptionsEnCours) return;
+    try {
+        _sortie.valider();
+    }
+    catch (...) {
+        // Un destructeur ne doit pas propager : appeler valider() pour obtenir l'erreur.
+    }
+}
+
+/**
+ * @brief Sauvegarde d'un cercle.
+ * @details Données : cx, cy, r.
+ */
+void VisiteurSauvegardeBinaire::visite(const Cercle& cercle) {
+    _encodeur.cercle(cercle.getCouleur(), cercle.getCentre(), cercle.getRayon());
+}
+
+/**
+ * @brief Sauvegarde d'un segment.
+ * @details Données : x1, y1, x2, y2.
+ */
+void VisiteurSauvegardeBinaire::visite(const Segment& segment) {
+    _encodeur.segment(segment.getCouleur(), segment.getP1(), segment.getP2());
+}
+
+/**
+ * @brief Sauvegarde d'un polygone.
+ * @details Données : nombre de sommets puis les sommets.
+ */
+void VisiteurSauvegardeBinaire::visite(const Polygone& polygone) {
+    const auto& sommets = polygone.getSommets();
+    _encodeur.polygone(polygone.getCouleur(), sommets.data(), sommets.size());
+}
+
+/**
+ * @brief Sauvegarde récursive d'un groupe.
+ * @details La longueur du contenu n'est connue qu'après l'écriture des enfants :
+ * un emplacement est réservé puis complété a posteriori.
+ */
+void VisiteurSauvegardeBinaire::visite(const Groupe& groupe) {
+    if (_profondeur == 0) definirPrototypes(groupe);
+    const std::uint64_t debut = _encodeur.debutGroupe(groupe.getCouleur());
+    ecrireEnfants(groupe);
+    _encodeur.finGroupe(debut);
+}
+
+void VisiteurSauvegardeBinaire::ecrireEnfants(const Groupe& groupe) {
+    ++_profondeur;
+    for (const Forme* f : groupe.getFormes()) {
+        f->accepte(this);
+    }
+    --_profondeur;
+}
+
+/**
+ * @brief Définitions des prototypes, toujours au premier niveau.
+ * @details Un lecteur qui saute un groupe entier y a donc déjà lu tous les prototypes dont
+ * les instances suivantes ont besoin. Un prototype qui contient des instances est écrit après
+ * leurs propres prototypes : les numéros suivent l'ordre des en-têtes.
+ */
+void VisiteurSauvegardeBinaire::definirPrototypes(const Forme& forme) {
+    std::vector<const Groupe*> utilises;
+    prototypesUtilises(forme, utilises);
+    for (const Groupe* prototype : utilises) definirPrototype(*prototype);
+}
+
+void VisiteurSauvegardeBinaire::definirPrototype(const Groupe& prototype) {
+    if (_prototypes.count(&prototype)) return;
+    std::vector<const Groupe*> utilises;
+    for (const Forme* f : prototype.getFormes()) prototypesUtilises(*f, utilises);
+    for (const Groupe* p : utilises) definirPrototype(*p);
+
+    const std::uint32_t n = static_cast<std::uint32_t>(_prototypes.size());
+    _prototypes.emplace(&prototype, n);
+    const std::uint64_t debut = _encodeur.debutPrototype(prototype.getCouleur(), n);
+    ecrireEnfants(prototype);
+    _encodeur.finGroupe(debut);
+}
+
+/**
+ * @brief Sauvegarde d'une instance.
+ * @details Données : numéro du prototype, puis a, b, c, d, tx, ty. Le prototype a déjà été
+ * écrit, au premier niveau, avant la forme de premier niveau qui contient l'instance.
+ */
+void VisiteurSauvegardeBinaire::visite(const Instance& instance) {
+    if (_profondeur == 0) definirPrototype(instance.getPrototype());
+    _encodeur.instance(instance.getCouleur(), _prototypes.at(&instance.getPrototype()), instance.getTransformation());
+}
@@ -8,16 +8,27 @@
 #include "../header/Segement.h" // Note : Correction du nom de fichier si nécessaire
 #include "../header/Polygone.h"
 #include "../header/Group.h"
+#include <exception>
 
  /**
   * @brief Constructeur du visiteur de sauvegarde.
-  * @details Initialise le nom du fichier et efface le contenu précédent pour une nouvelle session de sauvegarde.
+  * @details Ouvre une seule fois le fichier temporaire de la session ; le contenu précédent
+  * de la destination n'est remplacé qu'à la validation.
   */
-VisiteurSauvegardeTexte::VisiteurSauvegardeTexte(const std::string& nomFichier)
-    : _nomFichier(nomFichier) {
-    // Vide le fichier au début d'une nouvelle session de sauvegarde
-    std::ofstream ofs(_nomFichier, std::ios::trunc);
-    ofs.close();
+VisiteurSauvegardeTexte::VisiteurSauvegardeTexte(const std::string& nomFichier, std::size_t seuilVidage)
+    : _nomFichier(nomFichier), _sortie(nomFichier, seuilVidage), _exceptionsEnCours(std::uncaught_exceptions()),
+      _encodeur(_sortie) {
+}
+
+VisiteurSauvegardeTexte::~VisiteurSauvegardeTexte() {
+    // Destruction pendant la propagation d'une exception : sauvegarde incomplète, jamais publiée.
+    if (std::uncaught_exceptions() > _exceptionsEnCours) return;
+    try {
+        _sortie.valider();
+    }
+    catch (...) {
+        // Un destructeur ne doit pas propager : appeler valider() pour obtenir l'erreur.
+    }
 }
 
 /**
@@ -25,11 +36,7 @@ VisiteurSauvegardeTexte::VisiteurSauvegardeTexte(const std::string& nomFichier)
  * @details Format : Cercle;couleur;centre;rayon.
  */
 void VisiteurSauvegardeTexte::visite(const Cercle& cercle) {
-    std::ofstream ofs(_nomFichier, std::ios::app);
-    // Format: Cercle;couleur;centre;rayon
-    ofs << "Cercle;" << cercle.getCouleur() << ";"
-        << (std::string)cercle.getCentre() << ";"
-        << cercle.getRayon() << std::endl;
+    _encodeur.cercle(cercle.getCouleur(), placer(cercle.getCentre()), placer(cercle.getRayon()));
 }
 
 /**
@@ -37,11 +44,7 @@ void VisiteurSauvegardeTexte::visite(const Cercle& cercle) {
  * @details Format : Segment;couleur;p1;p2.
  */
 void VisiteurSauvegardeTexte::visite(const Segment& segment) {
-    std::ofstream ofs(_nomFichier, std::ios::app);
-    // Format: Segment;couleur;p1;p2
-    ofs << "Segment;" << segment.getCouleur() << ";"
-        << (std::string)segment.getP1() << ";"
-        << (std::string)segment.getP2() << std::endl;
+    _encodeur.segment(segment.getCouleur(), placer(segment.getP1()), placer(segment.getP2()));
 }
 
 /**
@@ -50,13 +53,7 @@ void VisiteurSauvegardeTexte::visite(const Segment& segment) {
  * La liste des sommets est itérée pour garantir l'extensibilité du nombre de points.
  */
 void VisiteurSauvegardeTexte::visite(const Polygone& polygone) {
-    std::ofstream ofs(_nomFichier, std::ios::app);
-    // Format: Polygone;couleur;point1;point2;...
-    ofs << "Polygone;" << polygone.getCouleur();
-    for (const auto& s : polygone.getSommets()) {
-        ofs << ";" << (std::string)s;
-    }
-    ofs << std::endl;
+    _encodeur.polygone(polygone.getCouleur(), placer(polygone, _places), polygone.getSommets().size());
 }
 
 /**
@@ -65,10 +62,8 @@ void VisiteurSauvegardeTexte::visite(const Polygone& polygone) {
  * Chaque forme enfant accepte à son tour ce visiteur pour être sauvegardée.
  */
 void VisiteurSauvegardeTexte::visite(const Groupe& groupe) {
-    std::ofstream ofs(_nomFichier, std::ios::app);
     // Marque le début d'un groupe avec sa couleur
-    ofs << "Groupe;Debut;" << groupe.getCouleur() << std::endl;
-    ofs.close(); // Fermeture pour permettre aux visites enfants d'ouvrir le fichier
+    _encodeur.debutGroupe(couleurGroupe(groupe));
 
     // Appel récursif pour chaque forme contenue dans le groupe
     for (const Forme* f : groupe.getFormes()) {
@@ -76,6 +71,5 @@ void VisiteurSauvegardeTexte::visite(const Groupe& groupe) {
     }
 
     // Marque la fin de la structure du groupe
-    std::ofstream ofsEnd(_nomFichier, std::ios::app);
-    ofsEnd << "Groupe;Fin" << std::endl;
-}
\ No newline at end of file
+    _encodeur.finGroupe();
+}
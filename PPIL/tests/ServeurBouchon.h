@@ -0,0 +1,254 @@
+/**
+ * @file ServeurBouchon.h
+ * @brief Serveur de dessin factice sur la boucle locale, pour les tests et les mesures réseau.
+ */
+
+#ifndef SERVEUR_BOUCHON_H
+#define SERVEUR_BOUCHON_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "../header/FormatBinaire.h"
+#include "../header/ProtocoleDessin.h"
+
+ /**
+  * @class ServeurBouchon
+  * @brief Imite le serveur de dessin : accepte les connexions, découpe les requêtes et les garde.
+  * * Écoute sur 127.0.0.1, port choisi par le système. Chaque connexion commence en lignes ; une
+  * ligne d'offre ("Protocole;...") est acceptée, dans la limite fixée par limiterAcceptations(),
+  * et la connexion passe alors aux trames précédées de leur longueur (u32) ; sinon elle reçoit REFUS.
+  *
+  * - suspendre() cesse de lire les sockets : les tampons du noyau se remplissent et l'émetteur
+  *   subit la contre-pression ;
+  * - couper() ferme toutes les connexions ouvertes, ce qui force l'émetteur à se reconnecter ;
+  * - ignorerOffres() laisse les offres sans réponse, comme un pair qui accepte la connexion
+  *   puis ne répond plus.
+  *
+  * Quand les requêtes sont conservées, le tampon de réception des sockets est réduit pour que
+  * la contre-pression arrive vite.
+  */
+class ServeurBouchon {
+public:
+    /** @brief Requête reçue : ligne ou contenu de trame. */
+    struct Message {
+        std::size_t connexion; ///< Rang de la connexion (0 : la première acceptée).
+        bool trame;            ///< Vrai si reçue en trame binaire.
+        std::string octets;
+    };
+
+private:
+    /** @brief Connexion ouverte par un client. */
+    struct Client {
+        int socket;
+        std::size_t rang;
+        bool trames = false;
+        std::string tampon{}; ///< Octets reçus pas encore découpés.
+    };
+
+    int _ecoute = -1;
+    std::uint16_t _port = 0;
+    bool _conserver;
+    std::thread _thread;
+    std::atomic<bool> _arret{ false };
+    std::atomic<bool> _suspendu{ false };
+    std::atomic<bool> _couper{ false };
+
+    mutable std::mutex _verrou;
+    std::condition_variable _changement;
+    std::vector<Client> _clients;       ///< Accédé par le thread du serveur seul.
+    std::vector<Message> _messages;
+    std::size_t _nbMessages = 0;
+    std::size_t _nbConnexions = 0;
+    std::size_t _nbOffres = 0;
+    std::size_t _acceptationsRestantes = SIZE_MAX; ///< Offres encore acceptées, les suivantes refusées.
+    bool _offresSansReponse = false;               ///< Vrai : les offres sont comptées, jamais acceptées ni refusées.
+
+    /** @brief Découpe les requêtes complètes du tampon d'un client. */
+    void decouper(Client& c) {
+        std::size_t pos = 0;
+        std::unique_lock<std::mutex> verrou(_verrou);
+        for (;;) {
+            if (c.trames) {
+                if (c.tampon.size() - pos < 4) break;
+                const std::uint32_t n = FormatBinaire::decoder<std::uint32_t>(c.tampon.data() + pos);
+                if (c.tampon.size() - pos - 4 < n) break;
+                ranger(c, true, c.tampon.substr(pos + 4, n));
+                pos += 4 + n;
+                continue;
+            }
+            const std::size_t fin = c.tampon.find('\n', pos);
+            if (fin == std::string::npos) break;
+            if (!_conserver && c.tampon.compare(pos, 10, "Protocole;") != 0) {
+                // Mesures : compter sans copier.
+                ++_nbMessages;
+                pos = fin + 1;
+                continue;
+            }
+            std::string ligne = c.tampon.substr(pos, fin - pos);
+            pos = fin + 1;
+            if (ligne.rfind("Protocole;", 0) == 0) {
+                ++_nbOffres;
+                if (_offresSansReponse) continue;
+                c.trames = _acceptationsRestantes > 0;
+                if (c.trames) --_acceptationsRestantes;
+                const std::string reponse = (c.trames ? ProtocoleDessin::ACCEPTATION : REFUS) + '\n';
+                ::send(c.socket, reponse.data(), reponse.size(), MSG_NOSIGNAL);
+                continue;
+            }
+            ranger(c, false, std::move(ligne));
+        }
+        c.tampon.erase(0, pos);
+        verrou.unlock();
+        _changement.notify_all();
+    }
+
+    void ranger(const Client& c, bool trame, std::string octets) {
+        ++_nbMessages;
+        if (_conserver) _messages.push_back(Message{ c.rang, trame, std::move(octets) });
+    }
+
+    void fermerClients() {
+        for (Client& c : _clients) ::close(c.socket);
+        _clients.clear();
+    }
+
+    void boucle() {
+        std::vector<pollfd> attente;
+        std::vector<char> tampon(64 * 1024);
+        while (!_arret.load()) {
+            if (_couper.exchange(false)) fermerClients();
+            attente.assign(1, pollfd{ _ecoute, POLLIN, 0 });
+            if (!_suspendu.load()) {
+                for (const Client& c : _clients) attente.push_back(pollfd{ c.socket, POLLIN, 0 });
+            }
+            if (::poll(attente.data(), attente.size(), 20) <= 0) continue;
+            if (attente[0].revents & POLLIN) {
+                const int s = ::accept(_ecoute, nullptr, nullptr);
+                if (s >= 0) {
+                    std::lock_guard<std::mutex> verrou(_verrou);
+                    _clients.push_back(Client{ s, _nbConnexions++ });
+                }
+            }
+            for (std::size_t i = 1; i < attente.size(); ++i) {
+                if (!attente[i].revents) continue;
+                auto c = std::find_if(_clients.begin(), _clients.end(),
+                                      [&](const Client& x) { return x.socket == attente[i].fd; });
+                const ssize_t n = ::recv(c->socket, tampon.data(), tampon.size(), 0);
+                if (n <= 0) {
+                    ::close(c->socket);
+                    _clients.erase(c);
+                    continue;
+                }
+                c->tampon.append(tampon.data(), static_cast<std::size_t>(n));
+                decouper(*c);
+            }
+        }
+        fermerClients();
+    }
+
+public:
+    /**
+     * @param conserver Faux : les requêtes sont seulement comptées (mesures de débit).
+     * @throw std::runtime_error Si l'écoute ne peut pas être ouverte.
+     */
+    explicit ServeurBouchon(bool conserver = true) : _conserver(conserver) {
+        _ecoute = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (_ecoute < 0) throw std::runtime_error("Socket d'ecoute impossible");
+        const int un = 1;
+        const int petit = 4096;
+        ::setsockopt(_ecoute, SOL_SOCKET, SO_REUSEADDR, &un, sizeof(un));
+        // Pour les mesures, tampons par défaut : le serveur ne doit pas être le goulet.
+        if (_conserver) ::setsockopt(_ecoute, SOL_SOCKET, SO_RCVBUF, &petit, sizeof(petit));
+        sockaddr_in adresse{};
+        adresse.sin_family = AF_INET;
+        adresse.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t taille = sizeof(adresse);
+        if (::bind(_ecoute, reinterpret_cast<sockaddr*>(&adresse), taille) != 0
+            || ::listen(_ecoute, 64) != 0
+            || ::getsockname(_ecoute, reinterpret_cast<sockaddr*>(&adresse), &taille) != 0) {
+            ::close(_ecoute);
+            throw std::runtime_error("Ecoute impossible sur la boucle locale");
+        }
+        _port = ntohs(adresse.sin_port);
+        _thread = std::thread(&ServeurBouchon::boucle, this);
+    }
+
+    ~ServeurBouchon() {
+        _arret.store(true);
+        _thread.join();
+        ::close(_ecoute);
+    }
+
+    ServeurBouchon(const ServeurBouchon&) = delete;
+    ServeurBouchon& operator=(const ServeurBouchon&) = delete;
+
+    std::uint16_t port() const { return _port; }
+
+    /** @brief Réponse donnée aux offres refusées. */
+    inline static const std::string REFUS = "Non";
+
+    /** @brief Seules les @p nombre offres suivantes sont acceptées ; au-delà, refus. */
+    void limiterAcceptations(std::size_t nombre) {
+        std::lock_guard<std::mutex> verrou(_verrou);
+        _acceptationsRestantes = nombre;
+    }
+
+    /** @brief Laisse les offres suivantes sans réponse (true), comme un pair bloqué. */
+    void ignorerOffres(bool ignorer) {
+        std::lock_guard<std::mutex> verrou(_verrou);
+        _offresSansReponse = ignorer;
+    }
+
+    /** @brief Cesse (true) ou reprend (false) la lecture des sockets. */
+    void suspendre(bool suspendu) { _suspendu.store(suspendu); }
+
+    /** @brief Ferme toutes les connexions ouvertes ; les suivantes sont acceptées normalement. */
+    void couper() {
+        _couper.store(true);
+        while (_couper.load()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    /** @brief Attend d'avoir reçu au moins @p nombre requêtes ; false après @p delai. */
+    bool attendre(std::size_t nombre, std::chrono::milliseconds delai = std::chrono::milliseconds(5000)) {
+        std::unique_lock<std::mutex> verrou(_verrou);
+        return _changement.wait_for(verrou, delai, [&] { return _nbMessages >= nombre; });
+    }
+
+    /** @brief Requêtes reçues (offres exclues), dans l'ordre d'arrivée. */
+    std::vector<Message> messages() const {
+        std::lock_guard<std::mutex> verrou(_verrou);
+        return _messages;
+    }
+
+    std::size_t nbMessages() const {
+        std::lock_guard<std::mutex> verrou(_verrou);
+        return _nbMessages;
+    }
+
+    /** @brief Connexions acceptées depuis le démarrage. */
+    std::size_t nbConnexions() const {
+        std::lock_guard<std::mutex> verrou(_verrou);
+        return _nbConnexions;
+    }
+
+    /** @brief Offres de protocole reçues (rejeux après reconnexion compris). */
+    std::size_t nbOffres() const {
+        std::lock_guard<std::mutex> verrou(_verrou);
+        return _nbOffres;
+    }
+};
+
+#endif
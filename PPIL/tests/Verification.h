@@ -0,0 +1,33 @@
+/**
+ * @file Verification.h
+ * @brief Vérifications minimales des programmes de test (sans dépendance extérieure).
+ */
+
+#ifndef VERIFICATION_H
+#define VERIFICATION_H
+
+#include <iostream>
+
+/** @brief Vérifie une condition ; un échec est signalé sans interrompre le test. */
+#define VERIFIER(condition) Verification::verifier(static_cast<bool>(condition), #condition, __FILE__, __LINE__)
+
+namespace Verification {
+    /** @brief Nombre de vérifications échouées depuis le début du programme. */
+    inline int echecs = 0;
+
+    inline bool verifier(bool ok, const char* texte, const char* fichier, int ligne) {
+        if (!ok) {
+            ++echecs;
+            std::cerr << fichier << ":" << ligne << " : echec de " << texte << std::endl;
+        }
+        return ok;
+    }
+
+    /** @brief Code de sortie du programme de test : 0 si tout a réussi. */
+    inline int resultat() {
+        if (echecs) std::cerr << echecs << " verification(s) en echec" << std::endl;
+        return echecs ? 1 : 0;
+    }
+}
+
+#endif
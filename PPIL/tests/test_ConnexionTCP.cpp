@@ -0,0 +1,188 @@
+/**
+ * @file test_ConnexionTCP.cpp
+ * @brief ConnexionTCP face au serveur factice : regroupement, vidage, contre-pression, reconnexion.
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "ServeurBouchon.h"
+#include "Verification.h"
+#include "../header/ConnexionTCP.h"
+
+namespace {
+    using namespace std::chrono_literals;
+
+    std::string requete(std::size_t i) { return "Cercle;red;" + std::to_string(i) + ",0;1"; }
+
+    /** @brief Vrai si les messages [debut, debut + n) sont les requêtes numérotées à partir de @p premier. */
+    bool suiteExacte(const std::vector<ServeurBouchon::Message>& m, std::size_t debut, std::size_t n, std::size_t premier) {
+        if (m.size() < debut + n) return false;
+        for (std::size_t i = 0; i < n; ++i) {
+            if (m[debut + i].octets != requete(premier + i)) return false;
+        }
+        return true;
+    }
+
+    /** @brief Dernière requête reçue par le serveur (vide s'il n'a rien reçu). */
+    ServeurBouchon::Message dernier(const ServeurBouchon& serveur) {
+        const std::vector<ServeurBouchon::Message> m = serveur.messages();
+        return m.empty() ? ServeurBouchon::Message{} : m.back();
+    }
+
+    /** @brief Envoie des requêtes de sonde jusqu'à ce que la connexion se soit rétablie. */
+    bool provoquerReconnexion(ConnexionTCP& c) {
+        const std::uint64_t avant = c.statistiques().reconnexions;
+        for (int essai = 0; essai < 500 && c.statistiques().reconnexions == avant; ++essai) {
+            c.envoyer("Sonde");
+            c.vider();
+            std::this_thread::sleep_for(10ms);
+        }
+        return c.statistiques().reconnexions > avant;
+    }
+
+    void regroupementEtVidage() {
+        ServeurBouchon serveur;
+        ConnexionTCP c("127.0.0.1", serveur.port());
+        const std::size_t n = 5000;
+        for (std::size_t i = 0; i < n; ++i) c.envoyer(requete(i));
+        c.vider();
+        // vider() rend la main une fois tout écrit : plus rien n'attend côté client.
+        const ConnexionTCP::Statistiques s = c.statistiques();
+        VERIFIER(s.requetes == n);
+        VERIFIER(s.lots < n / 10); // Des centaines de requêtes par envoi.
+        VERIFIER(serveur.attendre(n));
+        VERIFIER(suiteExacte(serveur.messages(), 0, n, 0));
+
+        // Paquet préparé par l'appelant : une seule opération sur la file.
+        std::string paquet;
+        const bool trame = c.enTrames();
+        for (std::size_t i = 0; i < 100; ++i) ConnexionTCP::ajouterRequete(paquet, requete(n + i), trame);
+        c.envoyerPaquet(std::move(paquet), 100, trame);
+        c.vider();
+        VERIFIER(c.statistiques().requetes == n + 100);
+        VERIFIER(serveur.attendre(n + 100));
+        VERIFIER(suiteExacte(serveur.messages(), n, 100, n));
+    }
+
+    void contrePression() {
+        ServeurBouchon serveur;
+        ConnexionTCP::Options options;
+        options.capaciteFile = 8;
+        options.tailleLot = 4096;
+        ConnexionTCP c("127.0.0.1", serveur.port(), options);
+
+        // Serveur muet : tampons du noyau pleins, puis file pleine.
+        serveur.suspendre(true);
+        const std::string grosse(64 * 1024, 'x');
+        std::size_t acceptees = 0;
+        while (acceptees < 10000 && c.essayerEnvoyer(grosse)) ++acceptees;
+        VERIFIER(acceptees < 10000);
+        VERIFIER(!c.essayerEnvoyer(grosse));
+
+        serveur.suspendre(false);
+        c.vider();
+        VERIFIER(c.statistiques().requetes == acceptees);
+        VERIFIER(serveur.attendre(acceptees));
+        VERIFIER(serveur.nbMessages() == acceptees);
+        VERIFIER(c.essayerEnvoyer("Apres"));
+        c.vider();
+    }
+
+    void reconnexion() {
+        ServeurBouchon serveur;
+        ConnexionTCP c("127.0.0.1", serveur.port());
+        for (std::size_t i = 0; i < 100; ++i) c.envoyer(requete(i));
+        c.vider();
+        VERIFIER(serveur.attendre(100));
+
+        const std::uint64_t generation = c.generation();
+        serveur.couper();
+        VERIFIER(provoquerReconnexion(c));
+        VERIFIER(serveur.nbConnexions() >= 2);
+        VERIFIER(c.generation() > generation);
+
+        const std::size_t avant = serveur.nbMessages();
+        for (std::size_t i = 0; i < 100; ++i) c.envoyer(requete(1000 + i));
+        c.vider();
+        VERIFIER(serveur.attendre(avant + 100));
+        // Requêtes entières, dans l'ordre, sur la nouvelle connexion.
+        const std::vector<ServeurBouchon::Message> m = serveur.messages();
+        VERIFIER(m.size() >= 100 && suiteExacte(m, m.size() - 100, 100, 1000));
+        VERIFIER(!m.empty() && m.back().connexion >= 1);
+    }
+
+    void reconnexionNegociee() {
+        ServeurBouchon serveur;
+        ConnexionTCP c("127.0.0.1", serveur.port());
+        VERIFIER(c.negocier("Protocole;binaire;1;0.01"));
+        VERIFIER(c.enTrames());
+        c.envoyer("trame");
+        c.vider();
+        VERIFIER(serveur.attendre(1));
+        VERIFIER(dernier(serveur).trame);
+
+        // Le serveur retrouvé accepte encore : l'offre est rejouée, les trames continuent.
+        serveur.couper();
+        VERIFIER(provoquerReconnexion(c));
+        VERIFIER(c.enTrames());
+        VERIFIER(serveur.nbOffres() == 2);
+        std::size_t avant = serveur.nbMessages();
+        c.envoyer("encore");
+        c.vider();
+        VERIFIER(serveur.attendre(avant + 1));
+        VERIFIER(dernier(serveur).trame && dernier(serveur).octets == "encore");
+
+        // Paquet commencé en trames, déposé seulement après le retour au texte.
+        const bool trame = c.enTrames();
+        std::string paquet;
+        ConnexionTCP::ajouterRequete(paquet, "orpheline", trame);
+
+        // Le serveur retrouvé refuse : retour au texte, les trames en attente sont abandonnées.
+        serveur.limiterAcceptations(0);
+        serveur.couper();
+        VERIFIER(provoquerReconnexion(c));
+        VERIFIER(!c.enTrames());
+        const std::uint64_t perdues = c.statistiques().perdues;
+        VERIFIER(perdues > 0);
+        c.envoyerPaquet(std::move(paquet), 1, trame);
+        c.vider();
+        VERIFIER(c.statistiques().perdues == perdues + 1);
+        avant = serveur.nbMessages();
+        c.envoyer(requete(7));
+        c.vider();
+        VERIFIER(serveur.attendre(avant + 1));
+        VERIFIER(!dernier(serveur).trame && dernier(serveur).octets == requete(7));
+    }
+
+    void pairMuetALaFermeture() {
+        ServeurBouchon serveur;
+        ConnexionTCP::Options options;
+        options.delaiNegociation = 50ms;
+        auto c = std::make_unique<ConnexionTCP>("127.0.0.1", serveur.port(), options);
+        VERIFIER(c->negocier("Protocole;binaire;1;0.01"));
+
+        // Le pair retrouvé accepte la connexion mais ne répond jamais à l'offre rejouée.
+        serveur.ignorerOffres(true);
+        serveur.couper();
+        for (int essai = 0; essai < 500 && serveur.nbOffres() < 3; ++essai) {
+            c->essayerEnvoyer("trame");
+            std::this_thread::sleep_for(10ms);
+        }
+        VERIFIER(serveur.nbOffres() >= 3);
+
+        // La fermeture abandonne les trames au lieu de relancer l'offre indéfiniment.
+        const auto debut = std::chrono::steady_clock::now();
+        c.reset();
+        VERIFIER(std::chrono::steady_clock::now() - debut < 5s);
+    }
+}
+
+int main() {
+    regroupementEtVidage();
+    contrePression();
+    reconnexion();
+    reconnexionNegociee();
+    pairMuetALaFermeture();
+    return Verification::resultat();
+}
@@ -0,0 +1,88 @@
+/**
+ * @file test_PoolConnexions.cpp
+ * @brief PoolConnexions face au serveur factice : négociation tout ou rien, ordre par producteur.
+ */
+
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ServeurBouchon.h"
+#include "Verification.h"
+#include "../header/PoolConnexions.h"
+
+namespace {
+    PoolConnexions::Options options(std::size_t nbConnexions) {
+        PoolConnexions::Options o;
+        o.nbConnexions = nbConnexions;
+        o.taillePaquet = 512;
+        return o;
+    }
+
+    void negociationRefusee() {
+        ServeurBouchon serveur;
+        PoolConnexions pool("127.0.0.1", serveur.port(), options(4));
+        // Les deux premières connexions acceptent, la troisième refuse.
+        serveur.limiterAcceptations(2);
+        VERIFIER(!pool.negocier("Protocole;binaire;1;0.01"));
+        VERIFIER(!pool.enTrames());
+        VERIFIER(serveur.nbOffres() == 3);
+
+        // Toutes les connexions, y compris celles qui avaient accepté, parlent de nouveau texte.
+        for (std::uint64_t flux = 0; flux < 4; ++flux) pool.envoyer(flux, "Cercle;red;" + std::to_string(flux) + ",0;1");
+        pool.vider();
+        VERIFIER(serveur.attendre(4));
+        const std::vector<ServeurBouchon::Message> m = serveur.messages();
+        VERIFIER(m.size() == 4);
+        for (const ServeurBouchon::Message& message : m) {
+            VERIFIER(!message.trame && message.octets.rfind("Cercle;red;", 0) == 0);
+        }
+    }
+
+    void negociationAcceptee() {
+        ServeurBouchon serveur;
+        PoolConnexions pool("127.0.0.1", serveur.port(), options(3));
+        VERIFIER(pool.negocier("Protocole;binaire;1;0.01"));
+        VERIFIER(pool.enTrames());
+        for (std::uint64_t flux = 0; flux < 3; ++flux) pool.envoyer(flux, "trame");
+        pool.vider();
+        VERIFIER(serveur.attendre(3));
+        for (const ServeurBouchon::Message& message : serveur.messages()) VERIFIER(message.trame);
+    }
+
+    void producteursConcurrents() {
+        ServeurBouchon serveur;
+        PoolConnexions pool("127.0.0.1", serveur.port(), options(4));
+        const std::size_t nbProducteurs = 8, parProducteur = 2000;
+        std::vector<std::thread> producteurs;
+        for (std::size_t t = 0; t < nbProducteurs; ++t) {
+            producteurs.emplace_back([&, t] {
+                for (std::size_t i = 0; i < parProducteur; ++i) {
+                    pool.envoyer(std::to_string(t) + ";" + std::to_string(i));
+                }
+                pool.vider();
+            });
+        }
+        for (std::thread& p : producteurs) p.join();
+        VERIFIER(serveur.attendre(nbProducteurs * parProducteur));
+        VERIFIER(pool.statistiques().requetes == nbProducteurs * parProducteur);
+
+        // Chaque producteur passe par une seule connexion : ses requêtes arrivent dans l'ordre.
+        std::map<std::size_t, std::size_t> suivante;
+        bool ordre = true;
+        for (const ServeurBouchon::Message& message : serveur.messages()) {
+            const std::size_t separateur = message.octets.find(';');
+            const std::size_t t = std::stoull(message.octets.substr(0, separateur));
+            ordre = ordre && std::stoull(message.octets.substr(separateur + 1)) == suivante[t]++;
+        }
+        VERIFIER(ordre);
+        VERIFIER(suivante.size() == nbProducteurs);
+    }
+}
+
+int main() {
+    negociationRefusee();
+    negociationAcceptee();
+    producteursConcurrents();
+    return Verification::resultat();
+}
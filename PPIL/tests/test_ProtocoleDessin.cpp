@@ -0,0 +1,101 @@
+/**
+ * @file test_ProtocoleDessin.cpp
+ * @brief Aller-retour encodage / décodage des trames de dessin ; rejet des trames tronquées.
+ */
+
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "Verification.h"
+#include "../header/Forme.h"
+#include "../header/ProtocoleDessin.h"
+
+namespace {
+    using namespace ProtocoleDessin;
+
+    const double PAS = 0.01;
+    const std::string LIBRE = "magenta"; // Hors palette : transmise en toutes lettres.
+
+    bool proche(const Vecteur2D& a, const Vecteur2D& b) {
+        return std::abs(a.x - b.x) <= PAS / 2 + 1e-12 && std::abs(a.y - b.y) <= PAS / 2 + 1e-12;
+    }
+
+    bool rejetee(const std::string& trame, std::size_t taille) {
+        try {
+            decoder(trame.data(), taille, PAS);
+        }
+        catch (const std::runtime_error&) {
+            return true;
+        }
+        return false;
+    }
+}
+
+int main() {
+    const Vecteur2D centre(12.3456, -7.891), p1(-1000.004, 0.5), p2(3.14159, 2.71828), seul(0.004, -0.006);
+    const std::vector<Vecteur2D> sommets = { Vecteur2D(0, 0), Vecteur2D(10.001, 0.002),
+                                             Vecteur2D(10.5, 9.999), Vecteur2D(-0.333, 5.555) };
+
+    Encodeur e(PAS);
+    std::vector<std::size_t> fins; // Fin de chaque commande dans la trame.
+    e.cercle(centre, 4.567, Forme::RED);                 fins.push_back(e.trame().size());
+    e.segment(p1, p2, LIBRE);                            fins.push_back(e.trame().size());
+    e.polygone(sommets.data(), sommets.size(), LIBRE);   fins.push_back(e.trame().size());
+    e.point(seul, Forme::CYAN);                          fins.push_back(e.trame().size());
+    e.operation(AJOUT, 42);
+    e.cercle(centre, 1, LIBRE);                          fins.push_back(e.trame().size());
+    e.operation(MISE_A_JOUR, 300);
+    e.segment(p2, p1, Forme::BLACK);                     fins.push_back(e.trame().size());
+    e.operation(SUPPRESSION, 1u << 20);                  fins.push_back(e.trame().size());
+    const std::string trame = e.trame();
+
+    const std::vector<Commande> c = decoder(trame.data(), trame.size(), PAS);
+    VERIFIER(c.size() == fins.size());
+    if (c.size() == fins.size()) {
+        VERIFIER(c[0].code == CERCLE && c[0].operation == 0 && c[0].couleur == Forme::RED);
+        VERIFIER(c[0].points.size() == 1 && proche(c[0].points[0], centre));
+        VERIFIER(std::abs(c[0].rayon - 4.567) <= PAS / 2);
+
+        VERIFIER(c[1].code == SEGMENT && c[1].couleur == LIBRE && c[1].points.size() == 2);
+        VERIFIER(c[1].points.size() == 2 && proche(c[1].points[0], p1) && proche(c[1].points[1], p2));
+
+        VERIFIER(c[2].code == POLYGONE && c[2].couleur == LIBRE && c[2].points.size() == sommets.size());
+        for (std::size_t i = 0; i < sommets.size() && i < c[2].points.size(); ++i) {
+            VERIFIER(proche(c[2].points[i], sommets[i]));
+        }
+
+        VERIFIER(c[3].code == POINT && c[3].couleur == Forme::CYAN && c[3].points.size() == 1);
+        VERIFIER(c[3].points.size() == 1 && proche(c[3].points[0], seul));
+
+        VERIFIER(c[4].operation == AJOUT && c[4].identifiant == 42 && c[4].code == CERCLE && c[4].couleur == LIBRE);
+        VERIFIER(c[5].operation == MISE_A_JOUR && c[5].identifiant == 300 && c[5].code == SEGMENT);
+        VERIFIER(c[5].couleur == Forme::BLACK && c[5].points.size() == 2 && proche(c[5].points[0], p2));
+        VERIFIER(c[6].operation == SUPPRESSION && c[6].code == SUPPRESSION && c[6].identifiant == (1u << 20));
+    }
+
+    // Une trame coupée entre deux commandes se décode ; coupée au milieu d'une commande, elle est rejetée.
+    for (std::size_t taille = 0; taille < trame.size(); ++taille) {
+        std::size_t completes = 0;
+        while (completes < fins.size() && fins[completes] <= taille) ++completes;
+        const bool frontiere = taille == 0 || (completes > 0 && fins[completes - 1] == taille);
+        if (frontiere) VERIFIER(decoder(trame.data(), taille, PAS).size() == completes);
+        else VERIFIER(rejetee(trame, taille));
+    }
+
+    // Nombre de sommets démesuré, code et indice de couleur inconnus.
+    const std::string demesure = { char(POLYGONE), 0, char(0xFF), char(0xFF), char(0xFF), char(0x7F) };
+    VERIFIER(rejetee(demesure, demesure.size()));
+    const std::string code = { char(0x7E), 0 };
+    VERIFIER(rejetee(code, code.size()));
+    const std::string couleur = { char(CERCLE), char(0x40), 0, 0, 0 };
+    VERIFIER(rejetee(couleur, couleur.size()));
+
+    // Chaque trame repart de l'origine : elle se décode seule.
+    e.nouvelleTrame();
+    e.point(seul, Forme::GREEN);
+    const std::vector<Commande> seule = decoder(e.trame().data(), e.trame().size(), PAS);
+    VERIFIER(seule.size() == 1 && seule[0].points.size() == 1 && proche(seule[0].points[0], seul));
+
+    return Verification::resultat();
+}
@@ -0,0 +1,195 @@
+/**
+ * @file test_SauvegardeBinaire.cpp
+ * @brief Aller-retour sauvegarde / chargement binaire, réels exacts et quantifiés, petits rayons compris ;
+ * prototypes toujours définis au premier niveau, visités en place comme développés.
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Verification.h"
+#include "../header/ChargeurBinaire.h"
+#include "../header/Cercle.h"
+#include "../header/FormatBinaire.h"
+#include "../header/Group.h"
+#include "../header/Instance.h"
+#include "../header/Polygone.h"
+#include "../header/Segement.h"
+#include "../header/VisiteurSauvegardeBinaire.h"
+
+namespace {
+    /** @brief Forme simple ou bornes de groupe, dans l'ordre de la visite. */
+    struct Element {
+        char type; ///< 'C', 'S', 'P', 'G' (début de groupe) ou 'F' (fin de groupe).
+        std::string couleur;
+        std::vector<Vecteur2D> points;
+        double rayon = 0;
+    };
+
+    /** @brief Aplatit une scène ; les prototypes des instances sont parcourus en place (visite par défaut). */
+    class Releve : public VisiteurForme {
+    public:
+        std::vector<Element> elements;
+
+        void visite(const Cercle& c) override {
+            elements.push_back({ 'C', c.getCouleur(), { placer(c.getCentre()) }, placer(c.getRayon()) });
+        }
+        void visite(const Segment& s) override { elements.push_back({ 'S', s.getCouleur(), { placer(s.getP1()), placer(s.getP2()) } }); }
+        void visite(const Polygone& p) override {
+            std::vector<Vecteur2D> places;
+            const Vecteur2D* sommets = placer(p, places);
+            elements.push_back({ 'P', p.getCouleur(), std::vector<Vecteur2D>(sommets, sommets + p.getSommets().size()) });
+        }
+        void visite(const Groupe& g) override {
+            elements.push_back({ 'G', couleurGroupe(g), {} });
+            for (const Forme* f : g.getFormes()) f->accepte(this);
+            elements.push_back({ 'F', "", {} });
+        }
+    };
+
+    std::vector<Element> relever(const std::vector<Forme*>& formes) {
+        Releve r;
+        for (const Forme* f : formes) f->accepte(&r);
+        return r.elements;
+    }
+
+    /** @brief Vrai si les relevés de @p a et @p b sont identiques au bit près. */
+    bool memeReleve(const std::vector<Element>& a, const std::vector<Element>& b) {
+        if (a.size() != b.size()) return false;
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            if (a[i].type != b[i].type || a[i].couleur != b[i].couleur || a[i].rayon != b[i].rayon ||
+                a[i].points.size() != b[i].points.size()) {
+                return false;
+            }
+            for (std::size_t j = 0; j < a[i].points.size(); ++j) {
+                if (a[i].points[j].x != b[i].points[j].x || a[i].points[j].y != b[i].points[j].y) return false;
+            }
+        }
+        return true;
+    }
+
+    /** @brief Relit @p nom en comparant chaque coordonnée à @p tolerance près ; rayons d'au moins @p pas. */
+    bool allerRetour(const std::vector<Forme*>& scene, const std::string& nom, double pas) {
+        {
+            VisiteurSauvegardeBinaire v(nom, TamponFichier::SEUIL_DEFAUT, pas);
+            for (const Forme* f : scene) f->accepte(&v);
+            v.valider();
+        }
+        std::vector<Forme*> relues;
+        try {
+            relues = ChargeurBinaire::chargerFichier(nom);
+        }
+        catch (const std::exception&) {
+            std::remove(nom.c_str());
+            return false;
+        }
+        std::remove(nom.c_str());
+
+        const std::vector<Element> a = relever(scene), b = relever(relues);
+        for (Forme* f : relues) delete f;
+        if (a.size() != b.size()) return false;
+        const double tolerance = pas / 2 + 1e-9;
+        const auto proche = [&](double x, double y) { return pas ? std::abs(x - y) <= tolerance : x == y; };
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            if (a[i].type != b[i].type || a[i].couleur != b[i].couleur || a[i].points.size() != b[i].points.size()) return false;
+            for (std::size_t j = 0; j < a[i].points.size(); ++j) {
+                if (!proche(a[i].points[j].x, b[i].points[j].x) || !proche(a[i].points[j].y, b[i].points[j].y)) return false;
+            }
+            if (a[i].type == 'C' && !(b[i].rayon > 0 && proche(std::max(a[i].rayon, pas), b[i].rayon))) return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Parcourt le premier niveau d'un fichier en réels exacts, en sautant groupes et prototypes.
+     * @return Vrai si chaque instance rencontrée ainsi désigne un prototype déjà défini.
+     */
+    bool instancesDefiniesSansGroupes(const std::vector<Forme*>& scene, const std::string& nom) {
+        {
+            VisiteurSauvegardeBinaire v(nom);
+            for (const Forme* f : scene) f->accepte(&v);
+            v.valider();
+        }
+        std::ifstream ifs(nom, std::ios::binary);
+        const std::string octets((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+        ifs.close();
+        std::remove(nom.c_str());
+
+        std::size_t i = FormatBinaire::TAILLE_EN_TETE, definis = 0;
+        std::size_t instances = 0;
+        while (i < octets.size()) {
+            const char etiquette = octets[i++];
+            if (static_cast<std::uint8_t>(octets[i++]) == FormatBinaire::COULEUR_LIBRE) {
+                i += 2 + FormatBinaire::decoder<std::uint16_t>(&octets[i]);
+            }
+            switch (etiquette) {
+            case FormatBinaire::CERCLE: i += 24; break;
+            case FormatBinaire::SEGMENT: i += 32; break;
+            case FormatBinaire::POLYGONE: i += 4 + 16 * FormatBinaire::decoder<std::uint32_t>(&octets[i]); break;
+            case FormatBinaire::GROUPE: i += 8 + FormatBinaire::decoder<std::uint64_t>(&octets[i]); break;
+            case FormatBinaire::PROTOTYPE:
+                if (FormatBinaire::decoder<std::uint32_t>(&octets[i]) != definis++) return false;
+                i += 12 + FormatBinaire::decoder<std::uint64_t>(&octets[i + 4]);
+                break;
+            case FormatBinaire::INSTANCE:
+                if (FormatBinaire::decoder<std::uint32_t>(&octets[i]) >= definis) return false;
+                ++instances;
+                i += 4 + 48;
+                break;
+            default: return false;
+            }
+        }
+        return i == octets.size() && instances > 0;
+    }
+}
+
+int main() {
+    const double pas = 0.01;
+    std::vector<Forme*> scene;
+    scene.push_back(new Cercle(Vecteur2D(12.3456, -7.891), 4.567, Forme::RED));
+    scene.push_back(new Cercle(Vecteur2D(1, 1), 0.004, Forme::BLUE)); // Rayon < pas / 2 : arrondi à 0 sans borne.
+    scene.push_back(new Segment(Vecteur2D(-1000.004, 0.5), Vecteur2D(3.14159, 2.71828), "magenta"));
+    scene.push_back(new Polygone({ Vecteur2D(0, 0), Vecteur2D(10.001, 0.002), Vecteur2D(10.5, 9.999),
+                                   Vecteur2D(5, 12), Vecteur2D(-0.333, 5.555), Vecteur2D(-1, 1) }, Forme::GREEN));
+
+    Groupe* prototype = new Groupe(Forme::BLACK);
+    prototype->ajouter(new Cercle(Vecteur2D(0, 0), 1, Forme::YELLOW));
+    prototype->ajouter(new Segment(Vecteur2D(0, 0), Vecteur2D(2, 0), Forme::CYAN));
+    const std::shared_ptr<const Groupe> partage = Instance::partager(prototype);
+
+    // Prototype dont le contenu est lui-même une instance : partage doit être défini avant lui.
+    Groupe* compose = new Groupe(Forme::BLUE);
+    compose->ajouter(new Instance(partage, Transformation2D::homothetie(Vecteur2D(0, 0), 2), Forme::RED));
+    compose->ajouter(new Cercle(Vecteur2D(5, 5), 0.5, Forme::GREEN));
+    const std::shared_ptr<const Groupe> partageCompose = Instance::partager(compose);
+
+    Groupe* groupe = new Groupe(Forme::BLUE);
+    Groupe* imbrique = new Groupe(Forme::RED);
+    imbrique->ajouter(new Cercle(Vecteur2D(-3, 4), 0.2, Forme::BLACK));
+    imbrique->ajouter(new Instance(partageCompose, Transformation2D::translation(Vecteur2D(-5, 0)), Forme::YELLOW));
+    imbrique->ajouter(new Instance(partage, Transformation2D::rotation(Vecteur2D(1, 1), 0.3), Forme::GREEN));
+    groupe->ajouter(imbrique);
+    groupe->ajouter(new Segment(Vecteur2D(7, 7), Vecteur2D(8, 9), Forme::BLACK));
+    groupe->translation(Vecteur2D(0.125, -3)); // Transformation encore en attente à la sauvegarde.
+    scene.push_back(groupe);
+    scene.push_back(new Instance(partage, Transformation2D::translation(Vecteur2D(20, 0)), Forme::CYAN));
+
+    // Prototype parcouru en place : mêmes formes, au bit près, que le groupe développé.
+    for (Forme* f : imbrique->getFormes()) {
+        if (const Instance* instance = dynamic_cast<const Instance*>(f)) {
+            const std::unique_ptr<Groupe> developpe = instance->developper();
+            VERIFIER(memeReleve(relever({ f }), relever({ developpe.get() })));
+        }
+    }
+    VERIFIER(allerRetour(scene, "test_SauvegardeBinaire_exacte.bin", 0));
+    VERIFIER(allerRetour(scene, "test_SauvegardeBinaire_quantifiee.bin", pas));
+    // Première instance au fond d'un groupe : un lecteur qui saute les groupes trouve quand même les prototypes.
+    VERIFIER(instancesDefiniesSansGroupes(scene, "test_SauvegardeBinaire_prototypes.bin"));
+
+    for (Forme* f : scene) delete f;
+    return Verification::resultat();
+}
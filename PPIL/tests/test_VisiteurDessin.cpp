@@ -0,0 +1,132 @@
+/**
+ * @file test_VisiteurDessin.cpp
+ * @brief Envoi différentiel d'une scène contenant des instances : rien de renvoyé sans changement,
+ * anciennes pièces supprimées quand l'instance change, tout renvoyé après une reconnexion ;
+ * pièces d'un même prototype distinctes d'une instance à l'autre.
+ */
+
+#include <set>
+#include <string>
+#include <vector>
+#include "Verification.h"
+#include "../header/Cercle.h"
+#include "../header/Connexion_m.h"
+#include "../header/Group.h"
+#include "../header/Instance.h"
+#include "../header/VisiteurDessin.h"
+
+namespace {
+    /** @brief Connexion qui garde les requêtes et tient la liste des formes affichées par le serveur. */
+    class ConnexionEnregistreuse : public ConnexionManager {
+    public:
+        std::vector<std::string> requetes; ///< Requêtes de l'image en cours.
+        std::set<std::uint64_t> affichees; ///< Identifiants ajoutés et pas encore supprimés.
+        bool coherent = true;              ///< Faux après un ajout en double ou une opération sur l'inconnu.
+        std::uint64_t pair = 0;            ///< Génération : incrémentée pour simuler une reconnexion.
+
+        std::uint64_t generation() const override { return pair; }
+
+        /** @brief Reconnexion à un serveur neuf, qui n'affiche rien. */
+        void reconnecter() {
+            ++pair;
+            affichees.clear();
+        }
+
+        void envoyer(const std::string& requete) override {
+            requetes.push_back(requete);
+            const std::size_t debut = requete.find(';') + 1;
+            const std::uint64_t id = std::stoull(requete.substr(debut, requete.find(';', debut) - debut));
+            if (requete.rfind("Ajout;", 0) == 0) coherent = affichees.insert(id).second && coherent;
+            else if (requete.rfind("MiseAJour;", 0) == 0) coherent = affichees.count(id) && coherent;
+            else if (requete.rfind("Suppression;", 0) == 0) coherent = affichees.erase(id) && coherent;
+        }
+
+        void vider() override {}
+
+        std::size_t nombre(const char* prefixe) const {
+            std::size_t n = 0;
+            for (const std::string& r : requetes) n += r.rfind(prefixe, 0) == 0;
+            return n;
+        }
+    };
+
+    void image(Groupe& scene, VisiteurDessin& v, ConnexionEnregistreuse& c) {
+        c.requetes.clear();
+        scene.accepte(&v);
+        v.terminer();
+    }
+}
+
+int main() {
+    Groupe* prototype = new Groupe(Forme::BLACK);
+    prototype->ajouter(new Cercle(Vecteur2D(0, 0), 1, Forme::RED));
+    prototype->ajouter(new Cercle(Vecteur2D(5, 0), 1, Forme::RED));
+    const std::shared_ptr<const Groupe> partage = Instance::partager(prototype);
+
+    Groupe scene(Forme::BLACK);
+    Instance* instance = new Instance(partage, Transformation2D::translation(Vecteur2D(10, 0)), Forme::BLUE);
+    scene.ajouter(instance);
+    scene.ajouter(new Cercle(Vecteur2D(-5, -5), 2, Forme::GREEN));
+
+    ConnexionEnregistreuse c;
+    VisiteurDessin v(&c);
+    v.activerDifferentiel();
+
+    // Image 0 : tout est ajouté, deux cercles pour l'instance et le cercle seul.
+    image(scene, v, c);
+    VERIFIER(c.nombre("Ajout;") == 3 && c.requetes.size() == 3);
+    VERIFIER(c.affichees.size() == 3);
+
+    // Image 1 : rien n'a changé, rien n'est envoyé (aucune pièce renvoyée).
+    image(scene, v, c);
+    VERIFIER(c.requetes.empty());
+
+    // Image 2 : l'instance bouge ; les anciennes pièces sont supprimées, les nouvelles ajoutées.
+    instance->translation(Vecteur2D(0, 3));
+    image(scene, v, c);
+    VERIFIER(c.nombre("Suppression;") == 2 && c.nombre("Ajout;") == 2);
+    VERIFIER(c.affichees.size() == 3);
+
+    // Images 3 à 12 : la même scène reste stable, le serveur n'accumule rien.
+    for (int i = 0; i < 10; ++i) {
+        instance->rotation(Vecteur2D(0, 0), 0.1);
+        image(scene, v, c);
+        VERIFIER(c.affichees.size() == 3);
+    }
+    image(scene, v, c);
+    VERIFIER(c.requetes.empty());
+
+    // Reconnexion pendant une image stable : l'image suivante renvoie tout au nouveau pair.
+    c.reconnecter();
+    image(scene, v, c);
+    VERIFIER(c.requetes.empty());
+    image(scene, v, c);
+    VERIFIER(c.nombre("Ajout;") == 3 && c.requetes.size() == 3);
+    VERIFIER(c.affichees.size() == 3);
+
+    // L'instance quitte la scène : ses formes sont supprimées.
+    delete scene.retirer(instance);
+    image(scene, v, c);
+    VERIFIER(c.nombre("Suppression;") == 2 && c.requetes.size() == 2);
+    VERIFIER(c.affichees.size() == 1);
+    VERIFIER(c.coherent);
+
+    // Deux instances du même prototype : des pièces distinctes, chacune à sa place.
+    Groupe paire(Forme::BLACK);
+    paire.ajouter(new Instance(partage, Transformation2D::translation(Vecteur2D(0, 10)), Forme::BLUE));
+    paire.ajouter(new Instance(partage, Transformation2D::homothetie(Vecteur2D(0, 0), 2), Forme::BLUE));
+    ConnexionEnregistreuse c2;
+    VisiteurDessin v2(&c2);
+    v2.activerDifferentiel();
+    image(paire, v2, c2);
+    VERIFIER(c2.nombre("Ajout;") == 4 && c2.affichees.size() == 4 && c2.coherent);
+    const auto dessine = [&](const std::string& forme) {
+        for (const std::string& r : c2.requetes) {
+            if (r.size() >= forme.size() && r.compare(r.size() - forme.size(), forme.size(), forme) == 0) return true;
+        }
+        return false;
+    };
+    VERIFIER(dessine(";Cercle;black;5,10;1") && dessine(";Cercle;black;10,0;2"));
+
+    return Verification::resultat();
+}